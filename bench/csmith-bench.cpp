@@ -0,0 +1,709 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//
+// csmith-bench: a throughput benchmark for the generator.
+//
+// The benchmark runs a csmith executable over a fixed, versioned set of
+// (profile, seed) pairs described in a configuration file (seeds.txt).
+// For every profile it records programs/sec, output bytes/sec, the peak
+// resident set size of the generator, and the time spent in each top-level
+// generation phase (as reported by "--profile").  The results are written
+// as JSON and, if a baseline is given, compared against it: a metric that is
+// worse than the baseline by more than the tolerance is a regression, and
+// the benchmark exits with a non-zero status.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Profile {
+	string name;
+	vector<string> options;
+	vector<unsigned long> seeds;
+};
+
+struct RunResult {
+	bool ok;
+	bool timed_out;
+	unsigned long long usecs;
+	unsigned long long bytes;
+	long peak_rss_kb;
+};
+
+struct ProfileResult {
+	ProfileResult() : programs(0), failures(0), usecs(0), bytes(0), peak_rss_kb(0) {}
+	unsigned long programs;
+	unsigned long failures;
+	unsigned long long usecs;
+	unsigned long long bytes;
+	long peak_rss_kb;
+	map<string, unsigned long long> phase_usecs;
+};
+
+static string csmith_path = "../src/csmith";
+static string seeds_file = "seeds.txt";
+static string baseline_file;
+static string output_file;
+static double tolerance = 10.0;
+static int timeout_secs = 120;
+static int repeat = 1;
+static bool update_baseline = false;
+static bool collect_phases = true;
+static vector<string> only_profiles;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static unsigned long long
+get_usecs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static vector<string>
+split_words(const string &s)
+{
+	vector<string> words;
+	istringstream in(s);
+	string w;
+	while (in >> w)
+		words.push_back(w);
+	return words;
+}
+
+static string
+trim(const string &s)
+{
+	size_t b = s.find_first_not_of(" \t\r\n");
+	if (b == string::npos)
+		return "";
+	size_t e = s.find_last_not_of(" \t\r\n");
+	return s.substr(b, e - b + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The configuration file is a list of profiles:
+//
+//   version = 1
+//   [name]
+//   options = --some-csmith --options
+//   probabilities = name.prob
+//   seeds = 1 2 3
+//
+// `probabilities' names a --probability-configuration file, relative to the
+// directory of the configuration file.  Lines starting with '#' are comments.
+static bool
+read_config(const string &file, string &version, vector<Profile> &profiles)
+{
+	ifstream in(file.c_str());
+	if (!in) {
+		cerr << "csmith-bench: cannot open " << file << endl;
+		return false;
+	}
+	size_t slash = file.rfind('/');
+	string dir = (slash == string::npos) ? "" : file.substr(0, slash + 1);
+	string line;
+	int lineno = 0;
+	while (getline(in, line)) {
+		lineno++;
+		line = trim(line);
+		if (line.empty() || line[0] == '#')
+			continue;
+		if (line[0] == '[') {
+			size_t e = line.find(']');
+			if (e == string::npos) {
+				cerr << file << ":" << lineno << ": bad profile header" << endl;
+				return false;
+			}
+			Profile p;
+			p.name = trim(line.substr(1, e - 1));
+			profiles.push_back(p);
+			continue;
+		}
+		size_t eq = line.find('=');
+		if (eq == string::npos) {
+			cerr << file << ":" << lineno << ": expected `key = value'" << endl;
+			return false;
+		}
+		string key = trim(line.substr(0, eq));
+		string value = trim(line.substr(eq + 1));
+		if (key == "version") {
+			version = value;
+		}
+		else if (profiles.empty()) {
+			cerr << file << ":" << lineno << ": `" << key << "' outside of a profile" << endl;
+			return false;
+		}
+		else if (key == "options") {
+			vector<string> words = split_words(value);
+			profiles.back().options.insert(profiles.back().options.end(), words.begin(), words.end());
+		}
+		else if (key == "probabilities") {
+			if (value.empty()) {
+				cerr << file << ":" << lineno << ": `probabilities' needs a file name" << endl;
+				return false;
+			}
+			profiles.back().options.push_back("--probability-configuration");
+			profiles.back().options.push_back((value[0] == '/') ? value : dir + value);
+		}
+		else if (key == "seeds") {
+			vector<string> words = split_words(value);
+			for (size_t i = 0; i < words.size(); i++)
+				profiles.back().seeds.push_back(strtoul(words[i].c_str(), NULL, 10));
+		}
+		else {
+			cerr << file << ":" << lineno << ": unknown key `" << key << "'" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Run csmith once, counting the bytes it writes to stdout.  The child is
+// killed if it runs longer than `timeout_secs'.
+static RunResult
+run_csmith(const Profile &p, unsigned long seed, const string &profile_out)
+{
+	RunResult r;
+	r.ok = false;
+	r.timed_out = false;
+	r.usecs = 0;
+	r.bytes = 0;
+	r.peak_rss_kb = 0;
+
+	vector<string> args;
+	args.push_back(csmith_path);
+	args.push_back("--seed");
+	ostringstream ss;
+	ss << seed;
+	args.push_back(ss.str());
+	args.insert(args.end(), p.options.begin(), p.options.end());
+	if (!profile_out.empty()) {
+		args.push_back("--profile");
+		args.push_back(profile_out);
+	}
+	vector<char*> argv;
+	for (size_t i = 0; i < args.size(); i++)
+		argv.push_back(const_cast<char*>(args[i].c_str()));
+	argv.push_back(NULL);
+
+	int fds[2];
+	if (pipe(fds) != 0) {
+		perror("pipe");
+		return r;
+	}
+	unsigned long long start = get_usecs();
+	pid_t pid = fork();
+	if (pid < 0) {
+		perror("fork");
+		close(fds[0]);
+		close(fds[1]);
+		return r;
+	}
+	if (pid == 0) {
+		dup2(fds[1], STDOUT_FILENO);
+		int devnull = open("/dev/null", O_WRONLY);
+		if (devnull >= 0)
+			dup2(devnull, STDERR_FILENO);
+		close(fds[0]);
+		close(fds[1]);
+		execv(argv[0], &argv[0]);
+		_exit(127);
+	}
+	close(fds[1]);
+
+	unsigned long long deadline = start + (unsigned long long)timeout_secs * 1000000ULL;
+	char buf[65536];
+	for (;;) {
+		unsigned long long now = get_usecs();
+		if (now >= deadline) {
+			kill(pid, SIGKILL);
+			r.timed_out = true;
+			break;
+		}
+		struct pollfd pfd;
+		pfd.fd = fds[0];
+		pfd.events = POLLIN;
+		int ms = (int)((deadline - now) / 1000) + 1;
+		int n = poll(&pfd, 1, ms);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			perror("poll");
+			kill(pid, SIGKILL);
+			break;
+		}
+		if (n == 0)
+			continue;
+		ssize_t got = read(fds[0], buf, sizeof buf);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			break;
+		r.bytes += got;
+	}
+	close(fds[0]);
+
+	int status = 0;
+	struct rusage ru;
+	memset(&ru, 0, sizeof ru);
+	while (wait4(pid, &status, 0, &ru) < 0 && errno == EINTR)
+		;
+	r.usecs = get_usecs() - start;
+	r.peak_rss_kb = ru.ru_maxrss;
+	r.ok = !r.timed_out && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	return r;
+}
+
+// Sum a folded-stack profile by top-level phase: "csmith;Phase;... usecs".
+static void
+read_phases(const string &file, map<string, unsigned long long> &phases)
+{
+	ifstream in(file.c_str());
+	string line;
+	while (getline(in, line)) {
+		size_t sp = line.rfind(' ');
+		if (sp == string::npos)
+			continue;
+		string stack = line.substr(0, sp);
+		unsigned long long usecs = strtoull(line.c_str() + sp + 1, NULL, 10);
+		size_t b = stack.find(';');
+		if (b == string::npos)
+			continue;
+		size_t e = stack.find(';', b + 1);
+		string phase = stack.substr(b + 1, e == string::npos ? string::npos : e - b - 1);
+		phases[phase] += usecs;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A small JSON reader, sufficient for the files this program writes:
+// nested objects whose leaves are numbers or strings.  Leaves are stored
+// by their dotted path, e.g. "profiles.default.programs_per_sec".
+class JsonReader {
+public:
+	JsonReader(const string &text) : s_(text), pos_(0) {}
+
+	bool parse(map<string, string> &out) {
+		skip_ws();
+		return parse_value("", out);
+	}
+
+private:
+	void skip_ws(void) {
+		while (pos_ < s_.size() && isspace((unsigned char)s_[pos_]))
+			pos_++;
+	}
+
+	bool parse_string(string &out) {
+		if (pos_ >= s_.size() || s_[pos_] != '"')
+			return false;
+		pos_++;
+		while (pos_ < s_.size() && s_[pos_] != '"') {
+			if (s_[pos_] == '\\' && pos_ + 1 < s_.size())
+				pos_++;
+			out += s_[pos_++];
+		}
+		if (pos_ >= s_.size())
+			return false;
+		pos_++;
+		return true;
+	}
+
+	bool parse_value(const string &path, map<string, string> &out) {
+		skip_ws();
+		if (pos_ >= s_.size())
+			return false;
+		if (s_[pos_] == '{') {
+			pos_++;
+			skip_ws();
+			if (pos_ < s_.size() && s_[pos_] == '}') {
+				pos_++;
+				return true;
+			}
+			for (;;) {
+				skip_ws();
+				string key;
+				if (!parse_string(key))
+					return false;
+				skip_ws();
+				if (pos_ >= s_.size() || s_[pos_] != ':')
+					return false;
+				pos_++;
+				if (!parse_value(path.empty() ? key : path + "." + key, out))
+					return false;
+				skip_ws();
+				if (pos_ < s_.size() && s_[pos_] == ',') {
+					pos_++;
+					continue;
+				}
+				if (pos_ < s_.size() && s_[pos_] == '}') {
+					pos_++;
+					return true;
+				}
+				return false;
+			}
+		}
+		if (s_[pos_] == '"') {
+			string v;
+			if (!parse_string(v))
+				return false;
+			out[path] = v;
+			return true;
+		}
+		size_t b = pos_;
+		while (pos_ < s_.size() && (isalnum((unsigned char)s_[pos_]) || strchr("+-.", s_[pos_])))
+			pos_++;
+		if (b == pos_)
+			return false;
+		out[path] = s_.substr(b, pos_ - b);
+		return true;
+	}
+
+	const string s_;
+	size_t pos_;
+};
+
+static bool
+read_json(const string &file, map<string, string> &out)
+{
+	ifstream in(file.c_str());
+	if (!in)
+		return false;
+	ostringstream ss;
+	ss << in.rdbuf();
+	JsonReader reader(ss.str());
+	return reader.parse(out);
+}
+
+static string
+json_escape(const string &s)
+{
+	string out;
+	for (size_t i = 0; i < s.size(); i++) {
+		if (s[i] == '"' || s[i] == '\\')
+			out += '\\';
+		out += s[i];
+	}
+	return out;
+}
+
+static double
+rate(unsigned long long n, unsigned long long usecs)
+{
+	return usecs ? (double)n * 1000000.0 / (double)usecs : 0.0;
+}
+
+static void
+write_json(ostream &out, const string &version, const vector<Profile> &profiles,
+	   const map<string, ProfileResult> &results)
+{
+	out << "{" << endl;
+	out << "  \"seeds_version\": \"" << json_escape(version) << "\"," << endl;
+	out << "  \"repeat\": " << repeat << "," << endl;
+	out << "  \"profiles\": {" << endl;
+	for (size_t i = 0; i < profiles.size(); i++) {
+		map<string, ProfileResult>::const_iterator it = results.find(profiles[i].name);
+		if (it == results.end())
+			continue;
+		const ProfileResult &r = it->second;
+		char buf[64];
+		out << "    \"" << json_escape(profiles[i].name) << "\": {" << endl;
+		out << "      \"programs\": " << r.programs << "," << endl;
+		out << "      \"failures\": " << r.failures << "," << endl;
+		out << "      \"seconds\": " << (r.usecs / 1000000.0) << "," << endl;
+		sprintf(buf, "%.3f", rate(r.programs, r.usecs));
+		out << "      \"programs_per_sec\": " << buf << "," << endl;
+		out << "      \"bytes\": " << r.bytes << "," << endl;
+		sprintf(buf, "%.1f", rate(r.bytes, r.usecs));
+		out << "      \"bytes_per_sec\": " << buf << "," << endl;
+		out << "      \"peak_rss_kb\": " << r.peak_rss_kb << "," << endl;
+		out << "      \"phase_usecs\": {";
+		for (map<string, unsigned long long>::const_iterator p = r.phase_usecs.begin();
+		     p != r.phase_usecs.end(); ++p) {
+			out << (p == r.phase_usecs.begin() ? "" : ",") << endl;
+			out << "        \"" << json_escape(p->first) << "\": " << p->second;
+		}
+		out << endl << "      }" << endl;
+		out << "    }" << ((i + 1 < profiles.size()) ? "," : "") << endl;
+	}
+	out << "  }" << endl;
+	out << "}" << endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Compare one metric against the baseline; `higher_is_better' selects the
+// direction in which a change counts as a regression.
+static bool
+compare_metric(const map<string, string> &base, const map<string, string> &cur,
+	       const string &key, bool higher_is_better)
+{
+	map<string, string>::const_iterator b = base.find(key);
+	map<string, string>::const_iterator c = cur.find(key);
+	if (b == base.end() || c == cur.end())
+		return true;
+	double bv = atof(b->second.c_str());
+	double cv = atof(c->second.c_str());
+	if (bv == 0.0)
+		return true;
+	double change = (cv - bv) * 100.0 / bv;
+	bool regressed = higher_is_better ? (change < -tolerance) : (change > tolerance);
+	char buf[256];
+	sprintf(buf, "  %-48s %14.3f %14.3f %+8.2f%%%s", key.c_str(), bv, cv, change,
+		regressed ? "  REGRESSION" : "");
+	cout << buf << endl;
+	return !regressed;
+}
+
+static bool
+compare_with_baseline(const string &version, const vector<Profile> &profiles,
+		      const map<string, string> &base, const map<string, string> &cur)
+{
+	map<string, string>::const_iterator v = base.find("seeds_version");
+	if (v == base.end() || v->second != version) {
+		cout << "csmith-bench: baseline was recorded with a different seed set; "
+		     << "not comparing (re-record it with --update-baseline)" << endl;
+		return true;
+	}
+	bool ok = true;
+	cout << "comparison against baseline (tolerance " << tolerance << "%):" << endl;
+	for (size_t i = 0; i < profiles.size(); i++) {
+		string prefix = "profiles." + profiles[i].name + ".";
+		if (cur.find(prefix + "programs") == cur.end())
+			continue;
+		ok &= compare_metric(base, cur, prefix + "programs_per_sec", true);
+		ok &= compare_metric(base, cur, prefix + "bytes_per_sec", true);
+		ok &= compare_metric(base, cur, prefix + "peak_rss_kb", false);
+		map<string, string>::const_iterator b = base.find(prefix + "bytes");
+		map<string, string>::const_iterator c = cur.find(prefix + "bytes");
+		if (b != base.end() && c != cur.end() && b->second != c->second)
+			cout << "  note: " << profiles[i].name << " output size changed ("
+			     << b->second << " -> " << c->second << " bytes)" << endl;
+	}
+	return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void
+print_help(void)
+{
+	cout << "Usage: csmith-bench [options]" << endl << endl
+	     << "  --csmith <path>: the csmith executable to measure (default ../src/csmith)." << endl
+	     << "  --seeds <file>: profile and seed configuration (default seeds.txt)." << endl
+	     << "  --baseline <file>: compare the results against this baseline." << endl
+	     << "  --update-baseline: write the results to the baseline file instead of comparing." << endl
+	     << "  --output <file>: also write the results to <file>." << endl
+	     << "  --tolerance <percent>: allowed slowdown before a metric is a regression (default 10)." << endl
+	     << "  --timeout <secs>: kill a csmith run after <secs> seconds (default 120)." << endl
+	     << "  --repeat <n>: run every seed <n> times (default 1)." << endl
+	     << "  --profile <name>: only run the named profile (may be repeated)." << endl
+	     << "  --no-phases: do not collect per-phase times." << endl;
+}
+
+static bool
+need_arg(int i, int argc, const char *opt)
+{
+	if (i + 1 >= argc) {
+		cerr << "csmith-bench: " << opt << " needs an argument" << endl;
+		return false;
+	}
+	return true;
+}
+
+int
+main(int argc, char **argv)
+{
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--help") || !strcmp(argv[i], "-h")) {
+			print_help();
+			return 0;
+		}
+		else if (!strcmp(argv[i], "--update-baseline")) {
+			update_baseline = true;
+		}
+		else if (!strcmp(argv[i], "--no-phases")) {
+			collect_phases = false;
+		}
+		else if (!strcmp(argv[i], "--csmith") || !strcmp(argv[i], "--seeds") ||
+			 !strcmp(argv[i], "--baseline") || !strcmp(argv[i], "--output") ||
+			 !strcmp(argv[i], "--tolerance") || !strcmp(argv[i], "--timeout") ||
+			 !strcmp(argv[i], "--repeat") || !strcmp(argv[i], "--profile")) {
+			if (!need_arg(i, argc, argv[i]))
+				return 2;
+			string opt = argv[i];
+			string val = argv[++i];
+			if (opt == "--csmith")
+				csmith_path = val;
+			else if (opt == "--seeds")
+				seeds_file = val;
+			else if (opt == "--baseline")
+				baseline_file = val;
+			else if (opt == "--output")
+				output_file = val;
+			else if (opt == "--tolerance")
+				tolerance = atof(val.c_str());
+			else if (opt == "--timeout")
+				timeout_secs = atoi(val.c_str());
+			else if (opt == "--repeat")
+				repeat = atoi(val.c_str());
+			else
+				only_profiles.push_back(val);
+		}
+		else {
+			cerr << "csmith-bench: unknown option " << argv[i] << endl;
+			print_help();
+			return 2;
+		}
+	}
+	if (update_baseline && baseline_file.empty()) {
+		cerr << "csmith-bench: --update-baseline requires --baseline" << endl;
+		return 2;
+	}
+	if (repeat < 1)
+		repeat = 1;
+
+	string version;
+	vector<Profile> all_profiles;
+	if (!read_config(seeds_file, version, all_profiles))
+		return 2;
+	vector<Profile> profiles;
+	for (size_t i = 0; i < all_profiles.size(); i++) {
+		if (only_profiles.empty() ||
+		    find(only_profiles.begin(), only_profiles.end(), all_profiles[i].name) != only_profiles.end())
+			profiles.push_back(all_profiles[i]);
+	}
+
+	char tmpl[] = "/tmp/csmith-bench-XXXXXX";
+	int tmpfd = mkstemp(tmpl);
+	if (tmpfd < 0) {
+		perror("mkstemp");
+		return 2;
+	}
+	close(tmpfd);
+	string profile_out = tmpl;
+
+	map<string, ProfileResult> results;
+	bool failed = false;
+	for (size_t i = 0; i < profiles.size(); i++) {
+		const Profile &p = profiles[i];
+		ProfileResult &res = results[p.name];
+		cout << "profile " << p.name << ":" << flush;
+		for (size_t s = 0; s < p.seeds.size(); s++) {
+			for (int k = 0; k < repeat; k++) {
+				RunResult r = run_csmith(p, p.seeds[s], "");
+				if (!r.ok) {
+					cout << " " << p.seeds[s] << (r.timed_out ? "(timeout)" : "(failed)") << flush;
+					res.failures++;
+					failed = true;
+					break;
+				}
+				res.programs++;
+				res.usecs += r.usecs;
+				res.bytes += r.bytes;
+				if (r.peak_rss_kb > res.peak_rss_kb)
+					res.peak_rss_kb = r.peak_rss_kb;
+			}
+			// phases are collected in a separate run, so that the
+			// profiler's own overhead does not distort the throughput
+			if (collect_phases) {
+				RunResult r = run_csmith(p, p.seeds[s], profile_out);
+				if (r.ok)
+					read_phases(profile_out, res.phase_usecs);
+			}
+			cout << "." << flush;
+		}
+		char buf[128];
+		sprintf(buf, " %.2f programs/sec, %.0f bytes/sec, peak RSS %ld KB",
+			rate(res.programs, res.usecs), rate(res.bytes, res.usecs), res.peak_rss_kb);
+		cout << buf << endl;
+	}
+	unlink(profile_out.c_str());
+
+	ostringstream json;
+	write_json(json, version, profiles, results);
+	if (!output_file.empty()) {
+		ofstream out(output_file.c_str());
+		out << json.str();
+	}
+
+	if (update_baseline) {
+		ofstream out(baseline_file.c_str());
+		out << json.str();
+		cout << "baseline written to " << baseline_file << endl;
+	}
+	else if (!baseline_file.empty()) {
+		map<string, string> base, cur;
+		if (!read_json(baseline_file, base)) {
+			cout << "csmith-bench: no baseline at " << baseline_file
+			     << "; skipping comparison" << endl;
+		}
+		else {
+			JsonReader reader(json.str());
+			reader.parse(cur);
+			if (!compare_with_baseline(version, profiles, base, cur))
+				failed = true;
+		}
+	}
+	else if (output_file.empty()) {
+		cout << json.str();
+	}
+	return failed ? 1 : 0;
+}
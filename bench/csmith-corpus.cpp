@@ -0,0 +1,524 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//
+// csmith-corpus: output-determinism and timing comparison across builds.
+//
+// "run" generates every (seed, options) pair of a corpus with a given csmith
+// executable, in parallel, and records a hash of each program together with
+// its generation time.  "diff" compares two such result files: any pair whose
+// program changed is reported (and makes the tool exit non-zero), followed by
+// the distribution of per-seed speedups of the second build over the first.
+//
+// The corpus file has one entry per line:
+//
+//   <seed>[:<last-seed>] [csmith options...]
+//
+// Lines starting with '#' are comments.  The program header lines that
+// identify the generator build ("Generator:" and "Git version:") are not
+// hashed, so two builds of the same generator produce the same hashes.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct Job {
+	unsigned long seed;
+	string options;
+};
+
+struct Result {
+	Result() : hash(0), usecs(0) {}
+	unsigned long long hash;
+	unsigned long long usecs;
+	string status;
+};
+
+static unsigned long long
+get_usecs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static string
+trim(const string &s)
+{
+	size_t b = s.find_first_not_of(" \t\r\n");
+	if (b == string::npos)
+		return "";
+	size_t e = s.find_last_not_of(" \t\r\n");
+	return s.substr(b, e - b + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool
+read_corpus(const string &file, vector<Job> &jobs)
+{
+	ifstream in(file.c_str());
+	if (!in) {
+		cerr << "csmith-corpus: cannot open " << file << endl;
+		return false;
+	}
+	string line;
+	int lineno = 0;
+	while (getline(in, line)) {
+		lineno++;
+		line = trim(line);
+		if (line.empty() || line[0] == '#')
+			continue;
+		size_t sp = line.find_first_of(" \t");
+		string range = line.substr(0, sp);
+		string options = sp == string::npos ? "" : trim(line.substr(sp));
+		char *end;
+		unsigned long first = strtoul(range.c_str(), &end, 10);
+		unsigned long last = first;
+		if (*end == ':')
+			last = strtoul(end + 1, &end, 10);
+		if (*end != '\0' || last < first) {
+			cerr << file << ":" << lineno << ": bad seed range `" << range << "'" << endl;
+			return false;
+		}
+		for (unsigned long s = first; s <= last; s++) {
+			Job j;
+			j.seed = s;
+			j.options = options;
+			jobs.push_back(j);
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// 64-bit FNV-1a over the program text, skipping header lines that name the
+// generator build.
+class ProgramHasher
+{
+public:
+	ProgramHasher() : hash_(14695981039346656037ULL) {}
+
+	void feed(const char *buf, size_t len) {
+		for (size_t i = 0; i < len; i++) {
+			line_ += buf[i];
+			if (buf[i] == '\n')
+				flush_line();
+		}
+	}
+
+	unsigned long long finish(void) {
+		flush_line();
+		return hash_;
+	}
+
+private:
+	void flush_line(void) {
+		if (line_.compare(0, 14, " * Generator: ") != 0 &&
+		    line_.compare(0, 16, " * Git version: ") != 0) {
+			for (size_t i = 0; i < line_.size(); i++) {
+				hash_ ^= (unsigned char)line_[i];
+				hash_ *= 1099511628211ULL;
+			}
+		}
+		line_.clear();
+	}
+
+	unsigned long long hash_;
+	string line_;
+};
+
+struct Running {
+	pid_t pid;
+	int fd;
+	size_t job;
+	unsigned long long start;
+	bool killed;
+	ProgramHasher hasher;
+};
+
+static pid_t
+spawn(const string &csmith, const Job &job, int &fd)
+{
+	vector<string> args;
+	args.push_back(csmith);
+	args.push_back("--seed");
+	ostringstream ss;
+	ss << job.seed;
+	args.push_back(ss.str());
+	istringstream opts(job.options);
+	string w;
+	while (opts >> w)
+		args.push_back(w);
+	vector<char*> argv;
+	for (size_t i = 0; i < args.size(); i++)
+		argv.push_back(const_cast<char*>(args[i].c_str()));
+	argv.push_back(NULL);
+
+	int fds[2];
+	if (pipe(fds) != 0) {
+		perror("pipe");
+		return -1;
+	}
+	pid_t pid = fork();
+	if (pid < 0) {
+		perror("fork");
+		close(fds[0]);
+		close(fds[1]);
+		return -1;
+	}
+	if (pid == 0) {
+		dup2(fds[1], STDOUT_FILENO);
+		int devnull = open("/dev/null", O_WRONLY);
+		if (devnull >= 0)
+			dup2(devnull, STDERR_FILENO);
+		close(fds[0]);
+		close(fds[1]);
+		execv(argv[0], &argv[0]);
+		_exit(127);
+	}
+	close(fds[1]);
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+	fd = fds[0];
+	return pid;
+}
+
+static string
+exit_status(int status, bool killed)
+{
+	if (killed)
+		return "timeout";
+	ostringstream ss;
+	if (WIFSIGNALED(status))
+		ss << "signal" << WTERMSIG(status);
+	else if (WEXITSTATUS(status) != 0)
+		ss << "exit" << WEXITSTATUS(status);
+	else
+		ss << "ok";
+	return ss.str();
+}
+
+// Run all jobs, at most `jobs_n' at a time.
+static void
+run_corpus(const string &csmith, const vector<Job> &jobs, int jobs_n, int timeout_secs,
+	   vector<Result> &results)
+{
+	results.resize(jobs.size());
+	vector<Running*> running;
+	size_t next = 0, done = 0;
+	char buf[65536];
+	unsigned long long timeout = (unsigned long long)timeout_secs * 1000000ULL;
+
+	while (done < jobs.size()) {
+		// csmith creates platform.info in its working directory on first
+		// use; let the first generator finish before running in parallel
+		int limit = done ? jobs_n : 1;
+		while (next < jobs.size() && (int)running.size() < limit) {
+			Running *r = new Running;
+			r->job = next++;
+			r->killed = false;
+			r->start = get_usecs();
+			r->pid = spawn(csmith, jobs[r->job], r->fd);
+			if (r->pid < 0) {
+				results[r->job].status = "spawn-failed";
+				done++;
+				delete r;
+				continue;
+			}
+			running.push_back(r);
+		}
+
+		vector<struct pollfd> pfds(running.size());
+		for (size_t i = 0; i < running.size(); i++) {
+			pfds[i].fd = running[i]->fd;
+			pfds[i].events = POLLIN;
+			pfds[i].revents = 0;
+		}
+		int n = poll(&pfds[0], pfds.size(), 1000);
+		if (n < 0 && errno != EINTR) {
+			perror("poll");
+			exit(2);
+		}
+
+		unsigned long long now = get_usecs();
+		for (size_t i = 0; i < running.size(); ) {
+			Running *r = running[i];
+			bool finished = false;
+			if (pfds[i].revents) {
+				ssize_t got = read(r->fd, buf, sizeof buf);
+				if (got > 0)
+					r->hasher.feed(buf, got);
+				else if (got == 0 || errno != EINTR)
+					finished = true;
+			}
+			if (!finished && timeout && now - r->start > timeout && !r->killed) {
+				kill(r->pid, SIGKILL);
+				r->killed = true;
+			}
+			if (!finished) {
+				i++;
+				continue;
+			}
+			int status = 0;
+			while (waitpid(r->pid, &status, 0) < 0 && errno == EINTR)
+				;
+			close(r->fd);
+			Result &res = results[r->job];
+			res.usecs = get_usecs() - r->start;
+			res.hash = r->hasher.finish();
+			res.status = exit_status(status, r->killed);
+			delete r;
+			running.erase(running.begin() + i);
+			pfds.erase(pfds.begin() + i);
+			done++;
+			if (done % 1000 == 0)
+				cerr << "csmith-corpus: " << done << "/" << jobs.size() << " done" << endl;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Result files are tab separated: seed, options, hash, usecs, status.
+static void
+write_results(ostream &out, const vector<Job> &jobs, const vector<Result> &results)
+{
+	for (size_t i = 0; i < jobs.size(); i++) {
+		char hash[32];
+		sprintf(hash, "%016llx", results[i].hash);
+		out << jobs[i].seed << "\t" << jobs[i].options << "\t" << hash << "\t"
+		    << results[i].usecs << "\t" << results[i].status << "\n";
+	}
+}
+
+static bool
+read_results(const string &file, map<string, Result> &results, vector<string> &order)
+{
+	ifstream in(file.c_str());
+	if (!in) {
+		cerr << "csmith-corpus: cannot open " << file << endl;
+		return false;
+	}
+	string line;
+	while (getline(in, line)) {
+		vector<string> f;
+		size_t b = 0, e;
+		while ((e = line.find('\t', b)) != string::npos) {
+			f.push_back(line.substr(b, e - b));
+			b = e + 1;
+		}
+		f.push_back(line.substr(b));
+		if (f.size() != 5)
+			continue;
+		string key = f[0] + "\t" + f[1];
+		Result &r = results[key];
+		r.hash = strtoull(f[2].c_str(), NULL, 16);
+		r.usecs = strtoull(f[3].c_str(), NULL, 10);
+		r.status = f[4];
+		order.push_back(key);
+	}
+	return true;
+}
+
+static double
+percentile(const vector<double> &sorted, double p)
+{
+	if (sorted.empty())
+		return 0.0;
+	size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+	return sorted[i];
+}
+
+static int
+diff_results(const string &old_file, const string &new_file, size_t max_report)
+{
+	map<string, Result> old_results, new_results;
+	vector<string> old_order, new_order;
+	if (!read_results(old_file, old_results, old_order) ||
+	    !read_results(new_file, new_results, new_order))
+		return 2;
+
+	size_t changed = 0, status_changed = 0, missing = 0, compared = 0;
+	vector<double> speedups;
+	unsigned long long old_total = 0, new_total = 0;
+	for (size_t i = 0; i < old_order.size(); i++) {
+		const string &key = old_order[i];
+		const Result &o = old_results[key];
+		map<string, Result>::const_iterator it = new_results.find(key);
+		if (it == new_results.end()) {
+			missing++;
+			continue;
+		}
+		const Result &n = it->second;
+		compared++;
+		string where = key;
+		replace(where.begin(), where.end(), '\t', ' ');
+		if (o.status != n.status) {
+			if (++status_changed <= max_report)
+				cout << "status changed: --seed " << where << " ("
+				     << o.status << " -> " << n.status << ")" << endl;
+			continue;
+		}
+		if (o.status != "ok")
+			continue;
+		if (o.hash != n.hash) {
+			if (++changed <= max_report)
+				cout << "output changed: --seed " << where << endl;
+		}
+		old_total += o.usecs;
+		new_total += n.usecs;
+		if (o.usecs && n.usecs)
+			speedups.push_back((double)o.usecs / (double)n.usecs);
+	}
+
+	cout << compared << " programs compared, " << changed << " changed, "
+	     << status_changed << " with a different exit status";
+	if (missing)
+		cout << ", " << missing << " missing from " << new_file;
+	cout << endl;
+
+	if (!speedups.empty()) {
+		double log_sum = 0;
+		for (size_t i = 0; i < speedups.size(); i++)
+			log_sum += log(speedups[i]);
+		sort(speedups.begin(), speedups.end());
+		printf("speedup (old time / new time) over %lu programs:\n", (unsigned long)speedups.size());
+		printf("  min %.3f  p5 %.3f  p25 %.3f  median %.3f  p75 %.3f  p95 %.3f  max %.3f\n",
+		       speedups.front(), percentile(speedups, 0.05), percentile(speedups, 0.25),
+		       percentile(speedups, 0.5), percentile(speedups, 0.75),
+		       percentile(speedups, 0.95), speedups.back());
+		printf("  geometric mean %.3f, total %.3f (%.1fs -> %.1fs)\n",
+		       exp(log_sum / speedups.size()),
+		       new_total ? (double)old_total / new_total : 0.0,
+		       old_total / 1e6, new_total / 1e6);
+	}
+	return (changed || status_changed || missing) ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void
+print_help(void)
+{
+	cout << "Usage: csmith-corpus run [options] <corpus-file>" << endl
+	     << "       csmith-corpus diff [--max-report <n>] <old-results> <new-results>" << endl
+	     << endl
+	     << "run options:" << endl
+	     << "  --csmith <path>: the csmith executable (default ../src/csmith)." << endl
+	     << "  --jobs <n>: number of generators to run at once (default: number of CPUs)." << endl
+	     << "  --timeout <secs>: kill a generator after <secs> seconds, 0 for none (default 300)." << endl
+	     << "  --output <file>: write the results to <file> instead of stdout." << endl;
+}
+
+int
+main(int argc, char **argv)
+{
+	if (argc < 2) {
+		print_help();
+		return 2;
+	}
+	string mode = argv[1];
+	string csmith = "../src/csmith";
+	string output;
+	long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	int jobs_n = ncpu > 0 ? (int)ncpu : 1;
+	int timeout_secs = 300;
+	size_t max_report = 100;
+	vector<string> files;
+
+	for (int i = 2; i < argc; i++) {
+		string opt = argv[i];
+		bool has_arg = i + 1 < argc;
+		if (opt == "--csmith" && has_arg)
+			csmith = argv[++i];
+		else if (opt == "--jobs" && has_arg)
+			jobs_n = atoi(argv[++i]);
+		else if (opt == "--timeout" && has_arg)
+			timeout_secs = atoi(argv[++i]);
+		else if (opt == "--output" && has_arg)
+			output = argv[++i];
+		else if (opt == "--max-report" && has_arg)
+			max_report = strtoul(argv[++i], NULL, 10);
+		else if (opt.compare(0, 2, "--") == 0) {
+			cerr << "csmith-corpus: unknown option " << opt << endl;
+			return 2;
+		}
+		else
+			files.push_back(opt);
+	}
+	if (jobs_n < 1)
+		jobs_n = 1;
+
+	if (mode == "run" && files.size() == 1) {
+		vector<Job> jobs;
+		if (!read_corpus(files[0], jobs))
+			return 2;
+		vector<Result> results;
+		unsigned long long start = get_usecs();
+		run_corpus(csmith, jobs, jobs_n, timeout_secs, results);
+		cerr << "csmith-corpus: " << jobs.size() << " programs in "
+		     << (get_usecs() - start) / 1e6 << "s with " << jobs_n << " jobs" << endl;
+		if (output.empty()) {
+			write_results(cout, jobs, results);
+		}
+		else {
+			ofstream out(output.c_str());
+			write_results(out, jobs, results);
+		}
+		return 0;
+	}
+	if (mode == "diff" && files.size() == 2)
+		return diff_results(files[0], files[1], max_report);
+
+	print_help();
+	return 2;
+}
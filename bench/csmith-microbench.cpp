@@ -0,0 +1,419 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//
+// csmith-microbench: microbenchmarks for the analysis and selection kernels.
+//
+// Each benchmark builds a synthetic environment of a given size (global
+// ints, pointers to them, and a points-to fact for every pointer) on top
+// of a small generated program, then times one primitive in isolation.
+// The harness follows the Google Benchmark conventions: a benchmark is a
+// function taking a BenchState, it loops `while (state.KeepRunning())',
+// and the iteration count grows until the measured time is long enough.
+//
+// Usage: csmith-microbench [--filter <substring>] [--min-time <secs>]
+//                          [--max-size <n>] [--seed <n>]
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <sstream>
+#include <iostream>
+#include <time.h>
+
+#include "CGOptions.h"
+#include "CGContext.h"
+#include "Effect.h"
+#include "Fact.h"
+#include "FactMgr.h"
+#include "FactPointTo.h"
+#include "Function.h"
+#include "ExpressionVariable.h"
+#include "ProgramGenerator.h"
+#include "Type.h"
+#include "TypeQualifiers.h"
+#include "Variable.h"
+#include "VariableSelector.h"
+#include "Constant.h"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static unsigned long long
+get_nsecs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+class BenchState
+{
+public:
+	BenchState(long range, unsigned long iterations)
+		: range_(range), max_iterations_(iterations), iterations_(0),
+		  started_(false), start_(0), elapsed_(0) {}
+
+	bool KeepRunning(void) {
+		if (!started_) {
+			started_ = true;
+			start_ = get_nsecs();
+		}
+		if (iterations_ < max_iterations_) {
+			iterations_++;
+			return true;
+		}
+		elapsed_ += get_nsecs() - start_;
+		return false;
+	}
+
+	void PauseTiming(void)		{ elapsed_ += get_nsecs() - start_; }
+	void ResumeTiming(void)		{ start_ = get_nsecs(); }
+
+	long range(void) const		{ return range_; }
+	unsigned long iterations(void) const { return iterations_; }
+	unsigned long long elapsed_ns(void) const { return elapsed_; }
+
+private:
+	long range_;
+	unsigned long max_iterations_;
+	unsigned long iterations_;
+	bool started_;
+	unsigned long long start_;
+	unsigned long long elapsed_;
+};
+
+typedef void (*BenchFunc)(BenchState &);
+
+struct Benchmark {
+	const char *name;
+	BenchFunc func;
+};
+
+// keep results alive so that the compiler cannot discard the work
+static volatile unsigned long sink;
+
+#define DO_NOT_OPTIMIZE(x) (sink += (unsigned long)(x))
+
+static double min_time = 0.2;
+static long min_size = 8;
+static long max_size = 4096;
+static long size_multiplier = 8;
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A synthetic environment: `n' global ints, `n' pointers to them, and one
+// points-to fact per pointer, p[i] -> { v[i] }.
+class Env
+{
+public:
+	explicit Env(long n);
+
+	vector<Variable*> ints;
+	vector<Variable*> ptrs;
+	vector<Variable*> all;
+	vector<const Variable*> const_ptrs;
+	FactVec facts;
+	// same as `facts', except that every 8th pointer points to a second int
+	FactVec changed_facts;
+	Effect reads;
+	Effect writes;
+	vector<const Type*> types;
+
+	static Env &get(long n);
+	static Function *func;
+
+private:
+	static map<long, Env*> envs_;
+};
+
+Function *Env::func = NULL;
+map<long, Env*> Env::envs_;
+
+static Variable *
+make_global(const string &name, const Type *t)
+{
+	TypeQualifiers qfer = TypeQualifiers::random_qualifiers(t, 0, 0);
+	return VariableSelector::new_variable(name, t, Constant::make_random(t), &qfer);
+}
+
+Env::Env(long n)
+{
+	const Type &int_type = Type::get_simple_type(eInt);
+	const Type *ptr_type = Type::find_pointer_type(&int_type, true);
+	for (long i = 0; i < n; i++) {
+		ostringstream ss;
+		ss << "bench_" << n << "_" << i;
+		ints.push_back(make_global("i" + ss.str(), &int_type));
+		ptrs.push_back(make_global("p" + ss.str(), ptr_type));
+	}
+	all.insert(all.end(), ints.begin(), ints.end());
+	all.insert(all.end(), ptrs.begin(), ptrs.end());
+	for (long i = 0; i < n; i++) {
+		const_ptrs.push_back(ptrs[i]);
+		facts.push_back(FactPointTo::make_fact(ptrs[i], ints[i]));
+		if (i % 8 == 7) {
+			vector<const Variable*> set;
+			set.push_back(ints[i]);
+			set.push_back(ints[(i + 1) % n]);
+			changed_facts.push_back(FactPointTo::make_fact(ptrs[i], set));
+		}
+		else {
+			changed_facts.push_back(FactPointTo::make_fact(ptrs[i], ints[i]));
+		}
+		// disjoint read and write sets: the worst case for race checks
+		reads.read_var(ints[i]);
+		writes.write_var(ptrs[i]);
+	}
+	const vector<Type*> &all_types = Type::GetAllTypes();
+	for (long i = 0; i < n; i++) {
+		const Type *t = all_types[i % all_types.size()];
+		types.push_back((i / all_types.size()) % 2 ? Type::find_pointer_type(t, true) : t);
+	}
+}
+
+Env &
+Env::get(long n)
+{
+	map<long, Env*>::iterator i = envs_.find(n);
+	if (i != envs_.end())
+		return *i->second;
+	Env *env = new Env(n);
+	envs_[n] = env;
+	return *env;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void
+BM_merge_facts(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	size_t pool = Fact::pool_size();
+	while (state.KeepRunning()) {
+		state.PauseTiming();
+		FactVec facts = env.facts;
+		state.ResumeTiming();
+		DO_NOT_OPTIMIZE(merge_facts(facts, env.changed_facts));
+		state.PauseTiming();
+		// the facts merge_facts joins into are new ones owned by the fact
+		// pool; only `facts' refers to them, so give them back
+		Fact::trim_pool(pool);
+		state.ResumeTiming();
+	}
+}
+
+static void
+BM_same_facts(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	FactVec reversed(env.facts.rbegin(), env.facts.rend());
+	while (state.KeepRunning()) {
+		DO_NOT_OPTIMIZE(same_facts(env.facts, reversed));
+	}
+}
+
+static void
+BM_renew_facts(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	while (state.KeepRunning()) {
+		state.PauseTiming();
+		FactVec facts = env.facts;
+		state.ResumeTiming();
+		DO_NOT_OPTIMIZE(renew_facts(facts, env.changed_facts));
+	}
+}
+
+static void
+BM_rhs_to_lhs_transfer(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	vector<const Variable*> lvars;
+	lvars.push_back(env.ptrs[0]);
+	// "p0 = pN": the last pointer's fact is found by a linear search
+	ExpressionVariable rhs(*env.ptrs.back());
+	FactPointTo *fact = FactPointTo::make_fact(env.ptrs[0]);
+	while (state.KeepRunning()) {
+		DO_NOT_OPTIMIZE(fact->rhs_to_lhs_transfer(env.facts, lvars, &rhs).size());
+	}
+}
+
+static void
+BM_merge_pointees_of_pointers(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	while (state.KeepRunning()) {
+		DO_NOT_OPTIMIZE(FactPointTo::merge_pointees_of_pointers(env.const_ptrs, env.facts).size());
+	}
+}
+
+static void
+BM_has_race_with(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	while (state.KeepRunning()) {
+		DO_NOT_OPTIMIZE(env.reads.has_race_with(env.writes));
+	}
+}
+
+static void
+BM_in_conflict(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	Effect eff;
+	for (size_t i = 0; i < env.ptrs.size(); i++)
+		eff.read_var(env.ptrs[i]);
+	for (size_t i = 0; i < env.ptrs.size(); i += 2)
+		eff.write_var(env.ptrs[i]);
+	CGContext cg_context(Env::func, env.reads, NULL);
+	while (state.KeepRunning()) {
+		DO_NOT_OPTIMIZE(cg_context.in_conflict(eff));
+	}
+}
+
+static void
+BM_choose_var(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	Effect eff;
+	CGContext cg_context(Env::func, eff, NULL);
+	const Type &int_type = Type::get_simple_type(eInt);
+	vector<const Variable*> invalid_vars;
+	while (state.KeepRunning()) {
+		DO_NOT_OPTIMIZE(VariableSelector::choose_var(env.all, Effect::READ, cg_context,
+				&int_type, NULL, eFlexible, invalid_vars));
+	}
+}
+
+static void
+BM_type_match(BenchState &state)
+{
+	Env &env = Env::get(state.range());
+	const Type &int_type = Type::get_simple_type(eInt);
+	const Type *ptr_type = Type::find_pointer_type(&int_type, true);
+	while (state.KeepRunning()) {
+		unsigned long n = 0;
+		for (size_t i = 0; i < env.types.size(); i++) {
+			n += int_type.match(env.types[i], eFlexible);
+			n += ptr_type->match(env.types[i], eDereference);
+		}
+		DO_NOT_OPTIMIZE(n);
+	}
+}
+
+static const Benchmark benchmarks[] = {
+	{ "merge_facts", BM_merge_facts },
+	{ "same_facts", BM_same_facts },
+	{ "renew_facts", BM_renew_facts },
+	{ "FactPointTo::rhs_to_lhs_transfer", BM_rhs_to_lhs_transfer },
+	{ "FactPointTo::merge_pointees_of_pointers", BM_merge_pointees_of_pointers },
+	{ "Effect::has_race_with", BM_has_race_with },
+	{ "CGContext::in_conflict", BM_in_conflict },
+	{ "VariableSelector::choose_var", BM_choose_var },
+	{ "Type::match", BM_type_match },
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Run one benchmark at one size, growing the iteration count until the
+// run takes at least `min_time' seconds.
+static void
+run_benchmark(const Benchmark &b, long size)
+{
+	unsigned long iterations = 1;
+	for (;;) {
+		BenchState state(size, iterations);
+		b.func(state);
+		double secs = state.elapsed_ns() / 1e9;
+		if (secs >= min_time || iterations >= 1000000000UL) {
+			ostringstream name;
+			name << b.name << "/" << size;
+			printf("%-48s %14.1f ns %12lu\n", name.str().c_str(),
+			       (double)state.elapsed_ns() / iterations, iterations);
+			fflush(stdout);
+			return;
+		}
+		// aim a little past min_time, as Google Benchmark does
+		double factor = secs > 0 ? (min_time * 1.4) / secs : 10.0;
+		if (factor > 10.0)
+			factor = 10.0;
+		if (factor < 2.0)
+			factor = 2.0;
+		iterations = (unsigned long)(iterations * factor);
+	}
+}
+
+int
+main(int argc, char **argv)
+{
+	string filter;
+	unsigned long seed = 1;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+			filter = argv[++i];
+		else if (!strcmp(argv[i], "--min-time") && i + 1 < argc)
+			min_time = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--max-size") && i + 1 < argc)
+			max_size = atol(argv[++i]);
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+			seed = strtoul(argv[++i], NULL, 10);
+		else {
+			cerr << "usage: " << argv[0]
+			     << " [--filter <substring>] [--min-time <secs>] [--max-size <n>] [--seed <n>]"
+			     << endl;
+			return 2;
+		}
+	}
+
+	// Generate a small program so that the types, the first function and
+	// its fact manager exist; the synthetic environments hang off it.
+	CGOptions::set_default_settings();
+	CGOptions::max_funcs(1);
+	ProgramGenerator *generator = ProgramGenerator::CreateInstance(argc, argv, seed);
+	generator->Init();
+	GenerateAllTypes();
+	GenerateFunctions();
+	Env::func = GetFirstFunction();
+
+	printf("%-48s %17s %12s\n", "Benchmark", "Time", "Iterations");
+	for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+		const Benchmark &b = benchmarks[i];
+		if (!filter.empty() && string(b.name).find(filter) == string::npos)
+			continue;
+		for (long size = min_size; size <= max_size; size *= size_multiplier)
+			run_benchmark(b, size);
+	}
+	return 0;
+}
@@ -42,10 +42,55 @@
 #define __STDC_LIMIT_MACROS
 #include "random_inc.h"
 
-static uint32_t crc32_tab[256];
-static uint32_t crc32_context = 0xFFFFFFFFUL;
+/*
+ * The checksum over the globals.  By default it is a CRC-32 computed one
+ * byte at a time.  A program generated with "--checksum-algo crc32-slice8"
+ * defines CSMITH_CRC_SLICE8 and computes the same CRC eight bytes at a time
+ * (four without long long) from eight lookup tables.  A program generated
+ * with "--checksum-algo word" defines CSMITH_WORD_HASH and mixes each value
+ * into the context with a multiply/xor-shift hash instead; that is faster
+ * still, but its checksums cannot be compared with the CRC ones.
+ */
+
+#ifdef CSMITH_CRC_SLICE8
+STATIC uint32_t crc32_tab[8][256];
+#else
+STATIC uint32_t crc32_tab[256];
+#endif
+STATIC uint32_t crc32_context = 0xFFFFFFFFUL;
 
-static void 
+#ifdef CSMITH_WORD_HASH
+
+STATIC void 
+crc32_gentab (void)
+{
+}
+
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+STATIC void 
+crc32_8bytes (uint32_t val)
+{
+	uint32_t x = (val ^ crc32_context) * 0x9E3779B1UL;
+	x ^= x >> 15;
+	x *= 0x85EBCA77UL;
+	x ^= x >> 13;
+	crc32_context = x;
+}
+#else
+STATIC void 
+crc32_8bytes (uint64_t val)
+{
+	uint64_t x = (val ^ crc32_context) * 0x9E3779B97F4A7C15ULL;
+	x ^= x >> 32;
+	x *= 0xBF58476D1CE4E5B9ULL;
+	x ^= x >> 29;
+	crc32_context = (uint32_t)x ^ (uint32_t)(x >> 32);
+}
+#endif
+
+#else /* CRC-32 */
+
+STATIC void 
 crc32_gentab (void)
 {
 	uint32_t crc;
@@ -61,11 +106,57 @@ crc32_gentab (void)
 				crc >>= 1;
 			}
 		}
+#ifdef CSMITH_CRC_SLICE8
+		crc32_tab[0][i] = crc;
+#else
 		crc32_tab[i] = crc;
+#endif
+	}
+#ifdef CSMITH_CRC_SLICE8
+	/* crc32_tab[k][i]: the CRC of byte i followed by k zero bytes */
+	for (i = 0; i < 256; i++) {
+		for (j = 1; j < 8; j++) {
+			crc = crc32_tab[j - 1][i];
+			crc32_tab[j][i] = (crc >> 8) ^ crc32_tab[0][crc & 0xFF];
+		}
 	}
+#endif
 }
 
-static void 
+#ifdef CSMITH_CRC_SLICE8
+
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+STATIC void 
+crc32_8bytes (uint32_t val)
+{
+	uint32_t one = val ^ crc32_context;
+	crc32_context =
+		crc32_tab[3][one & 0xFF] ^
+		crc32_tab[2][(one >> 8) & 0xFF] ^
+		crc32_tab[1][(one >> 16) & 0xFF] ^
+		crc32_tab[0][one >> 24];
+}
+#else
+STATIC void 
+crc32_8bytes (uint64_t val)
+{
+	uint32_t one = (uint32_t)val ^ crc32_context;
+	uint32_t two = (uint32_t)(val >> 32);
+	crc32_context =
+		crc32_tab[7][one & 0xFF] ^
+		crc32_tab[6][(one >> 8) & 0xFF] ^
+		crc32_tab[5][(one >> 16) & 0xFF] ^
+		crc32_tab[4][one >> 24] ^
+		crc32_tab[3][two & 0xFF] ^
+		crc32_tab[2][(two >> 8) & 0xFF] ^
+		crc32_tab[1][(two >> 16) & 0xFF] ^
+		crc32_tab[0][two >> 24];
+}
+#endif
+
+#else /* one byte at a time */
+
+STATIC void 
 crc32_byte (uint8_t b) {
 	crc32_context = 
 		((crc32_context >> 8) & 0x00FFFFFF) ^ 
@@ -73,7 +164,7 @@ crc32_byte (uint8_t b) {
 }
 
 #if defined(__SPLAT__) || defined(NO_LONGLONG)
-static void 
+STATIC void 
 crc32_8bytes (uint32_t val)
 {
 	crc32_byte ((val>>0) & 0xff);
@@ -81,17 +172,8 @@ crc32_8bytes (uint32_t val)
 	crc32_byte ((val>>16) & 0xff);
 	crc32_byte ((val>>24) & 0xff);
 }
-
-static void 
-transparent_crc (uint32_t val, char* vname, int flag)
-{
-	crc32_8bytes(val);
-	if (flag) {
-  		printf("...checksum after hashing %s : %X\n", vname, crc32_context ^ 0xFFFFFFFFU);
-	}
-}
 #else
-static void 
+STATIC void 
 crc32_8bytes (uint64_t val)
 {
 	crc32_byte ((val>>0) & 0xff);
@@ -103,8 +185,23 @@ crc32_8bytes (uint64_t val)
 	crc32_byte ((val>>48) & 0xff);
 	crc32_byte ((val>>56) & 0xff);
 }
+#endif
+
+#endif /* CSMITH_CRC_SLICE8 */
 
-static void 
+#endif /* CSMITH_WORD_HASH */
+
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+STATIC void 
+transparent_crc (uint32_t val, char* vname, int flag)
+{
+	crc32_8bytes(val);
+	if (flag) {
+  		printf("...checksum after hashing %s : %X\n", vname, crc32_context ^ 0xFFFFFFFFU);
+	}
+}
+#else
+STATIC void 
 transparent_crc (uint64_t val, char* vname, int flag)
 {
 	crc32_8bytes(val);
@@ -114,6 +211,35 @@ transparent_crc (uint64_t val, char* vname, int flag)
 }
 #endif
 
+/*
+ * Hash the n members of an array of integers in order, as n calls to
+ * transparent_crc would ("--bulk-array-hash").
+ */
+#define TRANSPARENT_CRC_ARRAY(type) \
+STATIC void \
+transparent_crc_array_##type (const type *p, size_t n, char* vname, int flag) \
+{ \
+	size_t i; \
+	if (flag) { \
+		for (i = 0; i < n; i++) \
+			transparent_crc(p[i], vname, flag); \
+		return; \
+	} \
+	for (i = 0; i < n; i++) \
+		crc32_8bytes(p[i]); \
+}
+
+TRANSPARENT_CRC_ARRAY(int8_t)
+TRANSPARENT_CRC_ARRAY(uint8_t)
+TRANSPARENT_CRC_ARRAY(int16_t)
+TRANSPARENT_CRC_ARRAY(uint16_t)
+TRANSPARENT_CRC_ARRAY(int32_t)
+TRANSPARENT_CRC_ARRAY(uint32_t)
+#if !defined(__SPLAT__) && !defined(NO_LONGLONG)
+TRANSPARENT_CRC_ARRAY(int64_t)
+TRANSPARENT_CRC_ARRAY(uint64_t)
+#endif
+
 /*****************************************************************************/
 
 #endif
@@ -64,6 +64,15 @@ static inline void crc32_gentab (void)
 
 #define _CSMITH_BITFIELD(x) ((x>32)?(x%32):x)
 
+#ifdef CSMITH_PROFILE_COUNTERS
+extern uint32_t __csmith_prof[];
+extern const unsigned int __csmith_prof_n;
+#endif
+
+#ifdef CSMITH_CHECKSUM_TRACE
+#include "csmith_trace.h"
+#endif
+
 int crc32_context;
 
 #ifdef TCC
@@ -87,6 +96,26 @@ transparent_crc (uint32_t val, char* vname, int flag)
   crc32_context += val;
 }
 
+#define TRANSPARENT_CRC_ARRAY(type) \
+static inline void \
+transparent_crc_array_##type (const type *p, unsigned int n, char* vname, int flag) \
+{ \
+  unsigned int i; \
+  for (i = 0; i < n; i++) \
+    transparent_crc (p[i], vname, flag); \
+}
+
+TRANSPARENT_CRC_ARRAY(int8_t)
+TRANSPARENT_CRC_ARRAY(uint8_t)
+TRANSPARENT_CRC_ARRAY(int16_t)
+TRANSPARENT_CRC_ARRAY(uint16_t)
+TRANSPARENT_CRC_ARRAY(int32_t)
+TRANSPARENT_CRC_ARRAY(uint32_t)
+#ifndef NO_LONGLONG
+TRANSPARENT_CRC_ARRAY(int64_t)
+TRANSPARENT_CRC_ARRAY(uint64_t)
+#endif
+
 #ifdef NO_PRINTF
 void my_puts (char *p)
 {
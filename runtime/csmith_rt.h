@@ -0,0 +1,140 @@
+/* -*- mode: C -*-
+ *
+ * Copyright (c) 2012 The University of Utah
+ * All rights reserved.
+ *
+ * This file is part of `csmith', a random generator of C programs.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CSMITH_RT_H
+#define CSMITH_RT_H
+
+/*****************************************************************************/
+
+/*
+ * Declarations of the runtime that csmith.h defines, for programs generated
+ * with "--runtime-lib" and linked with libcsmith_rt.a (see csmith_rt.c).
+ * There are no definitions here, so the header is cheap to parse and can be
+ * precompiled once for a whole test run.
+ */
+
+#include <string.h>
+#include <stddef.h>
+
+#define __STDC_LIMIT_MACROS
+#include <limits.h>
+#if defined(_MSC_VER)
+#include "windows/stdint.h"
+#else
+#include <stdint.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern uint32_t crc32_context;
+
+extern void crc32_gentab (void);
+
+#if defined(__SPLAT__) || defined(NO_LONGLONG)
+extern void transparent_crc (uint32_t val, char* vname, int flag);
+#else
+extern void transparent_crc (uint64_t val, char* vname, int flag);
+#endif
+
+#define TRANSPARENT_CRC_ARRAY_DECL(type) \
+extern void transparent_crc_array_##type (const type *p, size_t n, char* vname, int flag);
+
+TRANSPARENT_CRC_ARRAY_DECL(int8_t)
+TRANSPARENT_CRC_ARRAY_DECL(uint8_t)
+TRANSPARENT_CRC_ARRAY_DECL(int16_t)
+TRANSPARENT_CRC_ARRAY_DECL(uint16_t)
+TRANSPARENT_CRC_ARRAY_DECL(int32_t)
+TRANSPARENT_CRC_ARRAY_DECL(uint32_t)
+#if !defined(__SPLAT__) && !defined(NO_LONGLONG)
+TRANSPARENT_CRC_ARRAY_DECL(int64_t)
+TRANSPARENT_CRC_ARRAY_DECL(uint64_t)
+#endif
+
+extern void platform_main_begin (void);
+extern void platform_main_end (uint32_t crc, int flag);
+
+/* The safe math wrappers of safe_math.m4, one set per integer type */
+
+#define SAFE_SIGNED_MATH_DECL(t) \
+extern t safe_unary_minus_func_##t##_s (t si); \
+extern t safe_add_func_##t##_s_s (t si1, t si2); \
+extern t safe_sub_func_##t##_s_s (t si1, t si2); \
+extern t safe_mul_func_##t##_s_s (t si1, t si2); \
+extern t safe_mod_func_##t##_s_s (t si1, t si2); \
+extern t safe_div_func_##t##_s_s (t si1, t si2); \
+extern t safe_lshift_func_##t##_s_s (t left, int right); \
+extern t safe_lshift_func_##t##_s_u (t left, unsigned int right); \
+extern t safe_rshift_func_##t##_s_s (t left, int right); \
+extern t safe_rshift_func_##t##_s_u (t left, unsigned int right);
+
+#define SAFE_UNSIGNED_MATH_DECL(t) \
+extern t safe_unary_minus_func_##t##_u (t ui); \
+extern t safe_add_func_##t##_u_u (t ui1, t ui2); \
+extern t safe_sub_func_##t##_u_u (t ui1, t ui2); \
+extern t safe_mul_func_##t##_u_u (t ui1, t ui2); \
+extern t safe_mod_func_##t##_u_u (t ui1, t ui2); \
+extern t safe_div_func_##t##_u_u (t ui1, t ui2); \
+extern t safe_lshift_func_##t##_u_s (t left, int right); \
+extern t safe_lshift_func_##t##_u_u (t left, unsigned int right); \
+extern t safe_rshift_func_##t##_u_s (t left, int right); \
+extern t safe_rshift_func_##t##_u_u (t left, unsigned int right);
+
+SAFE_SIGNED_MATH_DECL(int8_t)
+SAFE_SIGNED_MATH_DECL(int16_t)
+SAFE_SIGNED_MATH_DECL(int32_t)
+SAFE_UNSIGNED_MATH_DECL(uint8_t)
+SAFE_UNSIGNED_MATH_DECL(uint16_t)
+SAFE_UNSIGNED_MATH_DECL(uint32_t)
+#ifndef NO_LONGLONG
+SAFE_SIGNED_MATH_DECL(int64_t)
+SAFE_UNSIGNED_MATH_DECL(uint64_t)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#define INT_BIT (sizeof(int)*CHAR_BIT)
+#define _CSMITH_BITFIELD(x) (((x)>INT_BIT)?((x)%INT_BIT):(x))
+
+/*****************************************************************************/
+
+#endif /* CSMITH_RT_H */
+
+/*
+ * Local Variables:
+ * c-basic-offset: 4
+ * tab-width: 4
+ * End:
+ */
+
+/* End of file. */
@@ -0,0 +1,156 @@
+/* -*- mode: C -*-
+ *
+ * Copyright (c) 2012 The University of Utah
+ * All rights reserved.
+ *
+ * This file is part of `csmith', a random generator of C programs.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CSMITH_TRACE_H
+#define CSMITH_TRACE_H
+
+/*****************************************************************************/
+
+/*
+ * The trace of a program generated with "--checksum-trace". Before a
+ * function returns, the program folds the values it wrote into a running
+ * state with csmith_trace_value, and records the state with the number of
+ * the function with csmith_trace_exit. Records are buffered and written to
+ * the file named by $CSMITH_TRACE, or csmith.trace by default. The file is
+ * the magic "CSTR" and the version, each as a native uint32_t, followed by
+ * one pair of uint32_t (function, state) per function exit.
+ *
+ * The state only depends on the values, so the traces of two builds of a
+ * program agree up to the first function exit whose results differ.
+ */
+
+#if defined (CSMITH_MINIMAL) || defined (STANDALONE)
+/* the minimal and standalone runtimes have no libc headers */
+typedef void csmith_trace_file_t;
+extern csmith_trace_file_t *fopen (const char *, const char *);
+extern unsigned long fwrite (const void *, unsigned long, unsigned long, csmith_trace_file_t *);
+extern int fclose (csmith_trace_file_t *);
+extern char *getenv (const char *);
+extern int atexit (void (*) (void));
+#else
+#include <stdio.h>
+#include <stdlib.h>
+typedef FILE csmith_trace_file_t;
+#endif
+
+#define CSMITH_TRACE_MAGIC 0x52545343UL
+#define CSMITH_TRACE_VERSION 1
+
+/* records are written in batches of this many */
+#define CSMITH_TRACE_BUFFER 1024
+
+/* a program that runs for long stops recording after this many */
+#define CSMITH_TRACE_MAX_RECORDS (1UL << 20)
+
+static uint32_t csmith_trace_state = 2166136261UL;
+static uint32_t csmith_trace_buf[2 * CSMITH_TRACE_BUFFER];
+static unsigned int csmith_trace_n = 0;
+static unsigned long csmith_trace_total = 0;
+static csmith_trace_file_t *csmith_trace_f = 0;
+
+static void
+csmith_trace_flush (void)
+{
+	if (csmith_trace_f && csmith_trace_n) {
+		fwrite (csmith_trace_buf, sizeof (uint32_t), 2 * csmith_trace_n, csmith_trace_f);
+	}
+	csmith_trace_n = 0;
+}
+
+static void
+csmith_trace_close (void)
+{
+	csmith_trace_flush ();
+	if (csmith_trace_f) {
+		fclose (csmith_trace_f);
+		csmith_trace_f = 0;
+	}
+}
+
+static void
+csmith_trace_open (void)
+{
+	const char *name = getenv ("CSMITH_TRACE");
+	uint32_t header[2];
+
+	csmith_trace_f = fopen (name ? name : "csmith.trace", "wb");
+	if (csmith_trace_f) {
+		header[0] = CSMITH_TRACE_MAGIC;
+		header[1] = CSMITH_TRACE_VERSION;
+		fwrite (header, sizeof (uint32_t), 2, csmith_trace_f);
+		atexit (csmith_trace_close);
+	}
+}
+
+/* FNV-1a over the value, 32 bits at a time */
+#ifdef NO_LONGLONG
+static inline void
+csmith_trace_value (uint32_t val)
+{
+	csmith_trace_state = (csmith_trace_state ^ val) * 16777619UL;
+}
+#else
+static inline void
+csmith_trace_value (uint64_t val)
+{
+	csmith_trace_state = (csmith_trace_state ^ (uint32_t)val) * 16777619UL;
+	csmith_trace_state = (csmith_trace_state ^ (uint32_t)(val >> 32)) * 16777619UL;
+}
+#endif
+
+static void
+csmith_trace_exit (uint32_t func)
+{
+	if (csmith_trace_total >= CSMITH_TRACE_MAX_RECORDS) {
+		return;
+	}
+	if (csmith_trace_total == 0) {
+		csmith_trace_open ();
+	}
+	csmith_trace_total++;
+	csmith_trace_buf[2 * csmith_trace_n] = func;
+	csmith_trace_buf[2 * csmith_trace_n + 1] = csmith_trace_state;
+	if (++csmith_trace_n == CSMITH_TRACE_BUFFER) {
+		csmith_trace_flush ();
+	}
+}
+
+/*****************************************************************************/
+
+#endif /* CSMITH_TRACE_H */
+
+/*
+ * Local Variables:
+ * c-basic-offset: 4
+ * tab-width: 4
+ * End:
+ */
+
+/* End of file. */
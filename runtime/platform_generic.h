@@ -39,13 +39,44 @@ extern int printf (const char *, ...);
 #include <stdio.h>
 #endif
 
+#if defined (CSMITH_PROFILE_COUNTERS) && !defined (STANDALONE)
+#include <stdlib.h>
+
+/*
+ * The record csmith-profile reads: the magic "CSPF", the version, the
+ * number of counters and the checksum, each as a native uint32_t, then
+ * the counters.
+ */
+#define CSMITH_PROFILE_MAGIC 0x46505343UL
+#define CSMITH_PROFILE_VERSION 1
+
 static void
+platform_write_profile(uint32_t crc)
+{
+	const char *name = getenv ("CSMITH_PROFILE");
+	FILE *f = fopen (name ? name : "csmith.prof", "wb");
+	uint32_t header[4];
+
+	if (!f) {
+		return;
+	}
+	header[0] = CSMITH_PROFILE_MAGIC;
+	header[1] = CSMITH_PROFILE_VERSION;
+	header[2] = __csmith_prof_n;
+	header[3] = crc;
+	fwrite (header, sizeof (uint32_t), 4, f);
+	fwrite (__csmith_prof, sizeof (uint32_t), __csmith_prof_n, f);
+	fclose (f);
+}
+#endif
+
+STATIC void
 platform_main_begin(void)
 {
 	/* Nothing to do. */
 }
 
-static void
+STATIC void
 platform_main_end(uint32_t crc, int flag)
 {
 #if defined (__FRAMAC)
@@ -56,6 +87,10 @@ platform_main_end(uint32_t crc, int flag)
 	printf ("checksum = %X\n", crc);
 #endif
 
+#if defined (CSMITH_PROFILE_COUNTERS) && !defined (STANDALONE)
+	platform_write_profile (crc);
+#endif
+
 #if defined (LOG_WRAPPERS)
 	{
 		int i, first;
@@ -81,6 +81,24 @@ char __executed_checks[N_WRAP+1];
 #define LOG_EXEC
 #endif
 
+/* the counters of a program generated with "--emit-profile-counters" */
+#ifdef CSMITH_PROFILE_COUNTERS
+extern uint32_t __csmith_prof[];
+extern const unsigned int __csmith_prof_n;
+#endif
+
+/* the trace of a program generated with "--checksum-trace" */
+#ifdef CSMITH_CHECKSUM_TRACE
+#include "csmith_trace.h"
+#endif
+
+/* csmith_rt.c builds the runtime functions with external linkage */
+#ifdef CSMITH_RT_BUILD
+#define STATIC
+#else
+#define STATIC static
+#endif
+
 #if defined(AVR_ARCH)
 #include "platform_avr.h"
 #elif defined (MSP430)
@@ -89,8 +107,6 @@ char __executed_checks[N_WRAP+1];
 #include "platform_generic.h"
 #endif
 
-#define STATIC static
-
 #if defined (USE_MATH_MACROS_NOTMP)
 #include "safe_math_macros_notmp.h"
 #elif defined (USE_MATH_MACROS)
@@ -35,12 +35,17 @@ dnl But note that some of the functions on that page are wrong!
 #ifndef SAFE_MATH_H
 #define SAFE_MATH_H
 
+dnl A program generated with "--prune-safe-math" defines CSMITH_PRUNE_SAFE_MATH
+dnl and CSMITH_USE_<wrapper> for each wrapper it calls; the compiler then only
+dnl sees the definitions of those wrappers.
+
 define(`promote1',`ifelse($1,int64_t,long long,int)')
 define(`promote2',`ifelse($1,uint64_t,unsigned long long,unsigned int)')
 define(`maxshift',`ifelse($1,int64_t,64,32)')
 
 define(`safe_signed_math',`
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_unary_minus_func_$1_s)
 STATIC $1
 FUNC_NAME(unary_minus_func_$1_s)($1 si LOG_INDEX)
 {
@@ -54,7 +59,9 @@ FUNC_NAME(unary_minus_func_$1_s)($1 si LOG_INDEX)
 #endif
     -si;
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_add_func_$1_s_s)
 STATIC $1
 FUNC_NAME(add_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 {
@@ -68,7 +75,9 @@ FUNC_NAME(add_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 #endif
     (si1 + si2);
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_sub_func_$1_s_s)
 STATIC $1
 FUNC_NAME(sub_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 {
@@ -82,7 +91,9 @@ FUNC_NAME(sub_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 #endif
     (si1 - si2);
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_mul_func_$1_s_s)
 STATIC $1
 FUNC_NAME(mul_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 {
@@ -96,7 +107,9 @@ FUNC_NAME(mul_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 #endif
     si1 * si2;
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_mod_func_$1_s_s)
 STATIC $1
 FUNC_NAME(mod_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 {
@@ -108,7 +121,9 @@ FUNC_NAME(mod_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 #endif
     (si1 % si2);
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_div_func_$1_s_s)
 STATIC $1
 FUNC_NAME(div_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 {
@@ -120,7 +135,9 @@ FUNC_NAME(div_func_$1_s_s)($1 si1, $1 si2 LOG_INDEX)
 #endif
     (si1 / si2);
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_lshift_func_$1_s_s)
 STATIC $1
 FUNC_NAME(lshift_func_$1_s_s)($1 left, int right LOG_INDEX)
 {
@@ -132,7 +149,9 @@ FUNC_NAME(lshift_func_$1_s_s)($1 left, int right LOG_INDEX)
 #endif
     (left << ((int)right));
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_lshift_func_$1_s_u)
 STATIC $1
 FUNC_NAME(lshift_func_$1_s_u)($1 left, unsigned int right LOG_INDEX)
 {
@@ -144,7 +163,9 @@ FUNC_NAME(lshift_func_$1_s_u)($1 left, unsigned int right LOG_INDEX)
 #endif
     (left << ((unsigned int)right));
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_rshift_func_$1_s_s)
 STATIC $1
 FUNC_NAME(rshift_func_$1_s_s)($1 left, int right LOG_INDEX)
 {
@@ -156,7 +177,9 @@ FUNC_NAME(rshift_func_$1_s_s)($1 left, int right LOG_INDEX)
 #endif
     (left >> ((int)right));
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_rshift_func_$1_s_u)
 STATIC $1
 FUNC_NAME(rshift_func_$1_s_u)($1 left, unsigned int right LOG_INDEX)
 {
@@ -168,6 +191,7 @@ FUNC_NAME(rshift_func_$1_s_u)($1 left, unsigned int right LOG_INDEX)
 #endif
     (left >> ((unsigned int)right));
 }
+#endif
 ')
 
 safe_signed_math(int8_t,INT8_MIN,INT8_MAX)
@@ -179,34 +203,43 @@ safe_signed_math(int64_t,INT64_MIN,INT64_MAX)
 
 define(`safe_unsigned_math',`
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_unary_minus_func_$1_u)
 STATIC $1
 FUNC_NAME(unary_minus_func_$1_u)($1 ui LOG_INDEX)
 {
   LOG_EXEC
   return -ui;
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_add_func_$1_u_u)
 STATIC $1
 FUNC_NAME(add_func_$1_u_u)($1 ui1, $1 ui2 LOG_INDEX)
 {
   LOG_EXEC
   return ui1 + ui2;
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_sub_func_$1_u_u)
 STATIC $1
 FUNC_NAME(sub_func_$1_u_u)($1 ui1, $1 ui2 LOG_INDEX)
 {
   LOG_EXEC
   return ui1 - ui2;
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_mul_func_$1_u_u)
 STATIC $1
 FUNC_NAME(mul_func_$1_u_u)($1 ui1, $1 ui2 LOG_INDEX)
 {
   LOG_EXEC
   return ((promote2($1))ui1) * ((promote2($1))ui2);
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_mod_func_$1_u_u)
 STATIC $1
 FUNC_NAME(mod_func_$1_u_u)($1 ui1, $1 ui2 LOG_INDEX)
 {
@@ -218,7 +251,9 @@ FUNC_NAME(mod_func_$1_u_u)($1 ui1, $1 ui2 LOG_INDEX)
 #endif
     (ui1 % ui2);
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_div_func_$1_u_u)
 STATIC $1
 FUNC_NAME(div_func_$1_u_u)($1 ui1, $1 ui2 LOG_INDEX)
 {
@@ -230,7 +265,9 @@ FUNC_NAME(div_func_$1_u_u)($1 ui1, $1 ui2 LOG_INDEX)
 #endif
     (ui1 / ui2);
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_lshift_func_$1_u_s)
 STATIC $1
 FUNC_NAME(lshift_func_$1_u_s)($1 left, int right LOG_INDEX)
 {
@@ -242,7 +279,9 @@ FUNC_NAME(lshift_func_$1_u_s)($1 left, int right LOG_INDEX)
 #endif
     (left << ((int)right));
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_lshift_func_$1_u_u)
 STATIC $1
 FUNC_NAME(lshift_func_$1_u_u)($1 left, unsigned int right LOG_INDEX)
 {
@@ -254,7 +293,9 @@ FUNC_NAME(lshift_func_$1_u_u)($1 left, unsigned int right LOG_INDEX)
 #endif
     (left << ((unsigned int)right));
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_rshift_func_$1_u_s)
 STATIC $1
 FUNC_NAME(rshift_func_$1_u_s)($1 left, int right LOG_INDEX)
 {
@@ -266,7 +307,9 @@ FUNC_NAME(rshift_func_$1_u_s)($1 left, int right LOG_INDEX)
 #endif
     (left >> ((int)right));
 }
+#endif
 
+#if !defined(CSMITH_PRUNE_SAFE_MATH) || defined(CSMITH_USE_rshift_func_$1_u_u)
 STATIC $1
 FUNC_NAME(rshift_func_$1_u_u)($1 left, unsigned int right LOG_INDEX)
 {
@@ -278,6 +321,7 @@ FUNC_NAME(rshift_func_$1_u_u)($1 left, unsigned int right LOG_INDEX)
 #endif
     (left >> ((unsigned int)right));
 }
+#endif
 ')
 
 safe_unsigned_math(uint8_t,UINT8_MAX)
@@ -38,6 +38,10 @@ use File::stat;
 # programs shorter than this many bytes are too boring to test
 my $MIN_PROGRAM_SIZE = 8000;
 
+# set to 1 to have Csmith grow each program to $MIN_PROGRAM_SIZE, which
+# makes retries rare but changes the program every seed produces
+my $CSMITH_SIZE_WINDOW = 0;
+
 # kill Csmith after this many seconds
 my $CSMITH_TIMEOUT = 90; 
 
@@ -128,6 +132,40 @@ sub runit ($$$) {
     return ($success, $exit_value);
 }
 
+# compare the traces that two runs of a program generated with
+# "--checksum-trace" wrote, and describe the first function exit whose
+# state differs; return "" if there is no trace or no difference
+sub first_trace_divergence($$) {
+    my ($trace1, $trace2) = @_;
+    my @t;
+    foreach my $fn ($trace1, $trace2) {
+        return "" if (!(-e $fn));
+        open TRACE, "<$fn" or return "";
+        binmode TRACE;
+        local $/;
+        my @words = unpack("L*", <TRACE>);
+        close TRACE;
+        # skip the magic "CSTR" and the version
+        return "" if (scalar(@words) < 2 || $words[0] != 0x52545343);
+        push @t, [ @words[2..$#words] ];
+    }
+    my @a = @{$t[0]};
+    my @b = @{$t[1]};
+    for (my $i = 0; $i + 1 < scalar(@a) && $i + 1 < scalar(@b); $i += 2) {
+        if ($a[$i] != $b[$i] || $a[$i+1] != $b[$i+1]) {
+            my $k = $i / 2;
+            return "first divergence at function exit #$k: func_$a[$i] vs. func_$b[$i]" 
+                if ($a[$i] != $b[$i]);
+            return "first divergence at function exit #$k: func_$a[$i]";
+        }
+    }
+    if (scalar(@a) != scalar(@b)) {
+        my $k = (scalar(@a) < scalar(@b) ? scalar(@a) : scalar(@b)) / 2;
+        return "first divergence at function exit #$k: one trace ends there";
+    }
+    return "";
+}
+
 # compile a program and execute
 # return code 0: normal; 
 #                     1: compiler crashes; 
@@ -154,6 +192,8 @@ sub compile_and_run($$$$) {
 
     # run random program 
     if ($RUN_PROGRAM) {
+        # where a program generated with "--checksum-trace" writes its trace
+        $ENV{"CSMITH_TRACE"} = "$exe.trace";
         ($res, $exit_value) = runit("./$exe", $PROG_TIMEOUT, $out);
         # print "after run program: $res, $exit_value\n";
         if (($res == 0) || (!(-e $out))) {
@@ -173,6 +213,7 @@ sub compile_and_run($$$$) {
 sub evaluate_program ($) {
     my ($test_file) = @_; 
     my @checksums;
+    my @traces;
     my @tested_compilers; 
     my $interesting = 0;
     my $i = 0;     
@@ -208,6 +249,7 @@ sub evaluate_program ($) {
                 $interesting = 2 if 
 		    (scalar(@checksums) > 0 && $sum ne $checksums[0]); 
                 push @checksums, $sum;
+                push @traces, "$exe.trace";
                 push @tested_compilers, "$compiler $COMPILE_OPTIONS";
             }             
         }
@@ -220,6 +262,12 @@ sub evaluate_program ($) {
                 write_bug_desc_to_file ($test_file, 
 		  "$tested_compilers[$i]: $checksums[$i]");
             }
+            for (my $i=1; $i < scalar (@checksums); $i++) {
+                next if ($checksums[$i] eq $checksums[0]);
+                my $where = first_trace_divergence($traces[0], $traces[$i]);
+                write_bug_desc_to_file ($test_file,
+		  "$tested_compilers[$i] vs. $tested_compilers[0]: $where") if ($where ne "");
+            }
         }
         write_bug_desc_to_file($test_file, 
 	  "please refer to http://embed.cs.utah.edu/csmith/using.html on how to report a bug");
@@ -235,9 +283,10 @@ sub test_one ($) {
     my $filesize;
 
     # run Csmith until generate a big enough program
+    my $size_opts = $CSMITH_SIZE_WINDOW ? "--min-size $MIN_PROGRAM_SIZE " : "";
     while (1) {
         unlink $cfile;
-        my $cmd = "$CSMITH_HOME/src/csmith $CSMITH_USER_OPTIONS --output $cfile";
+        my $cmd = "$CSMITH_HOME/src/csmith $size_opts$CSMITH_USER_OPTIONS --output $cfile";
         my ($res, $exitcode) = runit($cmd, $CSMITH_TIMEOUT,  "csmith.out"); 
         # print "after run csmith: $res, $exitcode\n";
 	
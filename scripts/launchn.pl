@@ -31,6 +31,9 @@
 
 # This script illustrates how to run compiler_test.pl in parallel on multi-core machines. Please make sure
 # these processes are terminated at the end of your testing 
+#
+# src/csmith-test reads the same configuration file and keeps all cores busy from a single process:
+#   csmith-test 0 <config-file> [--with-wrong-code-bugs]
 
 #!/usr/bin/perl -w
  use strict;
@@ -43,11 +43,17 @@
 #include "ArrayVariable.h"
 #include "Fact.h"
 #include "random.h"  
+#include "GenerationContext.h"
 
 static const char runtime_include[] = "\
 #include \"csmith.h\"\n\
 ";
 
+static const char runtime_lib_include[] = "\
+/* Link this program with libcsmith_rt.a. */\n\
+#include \"csmith_rt.h\"\n\
+";
+
 static const char volatile_include[] = "\
 /* To use wrapper functions, compile this program with -DWRAP_VOLATILES=1. */\n\
 #include \"volatile_runtime.h\"\n\
@@ -61,18 +67,32 @@ static const char access_once_macro[] = "\
 
 using namespace std;
 
+// TAB repeated, so that the indentation of the deepest blocks can be
+// copied in one go
+static const char tabs[] =
+	TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB
+	TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB TAB;
+static const int tab_len = sizeof(TAB) - 1;
+static const int max_tabs = (sizeof(tabs) - 1) / tab_len;
+
 // Initialize an output manager with:
-// 1) create the output stream
+// 1) create the output stream and the buffer in front of it
 // 2) set the tab indent to 0
 void
 AbsOutputMgr::Init()
 { 
 	ofile_ = NULL;
-	std::string ofile_str = CGOptions::output_file();
+	out_ = GenerationContext::current().output_stream;
+	std::string ofile_str = GenerationContext::current().output_file;
+	if (ofile_str.empty())
+		ofile_str = CGOptions::output_file();
 
-	if (!ofile_str.empty()) {
+	if (!out_ && !ofile_str.empty()) {
 		ofile_ = new ofstream(ofile_str.c_str());  
+		out_ = ofile_;
 	} 
+	buf_ = new OutputBuffer(out_ ? out_->rdbuf() : std::cout.rdbuf());
+	emit_ = new std::ostream(buf_);
 
 	indent_ = 0; 
 	newline_ = "\n"; 
@@ -80,11 +100,89 @@ AbsOutputMgr::Init()
 
 AbsOutputMgr::~AbsOutputMgr()
 { 
+	delete emit_;
+	delete buf_;
 	if (ofile_)
 		ofile_->close();
 	delete ofile_;
 }
 
+void
+AbsOutputMgr::AppendTab(std::string &str, int indent)
+{
+	for (; indent > max_tabs; indent -= max_tabs)
+		str.append(tabs, max_tabs * tab_len);
+	str.append(tabs, indent * tab_len);
+}
+
+void
+AbsOutputMgr::OutputTab(int indent)
+{
+	for (; indent > max_tabs; indent -= max_tabs)
+		buf_->append(tabs, max_tabs * tab_len);
+	buf_->append(tabs, indent * tab_len);
+}
+
+// A sink that only counts what is written to it
+class ByteCounter : public std::streambuf
+{
+public:
+	ByteCounter(void) : count(0) {}
+
+	size_t count;
+
+protected:
+	virtual int_type overflow(int_type c) {
+		if (!traits_type::eq_int_type(c, traits_type::eof()))
+			count++;
+		return traits_type::not_eof(c);
+	}
+
+	virtual std::streamsize xsputn(const char *, std::streamsize n) {
+		count += n;
+		return n;
+	}
+};
+
+size_t
+AbsOutputMgr::FunctionSize(const Function& f)
+{
+	ByteCounter counter;
+	OutputBuffer *saved_buf = buf_;
+	std::ostream *saved_emit = emit_;
+	int saved_indent = indent_;
+
+	// render the function into a small buffer in front of the counter
+	buf_ = new OutputBuffer(&counter, 1 << 14);
+	emit_ = new std::ostream(buf_);
+	indent_ = 0;
+	OutputFunction(f);
+	buf_->flush();
+	delete emit_;
+	delete buf_;
+
+	buf_ = saved_buf;
+	emit_ = saved_emit;
+	indent_ = saved_indent;
+	return counter.count;
+}
+
+size_t
+AbsOutputMgr::GlobalSize(const Variable& v)
+{
+	// hashing an array takes fresh loop control variables; give them back
+	GenerationContext &ctx = GenerationContext::current();
+	unsigned long saved_ctrl_vars = ctx.ctrl_vars_count;
+	int saved_indent = indent_;
+
+	indent_ = 1;
+	size_t size = VarDef2Str(v).size() + VarHash2Str(v).size();
+
+	ctx.ctrl_vars_count = saved_ctrl_vars;
+	indent_ = saved_indent;
+	return size;
+}
+
 void
 AbsOutputMgr::OutputTail()
 {
@@ -140,7 +238,44 @@ AbsOutputMgr::OutputProgramHeader(int argc, char *argv[], unsigned long seed)
 		out << endl;
 	} 
 
-	out << runtime_include << endl;
+	// select the checksum implementation of the runtime
+	if (CGOptions::compute_hash()) {
+		if (CGOptions::checksum_algo() == "crc32-slice8") {
+			out << "#define CSMITH_CRC_SLICE8" << endl;
+			out << endl;
+		}
+		else if (CGOptions::checksum_algo() == "word") {
+			out << "#define CSMITH_WORD_HASH" << endl;
+			out << endl;
+		}
+	}
+
+	// have the runtime declare the counters and dump them at the end
+	if (CGOptions::emit_profile_counters()) {
+		out << "#define CSMITH_PROFILE_COUNTERS" << endl;
+		out << endl;
+	}
+
+	// have the runtime define the trace functions
+	if (CGOptions::checksum_trace()) {
+		out << "#define CSMITH_CHECKSUM_TRACE" << endl;
+		out << endl;
+	}
+
+	// with --prune-safe-math the runtime can only be included once the
+	// program is generated and its safe math wrappers are known
+	if (!CGOptions::prune_safe_math())
+		OutputRuntimeInclude();
+}
+
+void
+AbsOutputMgr::OutputRuntimeInclude()
+{
+	std::ostream &out = Out();
+	if (CGOptions::runtime_lib())
+		out << runtime_lib_include << endl;
+	else
+		out << runtime_include << endl;
 
  	if (!CGOptions::compute_hash()) {
 		if (CGOptions::allow_int64())
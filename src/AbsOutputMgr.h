@@ -50,6 +50,7 @@ using namespace std;
 #include "FunctionInvocationBinary.h"
 #include "FunctionInvocationUnary.h"
 #include "Variable.h"
+#include "OutputBuffer.h"
 
 class Variable;
 class Type;
@@ -73,8 +74,15 @@ public:
 	// Initialize output manager, such is creating output stream 
 	virtual void Init();
 
-	// Get a handle to the output stream. Can be either a file or std::out
-	std::ostream& Out() { if (ofile_) return *ofile_; else return (std::cout); }
+	// Get a handle to the output stream. Everything written to it goes
+	// through the output buffer in front of the file or std::out
+	std::ostream& Out() { return *emit_; }
+
+	// Append a string to the output buffer directly
+	void Emit(const std::string &str) { buf_->append(str); }
+
+	// Write everything buffered so far to the output file
+	void Flush() { buf_->flush(); }
 
 	/// 
 	/// All the pure virtual output functions must be defined in subclasses
@@ -96,9 +104,14 @@ public:
 	virtual std::string ScopeCloser2Str(void) = 0;
 
 	// Return the specified number of tabs as string (to properly tab the output) 
-	static std::string Tab2Str(int indent) { string str; while (indent--) str += TAB; return str;}
+	static std::string Tab2Str(int indent) { string str; AppendTab(str, indent); return str;}
 	// return the current number of tabs as string (tab number is updated when entering/exiting blocks
 	std::string Tab2Str() { return Tab2Str(indent_);}
+	// Append the specified number of tabs to a string
+	static void AppendTab(std::string &str, int indent);
+	// Output the current number of tabs
+	void OutputTab() { OutputTab(indent_); }
+	void OutputTab(int indent);
 
 	///
 	/// Outputting language contructs
@@ -116,17 +129,24 @@ public:
 	// outputted even before the random generation, so we can reproduce a hang with those info.
 	virtual void OutputProgramHeader(int argc, char *argv[], unsigned long seed);
 
+	// Output the include of the runtime and the definitions that need it
+	virtual void OutputRuntimeInclude();
+
 	// Output a block which is a container for sequential statements and local variables
 	virtual void OutputBlock(const Block& b) = 0;     
 
 	// Output a function definition
 	virtual void OutputFunction(const Function& f) = 0;  
+	// Return the number of bytes OutputFunction would write for f
+	virtual size_t FunctionSize(const Function& f);
 
 	// Output a statement
 	virtual void OutputStatement(const Statement& s) = 0;	 
 	
+	// Append the string representation of an expression to str
+	virtual void AppendExpression(std::string &str, const Expression& e) = 0;
 	// Return string representation of an expression
-	virtual std::string Expression2Str(const Expression& e) = 0;	
+	std::string Expression2Str(const Expression& e) { string str; AppendExpression(str, e); return str; }
 	
 	// Output an user defined type, such as structures
 	virtual void OutputUserDefinedType(const Type& t) = 0;
@@ -152,14 +172,18 @@ public:
 	///
 	/// Variable output functions
 	///
+	// Append a variable reference to str
+	virtual void AppendVarRef(std::string &str, const Variable& v) = 0;
 	// Output a variable reference
-	virtual std::string VarRef2Str(const Variable& v) = 0;  
+	std::string VarRef2Str(const Variable& v) { string str; AppendVarRef(str, v); return str; }
 	// Output a variable declaration
 	virtual std::string VarDecl2Str(const Variable& v) = 0;
 	// Output a set of variable declarations
 	virtual std::string VarDecls2Str(const vector <const Variable*> &vars) = 0;
 	// Output a variable definition
 	virtual std::string VarDef2Str(const Variable& v) = 0;
+	// Return the number of bytes the definition and the hashing of a global add
+	virtual size_t GlobalSize(const Variable& v);
 	// Output a set of variable definitions
 	virtual std::string VarDefs2Str(const vector<Variable*> &vars) = 0;   
 	// Output a variable hashing
@@ -186,8 +210,17 @@ protected:
 	std::string newline_; 
 
 private: 
-	// The output stream. If NULL, use std::out.
+	// The output file we opened, if any.
 	std::ofstream *ofile_; 
+
+	// The output stream: ofile_, a stream given by the embedding
+	// application, or NULL for std::out.
+	std::ostream *out_;
+
+	// The buffer in front of out_, and the stream Out() returns for it
+	OutputBuffer *buf_;
+
+	std::ostream *emit_;
 };  
 
 #endif // ABS_OUTPUT_MGR_H
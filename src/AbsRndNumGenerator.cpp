@@ -37,18 +37,12 @@
 
 using namespace std;
 
-#ifdef WIN32
-extern "C" {
-	extern void srand48(long seed);
-	extern long lrand48(void);
-}
-#endif
-
 const char *AbsRndNumGenerator::hex1 = "0123456789ABCDEF";
 
 const char *AbsRndNumGenerator::dec1 = "0123456789";
 
 AbsRndNumGenerator::AbsRndNumGenerator()
+	: rand48_state_(0)
 {
 	//Nothing to do
 }
@@ -66,7 +60,6 @@ AbsRndNumGenerator::make_rndnum_generator(RNDNUM_GENERATOR impl, const unsigned
 {
 	AbsRndNumGenerator *rImpl = 0;
 
-	AbsRndNumGenerator::seedrand(seed);
 	switch (impl) {
 		case rDefaultRndNumGenerator: 
 			rImpl = DefaultRndNumGenerator::make_rndnum_generator(seed);
@@ -75,14 +68,20 @@ AbsRndNumGenerator::make_rndnum_generator(RNDNUM_GENERATOR impl, const unsigned
 			assert(!"unknown random generator");
 			break;
 	}
+	if (rImpl)
+		rImpl->seedrand(seed);
 
 	return rImpl;
 }
 
+/*
+ * Same recurrence and seeding as srand48()/lrand48(), so a given seed still
+ * produces the same program, but with the state kept in the generator.
+ */
 void
 AbsRndNumGenerator::seedrand(const unsigned long seed )
 {
-	srand48 (seed);
+	rand48_state_ = ((seed & 0xffffffffULL) << 16) | 0x330EULL;
 }
 
 /*
@@ -114,7 +113,8 @@ AbsRndNumGenerator::rnd_shuffle(unsigned int n)
 unsigned long 
 AbsRndNumGenerator::genrand(void)
 {
-	return lrand48();
+	rand48_state_ = (rand48_state_ * 0x5DEECE66DULL + 0xBULL) & 0xffffffffffffULL;
+	return static_cast<unsigned long>(rand48_state_ >> 17);
 }
 
 std::string
@@ -48,8 +48,6 @@ class AbsRndNumGenerator
 public:
 	static AbsRndNumGenerator *make_rndnum_generator(RNDNUM_GENERATOR impl, const unsigned long seed);
 
-	static void seedrand(const unsigned long seed);
-
 	static const char* get_hex1();
 
 	static const char* get_dec1();
@@ -82,6 +80,8 @@ public:
 protected:
 	virtual unsigned long genrand(void) = 0;
 
+	void seedrand(const unsigned long seed);
+
 	AbsRndNumGenerator();
 
 private:
@@ -91,6 +91,10 @@ private:
 
 	static const char *dec1;
 
+	// 48-bit state of the drand48 family LCG, private to each generator so
+	// that concurrent generations don't share (or race on) libc's state
+	unsigned long long rand48_state_;
+
 	// Don't implement them
 	DISALLOW_COPY_AND_ASSIGN(AbsRndNumGenerator);
 };
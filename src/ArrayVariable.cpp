@@ -262,7 +262,7 @@ ArrayVariable::itemize(void) const
 	size_t i;
 	assert(collective == 0);
 	ArrayVariable* av = new ArrayVariable(*this);
-	VariableSelector::AllVars.push_back(av);
+	VariableSelector::AllVars().push_back(av);
 	for (i=0; i<sizes.size(); i++) {
 		int index = rnd_upto(sizes[i]);
 		av->add_index(new Constant(get_int_type(), StringUtils::int2str(index)));
@@ -282,7 +282,7 @@ ArrayVariable::itemize(const vector<int>& const_indices) const
 	assert(collective == 0);
 	assert(const_indices.size() == sizes.size());
 	ArrayVariable* av = new ArrayVariable(*this);
-	VariableSelector::AllVars.push_back(av);
+	VariableSelector::AllVars().push_back(av);
 	for (i=0; i<sizes.size(); i++) {
 		int index = const_indices[i]; 
 		av->add_index(new Constant(get_int_type(), StringUtils::int2str(index)));
@@ -301,7 +301,7 @@ ArrayVariable::itemize(const std::vector<const Variable*>& indices, Block* blk)
 	size_t i;
 	assert(collective == 0);
 	ArrayVariable* av = new ArrayVariable(*this);
-	VariableSelector::AllVars.push_back(av);
+	VariableSelector::AllVars().push_back(av);
 	for (i=0; i<sizes.size(); i++) {
 		av->add_index(new ExpressionVariable(*indices[i]));
 	}
@@ -323,7 +323,7 @@ ArrayVariable::itemize(const std::vector<const Expression*>& indices, Block* blk
 	size_t i;
 	assert(collective == 0);
 	ArrayVariable* av = new ArrayVariable(*this); 
-	VariableSelector::AllVars.push_back(av);
+	VariableSelector::AllVars().push_back(av);
 	for (i=0; i<sizes.size(); i++) {
 		av->add_index(indices[i]);
 	}
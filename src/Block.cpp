@@ -58,6 +58,9 @@
 #include "CFGEdge.h"
 #include "Expression.h"
 #include "VectorFilter.h"
+#include "Profiler.h"
+#include "MemoryAccounting.h"
+#include "ProgramSize.h"
 
 using namespace std;
 
@@ -143,7 +146,10 @@ Block::make_random(CGContext &cg_context, bool looping)
 	unsigned int i;
 	if (b->stm_id == 1)
 		BREAK_NOP;			// for debugging
-	for (i = 0; i <= max; ++i) {
+	// the top-level block of the entry function keeps growing while the
+	// program is below its minimum size
+	bool grow = (b->parent == NULL && curr_func == GetFirstFunction());
+	for (i = 0; i <= max || (grow && ProgramSize::below_min()); ++i) {
 		Statement *s = Statement::make_random(cg_context);  
 		// In the exhaustive mode, Statement::make_random could return NULL;
 		if (!s)
@@ -480,10 +486,12 @@ Block::contains_back_edge(void) const
 bool 
 Block::find_fixed_point(vector<const Fact*> inputs, vector<const Fact*>& post_facts, CGContext& cg_context, int& fail_index, bool visit_once) const
 {
+	ProfileScope scope("find_fixed_point");
+	MemoryScope mem(eMemFacts);
 	FactMgr* fm = get_fact_mgr(&cg_context);  
 	// include outputs from all back edges leading to this block
 	size_t i;
-	static int g = 0;
+	static THREAD_LOCAL int g = 0;
 	vector<const CFGEdge*> edges;
 	int cnt = 0;
 	do {
@@ -45,49 +45,58 @@
 #include "Statement.h"
 #include "Block.h"
 #include "CGOptions.h"
+#include "MemoryAccounting.h"
+#include "GenerationBudget.h"
+#include "ExecCost.h"
+#include "GenerationContext.h"
 
 using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
  
-// counter for all levels of struct depth
-std::vector<int> Bookkeeper::struct_depth_cnts; 
-int Bookkeeper::union_var_cnt = 0;
-std::vector<int> Bookkeeper::expr_depth_cnts;
-std::vector<int> Bookkeeper::blk_depth_cnts;
-std::vector<int> Bookkeeper::dereference_level_cnts;
-int Bookkeeper::address_taken_cnt = 0;
-std::vector<int> Bookkeeper::read_dereference_cnts;
-std::vector<int> Bookkeeper::write_dereference_cnts;
-int Bookkeeper::cmp_ptr_to_null = 0;
-int Bookkeeper::cmp_ptr_to_ptr = 0;
-int Bookkeeper::cmp_ptr_to_addr = 0; 
-int Bookkeeper::read_volatile_cnt = 0;
-int Bookkeeper::write_volatile_cnt = 0;
-int Bookkeeper::read_non_volatile_cnt = 0;
-int Bookkeeper::write_non_volatile_cnt = 0;
-int Bookkeeper::read_volatile_thru_ptr_cnt = 0;
-int Bookkeeper::write_volatile_thru_ptr_cnt = 0;
-int Bookkeeper::pointer_avail_for_dereference = 0;
-int Bookkeeper::volatile_avail = 0;
-int Bookkeeper::structs_with_bitfields = 0;
-std::vector<int> Bookkeeper::vars_with_bitfields;
-std::vector<int> Bookkeeper::vars_with_full_bitfields;
-int Bookkeeper::vars_with_bitfields_address_taken_cnt = 0;
-int Bookkeeper::bitfields_in_total = 0;
-int Bookkeeper::unamed_bitfields_in_total = 0;
-int Bookkeeper::const_bitfields_in_total = 0;
-int Bookkeeper::volatile_bitfields_in_total = 0;
-int Bookkeeper::lhs_bitfields_structs_vars_cnt = 0;
-int Bookkeeper::rhs_bitfields_structs_vars_cnt = 0;
-int Bookkeeper::lhs_bitfield_cnt = 0;
-int Bookkeeper::rhs_bitfield_cnt = 0;
-int Bookkeeper::forward_jump_cnt = 0;
-int Bookkeeper::backward_jump_cnt = 0;
-int Bookkeeper::use_new_var_cnt = 0;
-int Bookkeeper::use_old_var_cnt = 0;
-bool Bookkeeper::rely_on_int_size = false;
-bool Bookkeeper::rely_on_ptr_size = false;
+// counters live in the per-generation context
+#define BOOKKEEPER_COUNTER(type, name) \
+	type &Bookkeeper::name(void) { return GenerationContext::current().name; }
+
+BOOKKEEPER_COUNTER(std::vector<int>, struct_depth_cnts)
+BOOKKEEPER_COUNTER(int, union_var_cnt)
+BOOKKEEPER_COUNTER(std::vector<int>, expr_depth_cnts)
+BOOKKEEPER_COUNTER(std::vector<int>, blk_depth_cnts)
+BOOKKEEPER_COUNTER(std::vector<int>, dereference_level_cnts)
+BOOKKEEPER_COUNTER(int, address_taken_cnt)
+BOOKKEEPER_COUNTER(std::vector<int>, read_dereference_cnts)
+BOOKKEEPER_COUNTER(std::vector<int>, write_dereference_cnts)
+BOOKKEEPER_COUNTER(int, cmp_ptr_to_null)
+BOOKKEEPER_COUNTER(int, cmp_ptr_to_ptr)
+BOOKKEEPER_COUNTER(int, cmp_ptr_to_addr)
+BOOKKEEPER_COUNTER(int, read_volatile_cnt)
+BOOKKEEPER_COUNTER(int, write_volatile_cnt)
+BOOKKEEPER_COUNTER(int, read_non_volatile_cnt)
+BOOKKEEPER_COUNTER(int, write_non_volatile_cnt)
+BOOKKEEPER_COUNTER(int, read_volatile_thru_ptr_cnt)
+BOOKKEEPER_COUNTER(int, write_volatile_thru_ptr_cnt)
+BOOKKEEPER_COUNTER(int, pointer_avail_for_dereference)
+BOOKKEEPER_COUNTER(int, volatile_avail)
+BOOKKEEPER_COUNTER(int, structs_with_bitfields)
+BOOKKEEPER_COUNTER(std::vector<int>, vars_with_bitfields)
+BOOKKEEPER_COUNTER(std::vector<int>, vars_with_full_bitfields)
+BOOKKEEPER_COUNTER(int, vars_with_bitfields_address_taken_cnt)
+BOOKKEEPER_COUNTER(int, bitfields_in_total)
+BOOKKEEPER_COUNTER(int, unamed_bitfields_in_total)
+BOOKKEEPER_COUNTER(int, const_bitfields_in_total)
+BOOKKEEPER_COUNTER(int, volatile_bitfields_in_total)
+BOOKKEEPER_COUNTER(int, lhs_bitfields_structs_vars_cnt)
+BOOKKEEPER_COUNTER(int, rhs_bitfields_structs_vars_cnt)
+BOOKKEEPER_COUNTER(int, lhs_bitfield_cnt)
+BOOKKEEPER_COUNTER(int, rhs_bitfield_cnt)
+BOOKKEEPER_COUNTER(int, forward_jump_cnt)
+BOOKKEEPER_COUNTER(int, backward_jump_cnt)
+BOOKKEEPER_COUNTER(int, use_new_var_cnt)
+BOOKKEEPER_COUNTER(int, use_old_var_cnt)
+BOOKKEEPER_COUNTER(bool, rely_on_int_size)
+BOOKKEEPER_COUNTER(bool, rely_on_ptr_size)
+
+#undef BOOKKEEPER_COUNTER
 
 /*
  *
@@ -119,16 +128,43 @@ formated_outputf(std::ostream &out, const char* msg, double num)
 void
 Bookkeeper::doFinalization()
 {
-	Bookkeeper::struct_depth_cnts.clear();
-	Bookkeeper::expr_depth_cnts.clear();
-	Bookkeeper::dereference_level_cnts.clear();
-	Bookkeeper::address_taken_cnt = 0;
-	Bookkeeper::write_dereference_cnts.clear();
-	Bookkeeper::read_dereference_cnts.clear();
-	Bookkeeper::cmp_ptr_to_null = 0;
-	Bookkeeper::cmp_ptr_to_ptr = 0;
-	Bookkeeper::cmp_ptr_to_addr = 0;
-	
+	Bookkeeper::struct_depth_cnts().clear();
+	Bookkeeper::union_var_cnt() = 0;
+	Bookkeeper::expr_depth_cnts().clear();
+	Bookkeeper::blk_depth_cnts().clear();
+	Bookkeeper::dereference_level_cnts().clear();
+	Bookkeeper::address_taken_cnt() = 0;
+	Bookkeeper::write_dereference_cnts().clear();
+	Bookkeeper::read_dereference_cnts().clear();
+	Bookkeeper::cmp_ptr_to_null() = 0;
+	Bookkeeper::cmp_ptr_to_ptr() = 0;
+	Bookkeeper::cmp_ptr_to_addr() = 0;
+	Bookkeeper::read_volatile_cnt() = 0;
+	Bookkeeper::write_volatile_cnt() = 0;
+	Bookkeeper::read_non_volatile_cnt() = 0;
+	Bookkeeper::write_non_volatile_cnt() = 0;
+	Bookkeeper::read_volatile_thru_ptr_cnt() = 0;
+	Bookkeeper::write_volatile_thru_ptr_cnt() = 0;
+	Bookkeeper::pointer_avail_for_dereference() = 0;
+	Bookkeeper::volatile_avail() = 0;
+	Bookkeeper::structs_with_bitfields() = 0;
+	Bookkeeper::vars_with_bitfields().clear();
+	Bookkeeper::vars_with_full_bitfields().clear();
+	Bookkeeper::vars_with_bitfields_address_taken_cnt() = 0;
+	Bookkeeper::bitfields_in_total() = 0;
+	Bookkeeper::unamed_bitfields_in_total() = 0;
+	Bookkeeper::const_bitfields_in_total() = 0;
+	Bookkeeper::volatile_bitfields_in_total() = 0;
+	Bookkeeper::lhs_bitfields_structs_vars_cnt() = 0;
+	Bookkeeper::rhs_bitfields_structs_vars_cnt() = 0;
+	Bookkeeper::lhs_bitfield_cnt() = 0;
+	Bookkeeper::rhs_bitfield_cnt() = 0;
+	Bookkeeper::forward_jump_cnt() = 0;
+	Bookkeeper::backward_jump_cnt() = 0;
+	Bookkeeper::use_new_var_cnt() = 0;
+	Bookkeeper::use_old_var_cnt() = 0;
+	Bookkeeper::rely_on_int_size() = false;
+	Bookkeeper::rely_on_ptr_size() = false;
 }
 
 int 
@@ -137,7 +173,7 @@ Bookkeeper::stat_blk_depths_for_stmt(const Statement* s)
 	size_t i, j; 
 	int cnt = 0;
 	if (s->eType != eBlock) {
-		incr_counter(blk_depth_cnts, s->get_blk_depth() -1);
+		incr_counter(blk_depth_cnts(), s->get_blk_depth() -1);
 		cnt++;
 	}
 	vector<const Block*> blks; 
@@ -169,11 +205,11 @@ Bookkeeper::output_stmts_statistics(std::ostream &out)
 	size_t i;
 	int stmt_cnt = stat_blk_depths();
 	formated_output(out, "stmts: ", stmt_cnt);
-	formated_output(out, "max block depth: ", (blk_depth_cnts.size() - 1));
+	formated_output(out, "max block depth: ", (blk_depth_cnts().size() - 1));
 	out << "breakdown:" << endl;
-	for (i=0; i<blk_depth_cnts.size(); i++) {
-		if (blk_depth_cnts[i]) {
-			out << "   depth: " << i << ", occurrence: " << blk_depth_cnts[i] << endl;
+	for (i=0; i<blk_depth_cnts().size(); i++) {
+		if (blk_depth_cnts()[i]) {
+			out << "   depth: " << i << ", occurrence: " << blk_depth_cnts()[i] << endl;
 		}
 	}
 }
@@ -194,25 +230,46 @@ Bookkeeper::output_statistics(std::ostream &out)
 	output_stmts_statistics(out);
 	out << endl;
 	output_var_freshness(out);
-	if (rely_on_int_size) {
+	if (rely_on_int_size()) {
 		out << "FYI: the random generator makes assumptions about the integer size. See ";
 		out << PLATFORM_CONFIG_FILE << " for more details." << endl;
 	}
-	if (rely_on_ptr_size) {
+	if (rely_on_ptr_size()) {
 		out << "FYI: the random generator makes assumptions about the pointer size. See ";
 		out << PLATFORM_CONFIG_FILE << " for more details." << endl;
 	}
+	if (CGOptions::memory_stats()) {
+		out << endl;
+		MemoryAccounting::output_statistics(out);
+	}
+	if (MemoryAccounting::limit_reached()) {
+		out << "FYI: the generator reached the --max-memory limit of " << CGOptions::max_memory();
+		out << " MB and stopped growing the program early." << endl;
+	}
+	if (GenerationBudget::stop_sid()) {
+		out << "FYI: the generator used up its --time-budget and stopped growing the program early;";
+		out << " regenerate it with --stmt-budget " << GenerationBudget::stop_sid();
+		out << " in place of --time-budget." << endl;
+	}
+	else if (GenerationBudget::exhausted()) {
+		out << "FYI: the generator used up its --stmt-budget";
+		out << " and stopped growing the program early." << endl;
+	}
+	if (ExecCost::enabled()) {
+		out << "FYI: the program is estimated to execute " << (unsigned long long)ExecCost::estimate();
+		out << " statements (--max-exec-cost " << CGOptions::max_exec_cost() << ")." << endl;
+	}
 }
 
 void
 Bookkeeper::output_struct_union_statistics(std::ostream &out)
 {
-	formated_output(out, "max struct depth: ", (struct_depth_cnts.size()-1));
+	formated_output(out, "max struct depth: ", (struct_depth_cnts().size()-1));
 	out << "breakdown:" << endl;
-	for (size_t i=0; i<struct_depth_cnts.size(); i++) {
-		out << "   depth: " << i << ", occurrence: " << struct_depth_cnts[i] << endl;
+	for (size_t i=0; i<struct_depth_cnts().size(); i++) {
+		out << "   depth: " << i << ", occurrence: " << struct_depth_cnts()[i] << endl;
 	}
-	formated_output(out, "total union variables: ", union_var_cnt);
+	formated_output(out, "total union variables: ", union_var_cnt());
 	Bookkeeper::output_bitfields(out);
 }
 
@@ -224,7 +281,7 @@ Bookkeeper::stat_expr_depths_for_stmt(const Statement* s)
 	vector<const Block*> blks;
 	s->get_exprs(exprs); 
 	for (i=0; i<exprs.size(); i++) {
-		incr_counter(expr_depth_cnts, exprs[i]->get_complexity());
+		incr_counter(expr_depth_cnts(), exprs[i]->get_complexity());
 	} 
 	s->get_blocks(blks);
 	for (i=0; i<blks.size(); i++) {
@@ -250,11 +307,11 @@ Bookkeeper::output_expr_statistics(std::ostream &out)
 {
 	size_t i;
 	stat_expr_depths();
-	formated_output(out, "max expression depth: ", (expr_depth_cnts.size() - 1));
+	formated_output(out, "max expression depth: ", (expr_depth_cnts().size() - 1));
 	out << "breakdown:" << endl;
-	for (i=0; i<expr_depth_cnts.size(); i++) {
-		if (expr_depth_cnts[i]) {
-			out << "   depth: " << i << ", occurrence: " << expr_depth_cnts[i] << endl;
+	for (i=0; i<expr_depth_cnts().size(); i++) {
+		if (expr_depth_cnts()[i]) {
+			out << "   depth: " << i << ", occurrence: " << expr_depth_cnts()[i] << endl;
 		}
 	}
 }
@@ -268,8 +325,8 @@ Bookkeeper::output_pointer_statistics(std::ostream &out)
 	int point_to_scalar = 0;
 	int point_to_struct = 0;
 	int point_to_pointer = 0;
-	const vector<const Variable*>& ptrs = FactPointTo::all_ptrs;
-	const vector<vector<const Variable*> >& aliases = FactPointTo::all_aliases;
+	const vector<const Variable*>& ptrs = FactPointTo::all_ptrs();
+	const vector<vector<const Variable*> >& aliases = FactPointTo::all_aliases();
 	for (i=0; i<ptrs.size(); i++) {
 		total_alias_cnt += aliases[i].size(); 
 		if (find_variable_in_set(aliases[i], FactPointTo::null_ptr) >= 0) {
@@ -292,29 +349,29 @@ Bookkeeper::output_pointer_statistics(std::ostream &out)
 	formated_output(out, "total number of pointers: ", ptrs.size());
 	if (ptrs.size() > 0) { 
 		out << endl;
-		formated_output(out, "times a variable address is taken: ", address_taken_cnt);
-		formated_output(out, "times a pointer is dereferenced on RHS: ", calc_total(read_dereference_cnts));
+		formated_output(out, "times a variable address is taken: ", address_taken_cnt());
+		formated_output(out, "times a pointer is dereferenced on RHS: ", calc_total(read_dereference_cnts()));
 		out << "breakdown:" << endl;
-		for (i=1; i<read_dereference_cnts.size(); i++) {
-			out << "   depth: " << i << ", occurrence: " << read_dereference_cnts[i] << endl;
+		for (i=1; i<read_dereference_cnts().size(); i++) {
+			out << "   depth: " << i << ", occurrence: " << read_dereference_cnts()[i] << endl;
 		}
-		formated_output(out, "times a pointer is dereferenced on LHS: ", calc_total(write_dereference_cnts));
+		formated_output(out, "times a pointer is dereferenced on LHS: ", calc_total(write_dereference_cnts()));
 		out << "breakdown:" << endl;
-		for (i=1; i<write_dereference_cnts.size(); i++) {
-			out << "   depth: " << i << ", occurrence: " << write_dereference_cnts[i] << endl;
+		for (i=1; i<write_dereference_cnts().size(); i++) {
+			out << "   depth: " << i << ", occurrence: " << write_dereference_cnts()[i] << endl;
 		}
-		formated_output(out, "times a pointer is compared with null: ", cmp_ptr_to_null);
-		formated_output(out, "times a pointer is compared with address of another variable: ", cmp_ptr_to_addr);
-		formated_output(out, "times a pointer is compared with another pointer: ", cmp_ptr_to_ptr);
-		formated_output(out, "times a pointer is qualified to be dereferenced: ", pointer_avail_for_dereference);
+		formated_output(out, "times a pointer is compared with null: ", cmp_ptr_to_null());
+		formated_output(out, "times a pointer is compared with address of another variable: ", cmp_ptr_to_addr());
+		formated_output(out, "times a pointer is compared with another pointer: ", cmp_ptr_to_ptr());
+		formated_output(out, "times a pointer is qualified to be dereferenced: ", pointer_avail_for_dereference());
 
 		// if there are dereferenced pointers
-		if (dereference_level_cnts.size()) {
+		if (dereference_level_cnts().size()) {
 			out << endl;
-			formated_output(out, "max dereference level: ", dereference_level_cnts.size()-1);
+			formated_output(out, "max dereference level: ", dereference_level_cnts().size()-1);
 			out << "breakdown:" << endl;
-			for (i=0; i<dereference_level_cnts.size(); i++) {
-				out << "   level: " << i << ", occurrence: " << dereference_level_cnts[i] << endl;
+			for (i=0; i<dereference_level_cnts().size(); i++) {
+				out << "   level: " << i << ", occurrence: " << dereference_level_cnts()[i] << endl;
 			}
 		} 
 		formated_output(out, "number of pointers point to pointers: ", point_to_pointer);
@@ -339,9 +396,9 @@ Bookkeeper::record_address_taken(const Variable *var)
 	Variable *addrTakenVar = const_cast<Variable*>(var);
         addrTakenVar->isAddrTaken =  true;
 
-	Bookkeeper::address_taken_cnt++;
+	Bookkeeper::address_taken_cnt()++;
 	if (type->has_bitfields())
-		Bookkeeper::vars_with_bitfields_address_taken_cnt++;
+		Bookkeeper::vars_with_bitfields_address_taken_cnt()++;
 }
 
 void
@@ -352,9 +409,9 @@ Bookkeeper::record_bitfields_reads(const Variable *var)
 	const Type *type = var->type;
 
 	if (type->has_bitfields())
-		Bookkeeper::rhs_bitfields_structs_vars_cnt++;
+		Bookkeeper::rhs_bitfields_structs_vars_cnt()++;
 	if (var->isBitfield_)
-		Bookkeeper::rhs_bitfield_cnt++;
+		Bookkeeper::rhs_bitfield_cnt()++;
 }
 
 void
@@ -365,9 +422,9 @@ Bookkeeper::record_bitfields_writes(const Variable *var)
 	const Type *type = var->type;
 
 	if (type->has_bitfields())
-		Bookkeeper::lhs_bitfields_structs_vars_cnt++;
+		Bookkeeper::lhs_bitfields_structs_vars_cnt()++;
 	if (var->isBitfield_)
-		Bookkeeper::lhs_bitfield_cnt++;
+		Bookkeeper::lhs_bitfield_cnt()++;
 }
 
 /*
@@ -380,16 +437,16 @@ Bookkeeper::record_pointer_comparisons(const Expression* lhs, const Expression*
 		assert(lhs->get_type().eType == ePointer && rhs->get_type().eType == ePointer);
 		if ((lhs->term_type == eVariable && rhs->term_type == eConstant) ||
 			(rhs->term_type == eVariable && lhs->term_type == eConstant)) {
-			cmp_ptr_to_null++;
+			cmp_ptr_to_null()++;
 		}
 		else if (lhs->term_type==eVariable && rhs->term_type==eVariable) {
 			const ExpressionVariable* left = (ExpressionVariable*)lhs;
 			const ExpressionVariable* right = (ExpressionVariable*)rhs;
 			if (left->get_indirect_level() == right->get_indirect_level()) {
-				cmp_ptr_to_ptr++;
+				cmp_ptr_to_ptr()++;
 			}
 			else {
-				cmp_ptr_to_addr++;
+				cmp_ptr_to_addr()++;
 			}
 		}
 	}
@@ -408,23 +465,23 @@ Bookkeeper::record_volatile_access(const Variable* var, int deref_level, bool wr
 		if (write) {
 			if (var->qfer.is_volatile_after_deref(i)) {
 				if (i) {
-					Bookkeeper::write_volatile_thru_ptr_cnt++;
+					Bookkeeper::write_volatile_thru_ptr_cnt()++;
 				}
-				Bookkeeper::write_volatile_cnt++; 
+				Bookkeeper::write_volatile_cnt()++; 
 			}
 			else {
-				Bookkeeper::write_non_volatile_cnt++;
+				Bookkeeper::write_non_volatile_cnt()++;
 			}
 		}
 		else {
 			if (var->qfer.is_volatile_after_deref(i)) {
 				if (i) {
-					Bookkeeper::read_volatile_thru_ptr_cnt++;
+					Bookkeeper::read_volatile_thru_ptr_cnt()++;
 				}
-				Bookkeeper::read_volatile_cnt++;
+				Bookkeeper::read_volatile_cnt()++;
 			}
 			else {
-				Bookkeeper::read_non_volatile_cnt++;
+				Bookkeeper::read_non_volatile_cnt()++;
 			}
 		}
 	}
@@ -434,16 +491,16 @@ void
 Bookkeeper::output_volatile_access_statistics(std::ostream &out)
 {
 	// size_t i;
-	formated_output(out, "times a non-volatile is read: ", read_non_volatile_cnt);
-	formated_output(out, "times a non-volatile is write: ", write_non_volatile_cnt);
-	formated_output(out, "times a volatile is read: ", read_volatile_cnt);
-	formated_output(out, "   times read thru a pointer: ", read_volatile_thru_ptr_cnt);
-	formated_output(out, "times a volatile is write: ", write_volatile_cnt);
-	formated_output(out, "   times written thru a pointer: ", write_volatile_thru_ptr_cnt);
-	double percentage = (read_non_volatile_cnt + write_non_volatile_cnt) * 100.0 / 
-		                (read_non_volatile_cnt + write_non_volatile_cnt + read_volatile_cnt + write_volatile_cnt);
+	formated_output(out, "times a non-volatile is read: ", read_non_volatile_cnt());
+	formated_output(out, "times a non-volatile is write: ", write_non_volatile_cnt());
+	formated_output(out, "times a volatile is read: ", read_volatile_cnt());
+	formated_output(out, "   times read thru a pointer: ", read_volatile_thru_ptr_cnt());
+	formated_output(out, "times a volatile is write: ", write_volatile_cnt());
+	formated_output(out, "   times written thru a pointer: ", write_volatile_thru_ptr_cnt());
+	double percentage = (read_non_volatile_cnt() + write_non_volatile_cnt()) * 100.0 / 
+		                (read_non_volatile_cnt() + write_non_volatile_cnt() + read_volatile_cnt() + write_volatile_cnt());
 	
-	formated_outputf(out, "times a volatile is available for access: ", volatile_avail);
+	formated_outputf(out, "times a volatile is available for access: ", volatile_avail());
 	out.precision(3);
 	formated_outputf(out, "percentage of non-volatile access: ", percentage);
 }
@@ -454,17 +511,17 @@ Bookkeeper::output_bitfields(std::ostream &out)
 	if (CGOptions::bitfields()) {
 		out << std::endl;
 		//formated_output(out, "structs with full-bitfields: ", structs_with_bitfields);
-		formated_output(out, "non-zero bitfields defined in structs: ", bitfields_in_total);
-		formated_output(out, "zero bitfields defined in structs: ", unamed_bitfields_in_total);
-		formated_output(out, "const bitfields defined in structs: ", const_bitfields_in_total);
-		formated_output(out, "volatile bitfields defined in structs: ", volatile_bitfields_in_total);
-		Bookkeeper::output_counters(out, "structs with bitfields in the program: ", "indirect level", vars_with_bitfields);
-		Bookkeeper::output_counters(out, "full-bitfields structs in the program: ", "indirect level", vars_with_full_bitfields);
-		formated_output(out, "times a bitfields struct's address is taken: ", vars_with_bitfields_address_taken_cnt);
-		formated_output(out, "times a bitfields struct on LHS: ", lhs_bitfields_structs_vars_cnt);
-		formated_output(out, "times a bitfields struct on RHS: ", rhs_bitfields_structs_vars_cnt);
-		formated_output(out, "times a single bitfield on LHS: ", lhs_bitfield_cnt);
-		formated_output(out, "times a single bitfield on RHS: ", rhs_bitfield_cnt);
+		formated_output(out, "non-zero bitfields defined in structs: ", bitfields_in_total());
+		formated_output(out, "zero bitfields defined in structs: ", unamed_bitfields_in_total());
+		formated_output(out, "const bitfields defined in structs: ", const_bitfields_in_total());
+		formated_output(out, "volatile bitfields defined in structs: ", volatile_bitfields_in_total());
+		Bookkeeper::output_counters(out, "structs with bitfields in the program: ", "indirect level", vars_with_bitfields());
+		Bookkeeper::output_counters(out, "full-bitfields structs in the program: ", "indirect level", vars_with_full_bitfields());
+		formated_output(out, "times a bitfields struct's address is taken: ", vars_with_bitfields_address_taken_cnt());
+		formated_output(out, "times a bitfields struct on LHS: ", lhs_bitfields_structs_vars_cnt());
+		formated_output(out, "times a bitfields struct on RHS: ", rhs_bitfields_structs_vars_cnt());
+		formated_output(out, "times a single bitfield on LHS: ", lhs_bitfield_cnt());
+		formated_output(out, "times a single bitfield on RHS: ", rhs_bitfield_cnt());
 	}
 }
 
@@ -478,9 +535,9 @@ Bookkeeper::record_vars_with_bitfields(const Type *type)
 		return;
 
 	int level = type->get_indirect_level();
-	incr_counter(Bookkeeper::vars_with_bitfields, level);
+	incr_counter(Bookkeeper::vars_with_bitfields(), level);
 	if (type->is_full_bitfields_struct())
-		incr_counter(Bookkeeper::vars_with_full_bitfields, level);
+		incr_counter(Bookkeeper::vars_with_full_bitfields(), level);
 }
 
 void
@@ -489,22 +546,22 @@ Bookkeeper::record_type_with_bitfields(const Type *typ)
 	if (!typ->IsAggregate()) return;	
 
 	if (typ->has_bitfields()) {
-		Bookkeeper::structs_with_bitfields++;
+		Bookkeeper::structs_with_bitfields()++;
 		size_t len = typ->bitfields_length_.size();
 		assert(len == typ->fields.size());
 		for (size_t i = 0; i < len; ++i) {
 			if (!typ->is_bitfield(i)) 
 				continue;
 
-			Bookkeeper::bitfields_in_total++;
+			Bookkeeper::bitfields_in_total()++;
 			if (typ->bitfields_length_[i] == 0)
-				Bookkeeper::unamed_bitfields_in_total++;
+				Bookkeeper::unamed_bitfields_in_total()++;
 
 			TypeQualifiers qual = typ->qfers_[i];
 			if (qual.is_const())
-				Bookkeeper::const_bitfields_in_total++;
+				Bookkeeper::const_bitfields_in_total()++;
 			if (qual.is_volatile())
-				Bookkeeper::volatile_bitfields_in_total++;
+				Bookkeeper::volatile_bitfields_in_total()++;
 		}
 	}
 }
@@ -512,16 +569,16 @@ Bookkeeper::record_type_with_bitfields(const Type *typ)
 void
 Bookkeeper::output_jump_statistics(std::ostream &out)
 {
-	formated_output(out, "forward jumps: ", forward_jump_cnt);
-	formated_output(out, "backward jumps: ", backward_jump_cnt);
+	formated_output(out, "forward jumps: ", forward_jump_cnt());
+	formated_output(out, "backward jumps: ", backward_jump_cnt());
 }
 
 void
 Bookkeeper::output_var_freshness(std::ostream &out)
 {
-	int total = use_new_var_cnt + use_old_var_cnt;
-	formated_outputf(out, "percentage a fresh-made variable is used: ", use_new_var_cnt * 100.0 / total);
-	formated_outputf(out, "percentage an existing variable is used: ", use_old_var_cnt * 100.0 / total);
+	int total = use_new_var_cnt() + use_old_var_cnt();
+	formated_outputf(out, "percentage a fresh-made variable is used: ", use_new_var_cnt() * 100.0 / total);
+	formated_outputf(out, "percentage an existing variable is used: ", use_old_var_cnt() * 100.0 / total);
 }
 
 void
@@ -92,57 +92,57 @@ public:
 	static int  stat_blk_depths_for_stmt(const Statement* s); 
 	static int  stat_blk_depths(void);
 
-	static std::vector<int> struct_depth_cnts; 
+	static std::vector<int> &struct_depth_cnts(void); 
 
-	static int union_var_cnt; 
+	static int &union_var_cnt(void); 
 
-	static std::vector<int> expr_depth_cnts;
+	static std::vector<int> &expr_depth_cnts(void);
 
-	static std::vector<int> blk_depth_cnts;
+	static std::vector<int> &blk_depth_cnts(void);
 
-	static std::vector<int> dereference_level_cnts;
+	static std::vector<int> &dereference_level_cnts(void);
 
-	static int address_taken_cnt;
+	static int &address_taken_cnt(void);
 
-	static std::vector<int> write_dereference_cnts;
+	static std::vector<int> &write_dereference_cnts(void);
 
-	static std::vector<int> read_dereference_cnts;
+	static std::vector<int> &read_dereference_cnts(void);
 
-	static int cmp_ptr_to_null;
-	static int cmp_ptr_to_ptr;
-	static int cmp_ptr_to_addr;
+	static int &cmp_ptr_to_null(void);
+	static int &cmp_ptr_to_ptr(void);
+	static int &cmp_ptr_to_addr(void);
 
-	static int read_volatile_cnt;
-	static int read_volatile_thru_ptr_cnt;
-	static int write_volatile_cnt;
-	static int write_volatile_thru_ptr_cnt;
-	static int read_non_volatile_cnt;
-	static int write_non_volatile_cnt;
+	static int &read_volatile_cnt(void);
+	static int &read_volatile_thru_ptr_cnt(void);
+	static int &write_volatile_cnt(void);
+	static int &write_volatile_thru_ptr_cnt(void);
+	static int &read_non_volatile_cnt(void);
+	static int &write_non_volatile_cnt(void);
 
-	static int pointer_avail_for_dereference;
-	static int volatile_avail;
+	static int &pointer_avail_for_dereference(void);
+	static int &volatile_avail(void);
 
-	static int structs_with_bitfields;
-	static std::vector<int> vars_with_bitfields;
-	static std::vector<int> vars_with_full_bitfields;
-	static int vars_with_bitfields_address_taken_cnt;
-	static int bitfields_in_total;
-	static int unamed_bitfields_in_total;
-	static int const_bitfields_in_total;
-	static int volatile_bitfields_in_total;
-	static int lhs_bitfields_structs_vars_cnt;
-	static int rhs_bitfields_structs_vars_cnt;
-	static int lhs_bitfield_cnt;
-	static int rhs_bitfield_cnt;
+	static int &structs_with_bitfields(void);
+	static std::vector<int> &vars_with_bitfields(void);
+	static std::vector<int> &vars_with_full_bitfields(void);
+	static int &vars_with_bitfields_address_taken_cnt(void);
+	static int &bitfields_in_total(void);
+	static int &unamed_bitfields_in_total(void);
+	static int &const_bitfields_in_total(void);
+	static int &volatile_bitfields_in_total(void);
+	static int &lhs_bitfields_structs_vars_cnt(void);
+	static int &rhs_bitfields_structs_vars_cnt(void);
+	static int &lhs_bitfield_cnt(void);
+	static int &rhs_bitfield_cnt(void);
 
-	static int forward_jump_cnt;
-	static int backward_jump_cnt;
+	static int &forward_jump_cnt(void);
+	static int &backward_jump_cnt(void);
 
-	static int use_new_var_cnt;
-	static int use_old_var_cnt;
+	static int &use_new_var_cnt(void);
+	static int &use_old_var_cnt(void);
 
-	static bool rely_on_int_size;
-	static bool rely_on_ptr_size;
+	static bool &rely_on_int_size(void);
+	static bool &rely_on_ptr_size(void);
 };
 
 void incr_counter(std::vector<int>& counters, int index);
@@ -193,11 +193,103 @@ CFamilyOutputMgr::OutputBlock(const Block& b)
 		OutputBlockTmpVariables(b);
 
 	out << VarDefs2Str(b.local_vars);
+	if (CGOptions::emit_profile_counters() && (b.parent == NULL || b.looping))
+		out << ProfileCounter2Str(b);
 	OutputStatements(b.stms);
 	
 	out << ScopeCloser2Str();
 }
 
+// Count the runs of a function body or a loop body. A block keeps its
+// counter when it is rendered again, e.g. to be measured
+std::string
+CFamilyOutputMgr::ProfileCounter2Str(const Block& b)
+{
+	size_t index;
+	map<int, size_t>::const_iterator i = prof_counters_.find(b.stm_id);
+	if (i != prof_counters_.end()) {
+		index = i->second;
+	} else {
+		index = prof_entries_.size();
+		prof_counters_[b.stm_id] = index;
+		prof_entries_.push_back(StringUtils::int2str(index) + (b.parent == NULL ? " function " : " loop ") +
+								b.func->name + " " + StringUtils::int2str(b.stm_id));
+	}
+	return Tab2Str() + "__csmith_prof[" + StringUtils::int2str(index) + "]++;" + newline_;
+}
+
+// Output the table that maps the counters back to the program, which
+// csmith-profile reads, and the counters themselves. They are not
+// program variables, so they never reach the checksum
+void
+CFamilyOutputMgr::OutputProfileCounters(void)
+{
+	std::ostream& out = Out();
+	size_t n = prof_entries_.size();
+	out << newline_ << "/* --- PROFILE COUNTERS ---" << newline_;
+	out << " * counter kind function block" << newline_;
+	for (size_t i = 0; i < n; i++) {
+		out << " * " << prof_entries_[i] << newline_;
+	}
+	out << " */" << newline_;
+	out << "uint32_t __csmith_prof[" << (n ? n : 1) << "];" << newline_;
+	out << "const unsigned int __csmith_prof_n = " << n << ";" << newline_;
+	prof_counters_.clear();
+	prof_entries_.clear();
+}
+
+// "--checksum-trace": before a function returns, fold the integer
+// globals it may have written and its return value into the trace state,
+// then record the state with the function number. Volatiles are left
+// out, since reading them again is a visible access, and so are union
+// fields, whose bytes beyond the last written field are unspecified
+void
+CFamilyOutputMgr::AppendChecksumTrace(std::string &str, const StatementReturn& sr)
+{
+	const Function* f = sr.func;
+	const vector<const Variable*>& vars = f->feffect.get_write_vars();
+	for (size_t i = 0; i < vars.size(); i++) {
+		if (vars[i]->is_global()) {
+			AppendTraceValues(str, *vars[i]);
+		}
+	}
+
+	const ExpressionVariable& ev = *sr.get_var();
+	bool vol = false;
+	for (int level = 0; level <= ev.get_indirect_level(); level++) {
+		vol = vol || ev.get_var()->is_volatile_after_deref(level);
+	}
+	if (ev.get_type().is_int() && !vol) {
+		str += "csmith_trace_value(";
+		AppendExpression(str, ev);
+		str += ");" + newline_;
+		AppendTab(str, indent_);
+	}
+
+	// functions are named func_<n>, and the trace records <n>
+	str += "csmith_trace_exit(" + f->name.substr(f->name.find('_') + 1) + ");" + newline_;
+	AppendTab(str, indent_);
+}
+
+void
+CFamilyOutputMgr::AppendTraceValues(std::string &str, const Variable& v)
+{
+	if (v.isArray || v.is_array_field() || v.is_volatile() || v.type->eType == eUnion || v.is_inside_union_field()) {
+		return;
+	}
+	if (v.type->eType == eStruct) {
+		for (size_t i = 0; i < v.field_vars.size(); i++) {
+			AppendTraceValues(str, *v.field_vars[i]);
+		}
+	}
+	else if (v.type->is_int()) {
+		str += "csmith_trace_value(";
+		AppendVarRef(str, v);
+		str += ");" + newline_;
+		AppendTab(str, indent_);
+	}
+}
+
 void
 CFamilyOutputMgr::OutputBlockTmpVariables(const Block& b)
 {
@@ -261,6 +353,28 @@ CFamilyOutputMgr::ArrayLoopTail2Str(const ArrayVariable& av)
 	return str;
 }
 
+// Hash all the members of an array of integers with one runtime call. The
+// members are hashed in the same order, so the checksum does not change.
+// The pointer of a multi-dimensional array is derived from the whole array:
+// &g[0][0] would only cover the first row
+std::string
+CFamilyOutputMgr::ArrayBulkHash2Str(const ArrayVariable& av)
+{
+	string elem_type = Type2Str(*av.type);
+	string ptr;
+	int cnt = 1;
+	const vector<unsigned int>& sizes = av.get_sizes();
+	for (size_t i=0; i<sizes.size(); i++) {
+		cnt *= sizes[i];
+	}
+	if (sizes.size() > 1)
+		ptr = "(const " + elem_type + " *)(const void *)&" + av.get_actual_name();
+	else
+		ptr = "&" + av.get_actual_name() + "[0]";
+	return Tab2Str() + "transparent_crc_array_" + elem_type + "(" + ptr + ", " +
+		StringUtils::int2str(cnt) + ", \"" + av.name + "\", print_hash_value);" + newline_;
+}
+
 // Output a loop to initialize all array members to init 
 std::string
 CFamilyOutputMgr::ArrayInit2Str(const ArrayVariable& av, const Expression& init) 
@@ -284,30 +398,40 @@ CFamilyOutputMgr::ArrayInit2Str(const ArrayVariable& av, const Expression& init)
 	return str;
 } 
 
-std::string
-CFamilyOutputMgr::VarRef2Str(const Variable& v) 
+void
+CFamilyOutputMgr::AppendVarRef(std::string &str, const Variable& v) 
 { 
-	string str = v.get_actual_name();
+	bool wrap_volatile = v.is_volatile() && CGOptions::wrap_volatiles();
+	bool access_once = !wrap_volatile && CGOptions::access_once() && v.isAccessOnce && !v.isAddrTaken;
+	if (wrap_volatile) {
+		str += "VOL_RVAL(";
+	}
+	else if (access_once) {
+		str += "ACCESS_ONCE(";
+	}
+
+	str += v.get_actual_name();
 	if (v.isArray) {
 		const ArrayVariable& av = (const ArrayVariable&)v;
 		// for itemized array variables, output the modularized index
 		if (av.collective != 0) {  
 			assert(!av.get_indices().empty()); 
 			for (size_t i=0; i<av.get_indices().size(); i++) { 
-				str += "[" + Expression2Str(*av.get_indices()[i]) + "]"; 
+				str += "[";
+				AppendExpression(str, *av.get_indices()[i]);
+				str += "]"; 
 			}
 		}
 	}
 
-	if (v.is_volatile() && CGOptions::wrap_volatiles()) {
-		str = "VOL_RVAL(" + str +  ", " + Type2Str(*v.type) + ")"; 
-	} 
-	else if (CGOptions::access_once() && v.isAccessOnce && !v.isAddrTaken) {
-		assert(CGOptions::access_once() && "access_once is disabled!");
-		str = "ACCESS_ONCE(" + str + ")";
+	if (wrap_volatile) {
+		str += ", ";
+		str += Type2Str(*v.type);
+		str += ")";
+	}
+	else if (access_once) {
+		str += ")";
 	}
-
-	return str;
 }
 
 std::string
@@ -417,6 +541,10 @@ CFamilyOutputMgr::VarHash2Str(const Variable& v)
 	// for item collection in an array, generate a loop and hash the itemized array member.
 	if (v.isArray && ((const ArrayVariable&)v).collective == NULL) {
 		const ArrayVariable& av = (const ArrayVariable&)v;
+		if (CGOptions::bulk_array_hash() && CGOptions::compute_hash() &&
+			av.type->eType == eSimple && !av.is_volatile()) {
+			return ArrayBulkHash2Str(av);
+		}
 		ArrayVariable* arrayItem = NULL;
 		str += ArrayLoopHead2Str(av, arrayItem);
 		string itemHash = VarHash2Str(*arrayItem);
@@ -424,7 +552,7 @@ CFamilyOutputMgr::VarHash2Str(const Variable& v)
 		// If the item has nothing to hash, skip hashing the whole array 
 		if (itemHash.empty()) return "";
 
-		str += VarHash2Str(*arrayItem);
+		str += itemHash;
 		str += ArrayLoopTail2Str(*arrayItem); 
 		return str;
 	}
@@ -453,38 +581,62 @@ void
 CFamilyOutputMgr::OutputStatement(const Statement& s)
 {
 	std::ostream& out = Out();
-	out << Tab2Str();
+	std::string& str = line_;
+	str.clear();
+	AppendTab(str, indent_);
 
 	switch (s.get_type())
 	{
 		case eAssign:  
-			out << Assign2Str((const StatementAssign&)s) + ";";
+			AppendAssign(str, (const StatementAssign&)s);
+			str += ";";
 			break;
 		case eReturn: 	
-			out << "return " + Expression2Str(*((const StatementReturn&)s).get_var()) + ";"; 
+			if (CGOptions::checksum_trace())
+				AppendChecksumTrace(str, (const StatementReturn&)s);
+			str += "return ";
+			AppendExpression(str, *((const StatementReturn&)s).get_var());
+			str += ";"; 
 			break;
 		case eIfElse: {
 			const StatementIf& si = (const StatementIf&)s;
-			out << "if (" + Expression2Str(*si.get_test()) + ")" + newline_;  
+			str += "if (";
+			AppendExpression(str, *si.get_test());
+			str += ")" + newline_;  
+			Emit(str);
 			OutputBlock(*si.get_true_branch());  
-			out << Tab2Str() + "else" + newline_; 
+			// the blocks render their statements into line_ as well
+			str.clear();
+			AppendTab(str, indent_);
+			str += "else" + newline_; 
+			Emit(str);
 			OutputBlock(*si.get_false_branch());
+			str.clear();
 			break;
 		}
 		case eFor: {
 			const StatementFor& sf = (const StatementFor&)s; 
-			out << "for (" + Assign2Str(*sf.get_init()) + "; " + 
-				Expression2Str(*sf.get_test()) + "; " + Assign2Str(*sf.get_incr()) + ")" + newline_; 
+			str += "for (";
+			AppendAssign(str, *sf.get_init());
+			str += "; ";
+			AppendExpression(str, *sf.get_test());
+			str += "; ";
+			AppendAssign(str, *sf.get_incr());
+			str += ")" + newline_; 
+			Emit(str);
 			OutputBlock(*sf.get_body()); 
+			str.clear();
 			break;
 		}
 		case eArrayOp: {
 			const StatementArrayOp& sa = (const StatementArrayOp&)s;
+			Emit(str);
+			str.clear();
 			// output loop header
 			for (size_t i=0; i<sa.array_var->get_dimension(); i++) {
 				if (i > 0) 
 					out << ScopeOpener2Str();  
-				out << Tab2Str();
+				OutputTab();
 				out << "for (" + VarRef2Str(*sa.ctrl_vars[i]);
 				out << " = " << sa.inits[i] << "; ";
 				out << VarRef2Str(*sa.ctrl_vars[i]);
@@ -513,30 +665,42 @@ CFamilyOutputMgr::OutputStatement(const Statement& s)
 			for (size_t j=1; j<sa.array_var->get_dimension(); j++) {
 				out << ScopeCloser2Str();
 			} 
+			str.clear();
 			break;
 		} 
 		case eInvoke:  
-			out << Expression2Str(*((const StatementCall&)s).get_call()) + ";"; 
+			AppendExpression(str, *((const StatementCall&)s).get_call());
+			str += ";"; 
 			break;
 		case eGoto: {
 			const StatementGoto& sg = (const StatementGoto&)s; 
-			out << "if (" + Expression2Str(sg.test) + ")" + newline_ + Tab2Str(indent_+1); 
-			out << "goto " << sg.label << ";";  
+			str += "if (";
+			AppendExpression(str, sg.test);
+			str += ")" + newline_;
+			AppendTab(str, indent_+1); 
+			str += "goto " + sg.label + ";";  
 			break;
 		}
 		case eContinue: { 
 			const StatementContinue& sc = (const StatementContinue&)s; 
-			out << "if (" + Expression2Str(sc.test) + ")" + newline_ + Tab2Str(indent_+1); 
-			out << "continue;";  
+			str += "if (";
+			AppendExpression(str, sc.test);
+			str += ")" + newline_;
+			AppendTab(str, indent_+1); 
+			str += "continue;";  
 		}
 		case eBreak: { 
 			const StatementBreak& sb = (const StatementBreak&)s; 
-			out << "if (" + Expression2Str(sb.test) + ")" + newline_ + Tab2Str(indent_+1); 
-			out << "break;";  
+			str += "if (";
+			AppendExpression(str, sb.test);
+			str += ")" + newline_;
+			AppendTab(str, indent_+1); 
+			str += "break;";  
 		}
 			 
 	}
-	out << newline_;		
+	str += newline_;
+	Emit(str);
 }
 
 void
@@ -550,7 +714,7 @@ CFamilyOutputMgr::OutputStatements(const vector<Statement*> &stms)
 		vector<const StatementGoto*> gotos;
 		if (stm->find_jump_sources(gotos)) {
 			assert(gotos.size() > 0);
-			out << Tab2Str();
+			OutputTab();
 			out << gotos[0]->label << ":" << endl;   
 		}
  
@@ -566,33 +730,34 @@ CFamilyOutputMgr::OutputStatements(const vector<Statement*> &stms)
 
 // Output an assignment (including effective assignment such as ++/-- etc)
 // with NO consideration of of signed interger overflows 
-std::string
-CFamilyOutputMgr::SimpleAssign2Str(const StatementAssign& assign)  
+void
+CFamilyOutputMgr::AppendSimpleAssign(std::string &str, const StatementAssign& assign)  
 { 
-	string str;
 	eAssignOps op = assign.GetOp();
 	switch (op) {
 	default:
-		str += Expression2Str(*assign.get_lhs()) + " " + AssignOperator2Str(op) + " " + Expression2Str(*assign.get_expr());  
+		AppendExpression(str, *assign.get_lhs());
+		str += " " + AssignOperator2Str(op) + " ";
+		AppendExpression(str, *assign.get_expr());  
 		break; 
 	case ePreIncr:
 	case ePreDecr:
-		str += AssignOperator2Str(op) + Expression2Str(*assign.get_lhs());  
+		str += AssignOperator2Str(op);
+		AppendExpression(str, *assign.get_lhs());  
 		break; 
 	case ePostIncr:
 	case ePostDecr:
-		str += Expression2Str(*assign.get_lhs()) + AssignOperator2Str(op);
+		AppendExpression(str, *assign.get_lhs());
+		str += AssignOperator2Str(op);
 		break;
 	}
-	return str;
 } 
 
 // Output an assignment (including effective assignment such as ++/-- etc)
 // with avoidance consideration of of signed interger overflows 
-std::string
-CFamilyOutputMgr::Assign2Str(const StatementAssign& assign) 
+void
+CFamilyOutputMgr::AppendAssign(std::string &str, const StatementAssign& assign) 
 {
-	string str;
 	eAssignOps op = assign.GetOp();
 	// avoid signed int overflow for += and -=
 	if (CGOptions::avoid_signed_overflow() && assign.op_flags && (op == eAddAssign || op == eSubAssign) ) { 
@@ -602,29 +767,31 @@ CFamilyOutputMgr::Assign2Str(const StatementAssign& assign)
 		
 		// don't use safe math wrapper if this function is specified in "--safe-math-wrapper"
 		if (!CGOptions::safe_math_wrapper(id)) {
-			return SimpleAssign2Str(assign); 
+			AppendSimpleAssign(str, assign); 
+			return;
 		}
 
-		str += Expression2Str(*assign.get_lhs()) + " = " + fname + "(";
+		AppendExpression(str, *assign.get_lhs());
+		str += " = " + fname + "(";
 		if (CGOptions::math_notmp()) {
 			str += assign.tmp_var1 + ", ";
 		}
 
-		str += Expression2Str(*assign.get_lhs()) + ", "; 
+		AppendExpression(str, *assign.get_lhs());
+		str += ", "; 
 		if (CGOptions::math_notmp()) {
 			str += assign.tmp_var2 + ", ";
 		} 
 			
-		str += Expression2Str(*assign.get_expr());
+		AppendExpression(str, *assign.get_expr());
 		if (CGOptions::identify_wrappers()) {
 			str += ", " + id;
 		}
 		str += ")"; 
-		return str;
 	}
 	// Simply output the assignment without safe math wrapper 
 	else {
-		return SimpleAssign2Str(assign);
+		AppendSimpleAssign(str, assign);
 	}
 }  
  
@@ -644,7 +811,7 @@ CFamilyOutputMgr::FuncTitle2Str(const Function& f)
 
 	// output parameters
 	if (f.param.size() == 0) {
-		str += Type2Str(*Type::void_type); 
+		str += Type2Str(*Type::void_type()); 
 	} else {
 		for (size_t i=0; i<f.param.size(); i++) {  
 			if (i > 0) str += ", "; 
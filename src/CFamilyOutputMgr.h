@@ -44,12 +44,14 @@
 #include <string>
 #include <ostream>
 #include <fstream>
+#include <map>
 #include "AbsOutputMgr.h"
 #include "Variable.h"
 
 using namespace std;
 
 class StatementAssign;
+class StatementReturn;
 class Fact; 
 class FactPointTo; 
 
@@ -76,7 +78,7 @@ public:
 	virtual std::string FuncTitle2Str(const Function& f); 
 
 	// Variable output functions
-	virtual std::string VarRef2Str(const Variable& v);  
+	virtual void AppendVarRef(std::string &str, const Variable& v);
 	virtual std::string VarDecl2Str(const Variable& v);
 	virtual std::string VarDecls2Str(const vector <const Variable*> &vars);
 	virtual std::string VarDef2Str(const Variable& v);
@@ -93,7 +95,7 @@ public:
 	/// See AbsOutputMgr.h for the purpose of these functions
 	/// See DefaultCOutputMgr.cpp for examplar implementation of them
 	///
-	virtual std::string Expression2Str(const Expression& e) = 0; 
+	virtual void AppendExpression(std::string &str, const Expression& e) = 0;
 	virtual void OutputStmtAssertions(const Statement* stm, bool forFactsOut) = 0;
 	virtual std::string QualifiedType2Str(const Type& t, const TypeQualifiers* qfer) = 0; 
 	virtual std::string FirstQualifiers2Str(const TypeQualifiers& qfer) = 0; 
@@ -101,10 +103,12 @@ public:
 	virtual void OutputUserDefinedType(const Type& t) = 0; 
 	virtual std::string FactPointsTo2Str(const FactPointTo& fp) = 0; 
 	virtual std::string ArrayInits2Str(const ArrayVariable& av, const vector<const Expression*>& inits) = 0;
-	virtual std::string FunctionInvocation2Str(const FunctionInvocation* fi) = 0;   
+	virtual void AppendFunctionInvocation(std::string &str, const FunctionInvocation* fi) = 0;
 	virtual void OutputProgram() = 0;  
 	virtual void OutputMain() = 0; 
 
+	std::string FunctionInvocation2Str(const FunctionInvocation* fi) { string str; AppendFunctionInvocation(str, fi); return str; }
+
 protected:  
 	 
 	/// 
@@ -113,13 +117,27 @@ protected:
 	///
 	void OutputBlockTmpVariables(const Block& b);  
 	void OutputPtrResets(const vector<const Variable*>& ptrs);  
-	std::string SimpleAssign2Str(const StatementAssign& assign);  
-	std::string Assign2Str(const StatementAssign& assign);     
+	void AppendSimpleAssign(std::string &str, const StatementAssign& assign);
+	void AppendAssign(std::string &str, const StatementAssign& assign);
 	std::string ArrayLoopHead2Str(const ArrayVariable& av, ArrayVariable*& itemizedAV); 
 	std::string ArrayLoopTail2Str(const ArrayVariable& av); 
 	std::string ArrayInit2Str(const ArrayVariable& av, const Expression& init);   
+	std::string ArrayBulkHash2Str(const ArrayVariable& av);
 	std::string VarValueDump2Str(const Variable& v, string dumpPrefix); 
 	void OutputForwardDeclarations(const vector<const Function*>& funcList); 
+	std::string ProfileCounter2Str(const Block& b);
+	void OutputProfileCounters(void);
+	void AppendChecksumTrace(std::string &str, const StatementReturn& sr);
+	void AppendTraceValues(std::string &str, const Variable& v);
+
+	// A statement is rendered into this string and then emitted, so its
+	// capacity is reused from one statement to the next
+	std::string line_;
+
+	// "--emit-profile-counters": the counter of each function or loop body,
+	// by block id, and the description of each counter for csmith-profile
+	std::map<int, size_t> prof_counters_;
+	std::vector<std::string> prof_entries_;
 
 private:
 };
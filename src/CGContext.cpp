@@ -255,7 +255,7 @@ bool CGContext::read_pointed(const ExpressionVariable* v, const std::vector<cons
 	Effect effect_accum_copy = *effect_accum;
 	int indirect = v->get_indirect_level(); 
 	assert(indirect > 0);
-	incr_counter(Bookkeeper::dereference_level_cnts, indirect);
+	incr_counter(Bookkeeper::dereference_level_cnts(), indirect);
 
 	bool allow_null_ptr = CGOptions::null_pointer_dereference_prob() > 0;
 	bool allow_dead_ptr = CGOptions::dead_pointer_dereference_prob() > 0;
@@ -294,7 +294,7 @@ bool CGContext::write_pointed(const Lhs* v, const std::vector<const Fact*>& fact
 	Effect effect_accum_copy = *effect_accum;
 	int indirect = v->get_indirect_level(); 
 	assert(indirect > 0);
-	incr_counter(Bookkeeper::dereference_level_cnts, indirect);
+	incr_counter(Bookkeeper::dereference_level_cnts(), indirect);
 	//vector<const Variable*> tmp = FactPointTo::merge_pointees_of_pointer(v->get_var(), indirect, facts);
 	if (!read_indices(v->get_var(), facts)) {
 		return false;
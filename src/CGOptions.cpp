@@ -31,6 +31,7 @@
 
 #include "CGOptions.h"
 #include <iostream>
+#include <fstream>
 #include <assert.h>
 #include <string.h>
 #include <map>
@@ -144,6 +145,21 @@ DEFINE_GETTER_SETTER_BOOL(blind_check_global)
 DEFINE_GETTER_SETTER_BOOL(no_return_dead_ptr)
 DEFINE_GETTER_SETTER_BOOL(hash_value_printf)
 DEFINE_GETTER_SETTER_BOOL(signed_char_index)
+DEFINE_GETTER_SETTER_STRING_REF(profile_file)
+DEFINE_GETTER_SETTER_INT(max_memory)
+DEFINE_GETTER_SETTER_BOOL(memory_stats)
+DEFINE_GETTER_SETTER_INT(target_size)
+DEFINE_GETTER_SETTER_INT(min_size)
+DEFINE_GETTER_SETTER_INT(max_size)
+DEFINE_GETTER_SETTER_INT(time_budget)
+DEFINE_GETTER_SETTER_INT(stmt_budget)
+DEFINE_GETTER_SETTER_STRING_REF(checksum_algo)
+DEFINE_GETTER_SETTER_BOOL(bulk_array_hash)
+DEFINE_GETTER_SETTER_BOOL(prune_safe_math)
+DEFINE_GETTER_SETTER_BOOL(runtime_lib)
+DEFINE_GETTER_SETTER_INT(max_exec_cost)
+DEFINE_GETTER_SETTER_BOOL(emit_profile_counters)
+DEFINE_GETTER_SETTER_BOOL(checksum_trace)
 DEFINE_GETTER_SETTER_INT (max_array_num_in_loop)
 DEFINE_GETTER_SETTER_BOOL(identify_wrappers)
 DEFINE_GETTER_SETTER_BOOL(mark_mutable_const)
@@ -172,10 +188,11 @@ CGOptions::set_default_builtin_kinds()
 	enabled_builtin_kinds_["x86"] = true;
 }
 
-void
-CGOptions::set_default_settings(void)
+bool
+CGOptions::set_default_settings(bool library)
 {
-	set_platform_specific_options();
+	if (!set_platform_specific_options(library))
+		return false;
 	compute_hash(true);
 	max_funcs(CGOPTIONS_DEFAULT_MAX_FUNCS);
 	max_params(CGOPTIONS_DEFAULT_MAX_PARAMS);
@@ -233,6 +250,21 @@ CGOptions::set_default_settings(void)
 	no_return_dead_ptr(true);
 	hash_value_printf(true);
 	signed_char_index(true);
+	profile_file("");
+	max_memory(0);
+	memory_stats(false);
+	target_size(0);
+	min_size(0);
+	max_size(0);
+	time_budget(0);
+	stmt_budget(0);
+	checksum_algo("crc32");
+	bulk_array_hash(false);
+	prune_safe_math(false);
+	runtime_lib(false);
+	max_exec_cost(0);
+	emit_profile_counters(false);
+	checksum_trace(false);
 	identify_wrappers(false);
 	mark_mutable_const(false);
 	force_globals_static(true);
@@ -256,29 +288,34 @@ CGOptions::set_default_settings(void)
 	lang_cpp(false);
 
 	set_default_builtin_kinds();
+	return true;
 }
 	
 /*
    looking for the platform info file in the working directory
    and load platform specific information. If not found, use
    info from the platform that Csmith is running, and output them
-   to the file
+   to the file (except in library mode)
 */
-void
-CGOptions::set_platform_specific_options(void) 
+bool
+CGOptions::set_platform_specific_options(bool library) 
 {
 	const char* int_str = "integer size = ";
 	const char* ptr_str = "pointer size = ";
 	ifstream conf(PLATFORM_CONFIG_FILE);
 	if (conf.fail()) {
-		ofstream conf(PLATFORM_CONFIG_FILE);
-		conf << int_str << sizeof(int) << endl;
-		conf << ptr_str << sizeof(int*) << endl;
+		if (!library) {
+			ofstream conf(PLATFORM_CONFIG_FILE);
+			conf << int_str << sizeof(int) << endl;
+			conf << ptr_str << sizeof(int*) << endl;
+			conf.close();
+		}
 		int_size(sizeof(int));
 		pointer_size(sizeof(int*));
-		conf.close();
 	}
 	else {
+		int_size_ = 0;
+		pointer_size_ = 0;
 		string line;
 		while(!conf.eof()) {
 			getline(conf, line);
@@ -293,6 +330,8 @@ CGOptions::set_platform_specific_options(void)
 				pointer_size(StringUtils::str2int(s));
 			} 
 		}
+		if (library && (!int_size_ || !pointer_size_))
+			return false;
 		if (!int_size_) {
 			cout << "please specify integer size in " << PLATFORM_CONFIG_FILE << endl;
 			exit(-1);
@@ -303,12 +342,13 @@ CGOptions::set_platform_specific_options(void)
 		}
 		conf.close();
 	}  
+	return true;
 }
 
 int 
 CGOptions::int_size(void) 
 {
-	Bookkeeper::rely_on_int_size = true;
+	Bookkeeper::rely_on_int_size() = true;
 	return int_size_;
 } 
 
@@ -358,19 +398,49 @@ CGOptions::has_conflict(void)
 		return true;
 	}   
 
+	if ((CGOptions::min_size() && CGOptions::target_size() && CGOptions::min_size() > CGOptions::target_size()) ||
+	    (CGOptions::max_size() && CGOptions::target_size() && CGOptions::max_size() < CGOptions::target_size()) ||
+	    (CGOptions::min_size() && CGOptions::max_size() && CGOptions::min_size() > CGOptions::max_size())) {
+		conflict_msg_ = "the sizes must satisfy min-size <= target-size <= max-size";
+		return true;
+	}
+
+	// libcsmith_rt.a has the safe math functions only, without logging, and
+	// its checksum is chosen when it is built
+	if (CGOptions::runtime_lib()) {
+		if (CGOptions::math_notmp() || CGOptions::identify_wrappers() || CGOptions::prune_safe_math() ||
+			CGOptions::emit_profile_counters() || CGOptions::checksum_trace()) {
+			conflict_msg_ = "--runtime-lib cannot be used with --math-notmp, --identify-wrappers, --prune-safe-math, "
+				"--emit-profile-counters or --checksum-trace";
+			return true;
+		}
+		if (CGOptions::checksum_algo() != "crc32") {
+			conflict_msg_ = "--runtime-lib uses the checksum libcsmith_rt.a was built with; omit --checksum-algo";
+			return true;
+		}
+		// the installed library checksums 64-bit values; a program that
+		// declares transparent_crc(uint32_t) would call it wrongly
+		if (!CGOptions::longlong()) {
+			conflict_msg_ = "--runtime-lib cannot be used with --no-longlong";
+			return true;
+		}
+	}
+
 #if 0
 	Probabilities *prob = Probabilities::GetInstance();
 	if (!(CGOptions::dump_default_probabilities().empty()))
 		prob->dump_default_probabilities(CGOptions::dump_default_probabilities());
+#endif
 
-	string msg;
+	// the file is applied by Probabilities::GetInstance() in every
+	// generation; only check here that it can be read
 	if (!(CGOptions::probability_configuration().empty())) {
-		if (!prob->parse_configuration(msg, CGOptions::probability_configuration())) {
-			conflict_msg_ = msg;
+		ifstream conf(CGOptions::probability_configuration().c_str());
+		if (!conf.is_open()) {
+			conflict_msg_ = "fail to open probabilities configuration file!";
 			return true;
 		}
 	}
-#endif
 
 	return false;
 }
@@ -277,8 +277,55 @@ public:
 	static bool signed_char_index(void);
 	static bool signed_char_index(bool p);
 
+	static std::string profile_file(void);
+	static std::string profile_file(std::string p);
+
+	static int max_memory(void);
+	static int max_memory(int p);
+
+	static bool memory_stats(void);
+	static bool memory_stats(bool p);
+
+	static int target_size(void);
+	static int target_size(int p);
+
+	static int min_size(void);
+	static int min_size(int p);
+
+	static int max_size(void);
+	static int max_size(int p);
+
+	static int time_budget(void);
+	static int time_budget(int p);
+
+	static int stmt_budget(void);
+	static int stmt_budget(int p);
+
+	static std::string checksum_algo(void);
+	static std::string checksum_algo(std::string p);
+
+	static bool bulk_array_hash(void);
+	static bool bulk_array_hash(bool p);
+
+	static bool prune_safe_math(void);
+	static bool prune_safe_math(bool p);
+
+	static bool runtime_lib(void);
+	static bool runtime_lib(bool p);
+
+	static int max_exec_cost(void);
+	static int max_exec_cost(int p);
+
+	static bool emit_profile_counters(void);
+	static bool emit_profile_counters(bool p);
+
+	static bool checksum_trace(void);
+	static bool checksum_trace(bool p);
+
 	/////////////////////////////////////////////////////////
-	static void set_default_settings(void);
+	// in library mode, platform.info is read but never written, and a bad
+	// one is reported by returning false instead of exiting
+	static bool set_default_settings(bool library = false);
 
 	static bool has_conflict(void);
 	static const std::string& conflict_msg(void);
@@ -358,7 +405,7 @@ public:
 	static int pointer_size(void);
 	static void pointer_size(int p) { pointer_size_ = p;}
 
-	static void set_platform_specific_options(void);
+	static bool set_platform_specific_options(bool library);
 
 	static bool lang_cpp(void);
 	static bool lang_cpp(bool p);
@@ -447,6 +494,21 @@ private:
 	static bool no_return_dead_ptr_;
 	static bool hash_value_printf_;
 	static bool signed_char_index_;
+	static std::string	profile_file_;
+	static int	max_memory_;
+	static bool	memory_stats_;
+	static int	target_size_;
+	static int	min_size_;
+	static int	max_size_;
+	static int	time_budget_;
+	static int	stmt_budget_;
+	static std::string	checksum_algo_;
+	static bool	bulk_array_hash_;
+	static bool	prune_safe_math_;
+	static bool	runtime_lib_;
+	static int	max_exec_cost_;
+	static bool	emit_profile_counters_;
+	static bool	checksum_trace_;
 	static std::string	dump_default_probabilities_;
 	static std::string	dump_random_probabilities_;
 	static std::string	probability_configuration_;
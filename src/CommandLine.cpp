@@ -0,0 +1,1400 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifdef WIN32 
+#pragma warning(disable : 4786)   /* Disable annoying warning messages */
+#endif
+
+#include "CommandLine.h"
+
+#include <ostream>
+#include <cstring>
+#include <cstdio>
+#include <string>
+
+#include "Common.h"
+#include "CGOptions.h"
+#include "MemoryAccounting.h"
+#include "platform.h"
+
+using namespace std;
+
+// ----------------------------------------------------------------------------
+static void
+print_version(ostream &out)
+{
+	out << PACKAGE_STRING << endl;
+#ifdef GIT_VERSION
+	out << "Git version: " << GIT_VERSION << endl;
+#endif
+	// XXX print copyright, contact info, etc.?
+}
+
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+static bool
+parse_string_arg(const char *arg, string &s)
+{
+	s.assign(arg);
+	return ((!s.empty()) && 
+		(s.compare(0, 2, "--")));
+}
+
+static bool
+parse_int_arg(char *arg, unsigned long *ret, ostream &out)
+{
+	int res;
+	res = sscanf (arg, "%lu", ret);
+	
+	if (res == 0) {
+		out << "expected integer at arg position " << endl;
+		return false;
+	}
+	return true;
+}
+
+static void print_help(ostream &out)
+{
+	out << "Command line options: " << endl << endl; 
+	// most common options
+	out << "  --help or -h: print this information." << endl << endl; 
+	out << "  -hh: describe extra options probably useful only for Csmith developers." << endl << endl; 
+	out << "  --version or -v: print the version of Csmith." << endl << endl; 
+	out << "  --seed <seed> or -s <seed>: use <seed> instead of a random seed generated by Csmith." << endl << endl;
+	out << "  --output <filename> or -o <filename>: specify the output file name." << endl << endl;
+	out << "  --count <num>: generate <num> programs with consecutive seeds, starting from the given or a random seed; "
+		 << "requires an output file name containing %s, which is replaced by the seed of each program." << endl << endl;
+	out << "  --seed-range <from>:<to>: generate one program for every seed from <from> to <to>; "
+		 << "requires an output file name containing %s, like --count." << endl << endl;
+	out << "  --archive <name>: with --count or --seed-range, append the programs to the archive <name> "
+		 << "(and its index <name>.idx) instead of writing one file per program; see csmith-archive." << endl << endl;
+	out << "  --jobs <num>: with --count or --seed-range, generate the programs on <num> threads (default 1); "
+		 << "the programs are the same as those generated one at a time." << endl << endl;
+	out << "  --serve: stay up and generate a program for every request read from stdin, "
+		 << "writing the programs to stdout (see GeneratorServer.h for the protocol)." << endl << endl;
+	out << "  --serve-socket <path>: like --serve, but take requests on the Unix-domain socket <path>." << endl << endl;
+	out << "  --fork-server: with --serve or --serve-socket, generate every program in a fork()ed copy of the "
+		 << "server, so that a crash or leftover state only affects that program. This isolates the requests; "
+		 << "it is slower than serving them in-process." << endl << endl;
+
+	// enabling/disabling options
+	out << "  --argc | --no-argc: genereate main function with/without argv and argc being passed (enabled by default)." << endl << endl; 
+	out << "  --arrays | --no-arrays: enable | disable arrays (enabled by default)." << endl << endl;
+	out << "  --bitfields | --no-bitfields: enable | disable full-bitfields structs (disabled by default)." << endl << endl;
+	out << "  --checksum | --no-checksum: enable | disable checksum calculation (enabled by default)." << endl << endl;
+	out << "  --comma-operators | --no-comma-operators: enable | disable comma operators (enabled by default)." << endl << endl;
+	out << "  --compound-assignment | --no-compound-assignment: enable | disable compound assignments (enabled by default)." << endl << endl; 
+	out << "  --concise: generated programs with minimal comments (disabled by default)." << endl << endl;
+	out << "  --consts | --no-consts: enable | disable const qualifier (enabled by default)." << endl << endl;
+	out << "  --divs | --no-divs: enable | disable divisions (enabled by default)." << endl << endl;
+	out << "  --embedded-assigns | --no-embedded-assigns: enable | disable embedded assignments as sub-expressions (enabled by default)." << endl << endl;
+	out << "  --pre-incr-operator | --no-pre-incr-operator: enable | disable pre ++ operator (enabled by default)." << endl << endl;
+	out << "  --pre-decr-operator | --no-pre-decr-operator: enable | disable pre -- operator (enabled by default)." << endl << endl;
+	out << "  --post-incr-operator | --no-post-incr-operator: enable | disable post ++ operator (enabled by default)." << endl << endl;
+	out << "  --post-decr-operator | --no-post-decr-operator: enable | disable post -- operator (enabled by default)." << endl << endl;
+	out << "  --unary-plus-operator | --no-unary-plus-operator: enable | disable + operator (enabled by default)." << endl << endl;
+	out << "  --jumps | --no-jumps: enable | disable jumps (enabled by default)." << endl << endl;
+	out << "  --longlong| --no-longlong: enable | disable long long (enabled by default)." << endl << endl;
+	out << "  --int8 | --no-int8: enable | disable int8_t (enabled by default)." << endl << endl;
+	out << "  --uint8 | --no-uint8: enable | disable uint8_t (enabled by default)." << endl << endl;
+	out << "  --main | --nomain: enable | disable to generate main function (enabled by default)." << endl <<  endl;  
+	out << "  --math64 | --no-math64: enable | disable 64-bit math ops (enabled by default)." << endl << endl;
+	out << "  --inline-function | --no-inline-function: enable | disable inline attributes on generated functions." << endl << endl;
+	out << "  --inline-function-prob <num>: set the probability of each function being marked as inline (default is 50)." << endl << endl;
+
+	// numbered controls	
+	out << "  --max-array-dim <num>: limit array dimensions to <num>. (default 3)" << endl << endl;
+	out << "  --max-array-len-per-dim <num>: limit array length per dimension to <num> (default 10)." << endl << endl;
+	out << "  --max-block-depth <num>: limit depth of nested blocks to <num> (default 5)." << endl << endl;
+	out << "  --max-block-size <size>: limit the number of non-return statements in a block to <size> (default 4)." << endl << endl; 
+	out << "  --max-expr-complexity <num>: limit expression complexities to <num> (default 10)." << endl << endl;
+	out << "  --max-funcs <num>: limit the number of functions (besides main) to <num>  (default 10)." << endl << endl;
+	out << "  --max-pointer-depth <depth>: limit the indirect depth of pointers to <depth> (default 2)." << endl << endl;
+	out << "  --max-struct-fields <num>: limit the number of struct fields to <num> (default 10). " << endl << endl;
+	out << "  --max-union-fields <num>: limit the number of union fields to <num> (default 5). " << endl << endl;
+
+	out << "  --muls | --no-muls: enable | disable multiplications (enabled by default)." << endl << endl;
+	out << "  --safe-math | --no-safe-math: Emit safe math wrapper functions (enabled by default)." << endl << endl;
+	out << "  --packed-struct | --no-packed-struct: enable | disable packed structs by adding #pragma pack(1) before struct definition (disabled by default)." << endl << endl; 
+	out << "  --paranoid | --no-paranoid: enable | disable pointer-related assertions (disabled by default)." << endl << endl; 
+	out << "  --pointers | --no-pointers: enable | disable pointers (enabled by default)." << endl << endl;
+	out << "  --quiet: generate programs with less comments (disabled by default)." << endl << endl; 
+	out << "  --structs | --no-structs: enable | disable to generate structs (enable by default)." << endl << endl;
+	out << "  --unions | --no-unions: enable | disable to generate unions (enable by default)." << endl << endl;
+	out << "  --volatiles | --no-volatiles: enable | disable volatiles (enabled by default)." << endl << endl;
+	out << "  --volatile-pointers | --no-volatile-pointers: enable | disable volatile pointers (enabled by default)." << endl << endl;
+	out << "  --const-pointers | --no-const-pointers: enable | disable const pointers (enabled by default)." << endl << endl;
+
+	out << "  --builtins | --no-builtins: enable | disable to generate builtin functions (disabled by default)." << endl << endl;
+	out << "  --enable-builtin-kinds k1,k2 | --disable-builtin-kinds k1,k2: enable | disable certain kinds of builtin functions." << endl << endl;
+	out << "  --builtin-function-prob <num>: set the probability of choosing a builtin function (default is 20)." << endl << endl;
+
+        // language options
+	out << "  --lang-cpp : generate C++ code (C by default)." << endl << endl;
+
+}
+
+static void print_advanced_help(ostream &out)
+{
+	out << "'Advanced' command line options that are probably only useful for Csmith's" << endl;
+	out << "original developers:" << endl << endl;   
+
+	out << "  --max-nested-struct-level <num>: limit maximum nested level of structs to <num>(default 3). " << endl << endl; 
+
+	out << "  --compatible-check: disallow trivial code such as i = i in random programs. " << endl << endl;   
+	 
+	// struct/union related options
+	out << "  --fixed-struct-fields: fix the size of struct fields to max-struct-fields (default 10)." << endl << endl; 
+	out << "  --return-structs | --no-return-structs: enable | disable return structs from a function (enabled by default)." << endl << endl; 
+	out << "  --arg-structs | --no-arg-structs: enable | disable structs being used as args (enabled by default)." << endl << endl; 
+	out << "  --return-unions | --no-return-unions: enable | disable return unions from a function (enabled by default)." << endl << endl; 
+	out << "  --arg-unions | --no-arg-unions: enable | disable unions being used as args (enabled by default)." << endl << endl; 
+	out << "  --take-union-field-addr | --take-no-union-field-addr: allow | disallow addresses of union fields to be taken (allowed by default)." << endl << endl; 
+	out << "  --vol-struct-union-fields | --no-vol-struct-union-fields: enable | disable volatile struct/union fields (enabled by default)" << endl << endl;
+	 
+	// probability options
+	out << "  --dump-default-probabilities <file>: dump the default probability settings into <file>" << endl << endl;
+	out << "  --dump-random-probabilities <file>: dump the randomized probabilities into <file>" << endl << endl;
+	out << "  --probability-configuration <file>: use probability configuration <file>" << endl << endl;
+	out << "  --random-random: enable random probabilities." << endl << endl;
+
+	// volatile checking options
+	out << "  --enable-access-once: enable testing access once macro." << endl << endl;
+	out << "  --strict-volatile-rule: make sure only one volatile access between any pair of sequence points. " << endl << endl;
+
+	out << "  --addr-taken-of-locals: enable addr-taken of local vars. [default]" << endl << endl;
+	out << "  --no-addr-taken-of-locals: disable addr-taken of local vars. " << endl << endl;
+
+	out << "  --fresh-array-ctrl-var-names: create fresh names [i1,i2,i3...] for array control vars rather than use unique names such as i, j, k." << endl << endl;
+
+	// other options
+	out << "  --math-notmp: make csmith generate code for safe_math_macros_notmp." << endl << endl;
+	 
+	out << "  --strict-const-arrays: restrict array elements to constants." << endl << endl;
+	
+	out << "  --partial-expand <assignment[,for[,block[,if-else[,invoke[,return]]]]]: ";
+	out <<"partial-expand controls which what kind of statements should be generated first. ";
+	out <<"For example, it could make Csmith start to generate if-else without go over assignment or for." << endl << endl;
+
+	out << "  --dangling-global-pointers | --no-dangling-global-pointers: enable | disable to reset all dangling global pointers to null at the end of main. (enabled by default)" << endl << endl;
+
+	out << "  --check-global: print the values of all integer global variables." << endl << endl;
+
+	out << "  --stop-by-stmt <num>: try to stop generating statements after the statement with id <num>." << endl << endl;
+	
+	out << "  --const-as-condition: enable const to be conditions of if-statements. " << endl << endl;
+
+	out << "  --match-exact-qualifiers: match exact const/volatile qualifiers for LHS and RHS of assignments." << endl << endl; 
+
+	out << "  --return-dead-pointer | --no-return-dead-pointer: allow | disallow functions from returning dangling pointers (disallowed by default)." << endl << endl;
+
+	out <<	"  --identify-wrappers: assign ids to used safe math wrappers." << endl << endl;
+		 
+	out << "  --safe-math-wrappers <id1,id2...>: specifiy ids of wrapper functions that are necessary to avoid undefined behaviors, use 0 to specify none." << endl << endl;
+				
+	out << "  --mark-mutable-const: mark constants that can be mutated with parentheses (disabled by default)." << endl << endl; 
+
+	out << "  --force-non-uniform-arrays | --no-force-non-uniform-arrays: force integer arrays to be initialized with multiple values (enabled by default)." << endl << endl; 
+ 
+	out << "  --null-ptr-deref-prob <N>: allow null pointers to be dereferenced with probability N% (0 by default)." << endl << endl;
+
+	out << "  --dangling-ptr-deref-prob <N>: allow dangling pointers to be dereferenced with probability N% (0 by default)." << endl << endl; 
+
+	out << "  --union-read-type-sensitive | --no-union-read-type-sensitive: allow | disallow reading an union field when there is no risk of "
+		 << "reading padding bits (enabled by default)." << endl << endl; 
+	 
+	out << "  --no-hash-value-printf: do not emit printf on the index of an array" << endl << endl;
+	out << "  --no-signed-char-index: do not allow a var of type char to be used as array index" << endl << endl;
+
+	out << "  --profile <file>: record the time spent in each generation phase into <file>, as folded stacks for flamegraph.pl, or as JSON if <file> ends with .json." << endl << endl;
+
+	out << "  --max-memory <MB>: stop growing the program once the generator's heap exceeds <MB> megabytes; "
+		 << "the functions being generated are finished and main is emitted as usual (no limit by default)." << endl << endl;
+
+	out << "  --memory-stats: add the heap allocations of each generator subsystem to the statistics." << endl << endl;
+
+	out << "  --target-size <bytes>: steer the generation towards a program of about <bytes> bytes; "
+		 << "the program stops growing once its estimated size reaches the target. "
+		 << "The size options are best-effort hints: the program can still end up outside the window." << endl << endl;
+
+	out << "  --min-size <bytes>: keep growing the program while its estimated size is below <bytes> "
+		 << "(half the target size by default)." << endl << endl;
+
+	out << "  --max-size <bytes>: stop growing the program well before its estimated size reaches <bytes> "
+		 << "(twice the target size by default)." << endl << endl;
+
+	out << "  --time-budget <ms>: once generating the program has taken <ms> milliseconds, stop growing it "
+		 << "and finish a valid program right away (no limit by default). The program then notes the "
+		 << "--stmt-budget that regenerates it." << endl << endl;
+
+	out << "  --stmt-budget <num>: likewise, once <num> statements have been generated (no limit by default)." << endl << endl;
+
+	out << "  --checksum-algo <crc32|crc32-slice8|word>: how the program checksums its globals: a CRC-32 computed "
+		 << "one byte at a time (default), the same CRC-32 computed eight bytes at a time, or a faster "
+		 << "word-at-a-time hash whose checksums differ from the CRC ones." << endl << endl;
+
+	out << "  --bulk-array-hash: hash each global array of integers with one runtime call instead of "
+		 << "a loop over its members in main; the checksum is the same." << endl << endl;
+
+	out << "  --prune-safe-math: make the runtime define only the safe math wrapper functions the program calls, "
+		 << "instead of all of them; the runtime is then included after the program is generated." << endl << endl;
+
+	out << "  --runtime-lib: include the declarations-only csmith_rt.h instead of csmith.h; the program must be "
+		 << "linked with libcsmith_rt.a, and the header can be precompiled (not with --no-longlong)." << endl << endl;
+
+	out << "  --max-exec-cost <num>: keep the statically estimated number of statements the program executes "
+		 << "below <num>, by shrinking loop bounds and leaving out loops and calls where they would run too "
+		 << "often (no limit by default)." << endl << endl;
+
+	out << "  --emit-profile-counters: count the runs of every function and loop body in a global array, "
+		 << "which the program writes to the file named by $CSMITH_PROFILE (csmith.prof by default) when it "
+		 << "ends; csmith-profile reports them. The counters are not part of the checksum." << endl << endl;
+
+	out << "  --checksum-trace: at every function exit, fold the integer globals the function writes and its "
+		 << "return value into a running hash, and record it with the function; the program writes the records "
+		 << "to the file named by $CSMITH_TRACE (csmith.trace by default). Comparing the traces of two builds "
+		 << "names the first function whose results differ. The trace is not part of the checksum." << endl << endl;
+}
+
+static bool
+arg_check(int argc, int i, ostream &out)
+{
+	if (i >= argc) {
+		out << "expect arg at pos " << i << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------------
+CommandLine::CommandLine(void)
+	: seed(platform_gen_seed()),
+	  batch(false),
+	  batch_count(0),
+	  batch_first(0),
+	  batch_last(0),
+	  jobs(1),
+	  serve(false),
+	  fork_server(false),
+	  library(false)
+{
+	// Nothing else to do.
+}
+
+// ----------------------------------------------------------------------------
+eCommandLineResult
+CommandLine::parse(int argc, char *argv[], ostream &out)
+{
+	if (!CGOptions::set_default_settings(library)) {
+		out << "please specify integer and pointer sizes in " << PLATFORM_CONFIG_FILE << endl;
+		return eCmdError;
+	}
+
+	for (int i=1; i<argc; i++) {
+
+		if (strcmp (argv[i], "--help") == 0 ||
+			strcmp (argv[i], "-h") == 0) {
+			print_help(out);
+			return eCmdDone;
+		}
+
+		if (strcmp (argv[i], "-hh") == 0) {
+			print_advanced_help(out);
+			return eCmdDone;
+		}
+
+		if (strcmp (argv[i], "--version") == 0 ||
+			strcmp (argv[i], "-v") == 0) {
+			print_version(out);
+			return eCmdDone;
+		}
+		
+		if (strcmp (argv[i], "--seed") == 0 ||
+			strcmp (argv[i], "-s") == 0) {
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+
+			if (!parse_int_arg(argv[i], &seed, out))
+				return eCmdError;
+			continue;
+		}
+
+		if (strcmp (argv[i], "--count") == 0) {
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &batch_count, out))
+				return eCmdError;
+			if (batch_count == 0) {
+				out << "error: --count must be at least 1" << std::endl;
+				return eCmdError;
+			}
+			batch = true;
+			continue;
+		}
+
+		if (strcmp (argv[i], "--seed-range") == 0) {
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (sscanf(argv[i], "%lu:%lu", &batch_first, &batch_last) != 2 ||
+				batch_first > batch_last) {
+				out << "error: expected <from>:<to> after --seed-range" << std::endl;
+				return eCmdError;
+			}
+			batch = true;
+			continue;
+		}
+
+		if (strcmp (argv[i], "--jobs") == 0) {
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &jobs, out))
+				return eCmdError;
+			if (jobs == 0) {
+				out << "error: --jobs must be at least 1" << std::endl;
+				return eCmdError;
+			}
+			continue;
+		}
+
+		if (strcmp (argv[i], "--archive") == 0) {
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			archive = argv[i];
+			continue;
+		}
+
+		if (strcmp (argv[i], "--serve") == 0) {
+			serve = true;
+			continue;
+		}
+
+		if (strcmp (argv[i], "--fork-server") == 0) {
+			fork_server = true;
+			continue;
+		}
+
+		if (strcmp (argv[i], "--serve-socket") == 0) {
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			serve = true;
+			serve_socket = argv[i];
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-block-size") == 0) {
+			unsigned long size = 0;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &size, out))
+				return eCmdError;
+			CGOptions::max_block_size(size);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-funcs") == 0) {
+			unsigned long size = 0;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &size, out))
+				return eCmdError;
+			CGOptions::max_funcs(size);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--packed-struct") == 0) {
+			CGOptions::packed_struct(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-packed-struct") == 0) {
+			CGOptions::packed_struct(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--bitfields") == 0) {
+			CGOptions::bitfields(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-bitfields") == 0) {
+			CGOptions::bitfields(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--compatible-check") == 0) {
+			CGOptions::compatible_check(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--partial-expand") == 0) {
+			string s;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], s)) {
+				out << "--partial-expand needs options" << std::endl;
+				return eCmdError;
+			}
+			CGOptions::partial_expand(s);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--paranoid") == 0) {
+			CGOptions::paranoid(true);
+			continue;
+		}
+		if (strcmp (argv[i], "--no-paranoid") == 0) {
+			CGOptions::paranoid(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--quiet") == 0) {
+			CGOptions::quiet(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--main") == 0) {
+			CGOptions::nomain(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--nomain") == 0) {
+			CGOptions::nomain(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--compound-assignment") == 0) {
+			CGOptions::compound_assignment(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-compound-assignment") == 0) {
+			CGOptions::compound_assignment(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--structs") == 0) {
+			CGOptions::use_struct(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-structs") == 0) {
+			CGOptions::use_struct(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--unions") == 0) {
+			CGOptions::use_union(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-unions") == 0) {
+			CGOptions::use_union(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--argc") == 0) {
+			CGOptions::accept_argc(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-argc") == 0) {
+			CGOptions::accept_argc(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--expand-struct") == 0) {
+			CGOptions::expand_struct(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--fixed-struct-fields") == 0) {
+			CGOptions::fixed_struct_fields(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-struct-fields") ==0 ) {
+			unsigned long ret;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &ret, out))
+				return eCmdError;
+			CGOptions::max_struct_fields(ret);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-union-fields") ==0 ) {
+			unsigned long ret;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &ret, out))
+				return eCmdError;
+			CGOptions::max_union_fields(ret);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-nested-struct-level") ==0 ) {
+			unsigned long ret;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &ret, out))
+				return eCmdError;
+			CGOptions::max_nested_struct_level(ret);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--dfs-debug-sequence") == 0) {
+			string s;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], s))
+				return eCmdError;
+			CGOptions::dfs_debug_sequence(s);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-pointer-depth") ==0 ) {
+			unsigned long ret;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &ret, out))
+				return eCmdError;
+			CGOptions::max_indirect_level(ret);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--output") == 0 ||
+			strcmp (argv[i], "-o") == 0) {
+			string o_file;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], o_file))
+				return eCmdError;
+			CGOptions::output_file(o_file);
+			continue;
+		}    
+
+		if (strcmp (argv[i], "--math-notmp") == 0) {
+			CGOptions::math_notmp(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--math64") == 0) {
+			CGOptions::math64(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-math64") == 0) {
+			CGOptions::math64(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--inline-function") == 0) {
+			CGOptions::inline_function(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-inline-function") == 0) {
+			CGOptions::inline_function(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--longlong") == 0) {
+			CGOptions::longlong(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-longlong") == 0) {
+			CGOptions::longlong(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--int8") == 0) {
+			CGOptions::int8(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-int8") == 0) {
+			CGOptions::int8(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--uint8") == 0) {
+			CGOptions::uint8(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-uint8") == 0) {
+			CGOptions::uint8(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--pointers") == 0) {
+			CGOptions::pointers(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-pointers") == 0) {
+			CGOptions::pointers(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-array-dim") ==0 ) {
+			unsigned long dim;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &dim, out))
+				return eCmdError;
+			CGOptions::max_array_dimensions(dim);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-array-len-per-dim") ==0 ) {
+			unsigned long length;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &length, out))
+				return eCmdError;
+			CGOptions::max_array_length_per_dimension(length);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--arrays") == 0) {
+			CGOptions::arrays(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-arrays") == 0) {
+			CGOptions::arrays(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--strict-const-arrays") == 0) {
+			CGOptions::strict_const_arrays(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--jumps") == 0) {
+			CGOptions::jumps(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-jumps") == 0) {
+			CGOptions::jumps(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--return-structs") == 0) {
+			CGOptions::return_structs(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-return-structs") == 0) {
+			CGOptions::return_structs(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--arg-structs") == 0) {
+			CGOptions::arg_structs(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-arg-structs") == 0) {
+			CGOptions::arg_structs(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--return-unions") == 0) {
+			CGOptions::return_unions(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-return-unions") == 0) {
+			CGOptions::return_unions(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--arg-unions") == 0) {
+			CGOptions::arg_unions(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-arg-unions") == 0) {
+			CGOptions::arg_unions(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--volatiles") == 0) {
+			CGOptions::volatiles(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-volatiles") == 0) {
+			CGOptions::volatiles(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--volatile-pointers") == 0) {
+			CGOptions::volatile_pointers(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-volatile-pointers") == 0) {
+			CGOptions::volatile_pointers(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--const-pointers") == 0) {
+			CGOptions::const_pointers(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-const-pointers") == 0) {
+			CGOptions::const_pointers(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--enable-access-once") == 0) {
+			CGOptions::access_once(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--strict-volatile-rule") == 0) {
+			CGOptions::strict_volatile_rule(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--addr-taken-of-locals") == 0) {
+			CGOptions::addr_taken_of_locals(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-addr-taken-of-locals") == 0) {
+			CGOptions::addr_taken_of_locals(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--fresh-array-ctrl-var-names") == 0) {
+			CGOptions::fresh_array_ctrl_var_names(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--consts") == 0) {
+			CGOptions::consts(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-consts") == 0) {
+			CGOptions::consts(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--dangling-global-pointers") == 0) {
+			CGOptions::dangling_global_ptrs(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-dangling-global-pointers") == 0) {
+			CGOptions::dangling_global_ptrs(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--divs") == 0) {
+			CGOptions::divs(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-divs") == 0) {
+			CGOptions::divs(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--muls") == 0) {
+			CGOptions::muls(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-muls") == 0) {
+			CGOptions::muls(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--checksum") == 0) {
+			CGOptions::compute_hash(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-checksum") == 0) {
+			CGOptions::compute_hash(false);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--builtins") == 0) {
+			CGOptions::builtins(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-builtins") == 0) {
+			CGOptions::builtins(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--random-random") == 0) {
+			CGOptions::random_random(true);
+			continue;
+		}
+		
+		if (strcmp (argv[i], "--check-global") == 0) {
+			CGOptions::blind_check_global(true);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--stop-by-stmt") ==0 ) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::stop_by_stmt(num);
+			continue;
+		}  
+
+		if (strcmp (argv[i], "--dump-default-probabilities") == 0) {
+			string filename;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], filename)) {
+				out<< "please pass probability configuration output file!" << std::endl;
+				return eCmdError;
+			}
+			CGOptions::dump_default_probabilities(filename);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--dump-random-probabilities") == 0) {
+			string filename;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], filename)) {
+				out<< "please pass probability configuration output file!" << std::endl;
+				return eCmdError;
+			}
+			CGOptions::dump_random_probabilities(filename);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--probability-configuration") == 0) {
+			string filename;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], filename)) {
+				out<< "please probability configuration file!" << std::endl;
+				return eCmdError;
+			}
+			CGOptions::probability_configuration(filename);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--const-as-condition") == 0) {
+			CGOptions::const_as_condition(true);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--match-exact-qualifiers") == 0) {
+			CGOptions::match_exact_qualifiers(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-return-dead-pointer") == 0) {
+			CGOptions::no_return_dead_ptr(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--return-dead-pointer") == 0) {
+			CGOptions::no_return_dead_ptr(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--concise") == 0) {
+			//CGOptions::quiet(true);
+			//CGOptions::paranoid(false);
+			CGOptions::concise(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--identify-wrappers") == 0) {
+			CGOptions::identify_wrappers(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--safe-math-wrappers") == 0) {
+			string ids;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], ids)) {
+				out<< "please specify safe math wrappers in the form of id1,id2..." << std::endl;
+				return eCmdError;
+			}
+			CGOptions::safe_math_wrapper(ids);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--mark-mutable-const") == 0) {
+			CGOptions::mark_mutable_const(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--force-globals-static") == 0) {
+			CGOptions::force_globals_static(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--force-non-uniform-arrays") == 0) {
+			CGOptions::force_non_uniform_array_init(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-force-non-uniform-arrays") == 0) {
+			CGOptions::force_non_uniform_array_init(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--inline-function-prob") == 0 ) {
+			unsigned long prob;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &prob, out))
+				return eCmdError;
+			CGOptions::inline_function_prob(prob);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--builtin-function-prob") == 0 ) {
+			unsigned long prob;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &prob, out))
+				return eCmdError;
+			CGOptions::builtin_function_prob(prob);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--enable-builtin-kinds") == 0) {
+			string kinds;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], kinds)) {
+				out<< "please specify enabled builtin kinds in the form of k1,k2..." << std::endl;
+				return eCmdError;
+			}
+			CGOptions::enable_builtin_kinds(kinds);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--disable-builtin-kinds") == 0) {
+			string kinds;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], kinds)) {
+				out<< "please specify disabled builtin kinds in the form of k1,k2..." << std::endl;
+				return eCmdError;
+			}
+			CGOptions::disable_builtin_kinds(kinds);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--null-ptr-deref-prob") == 0 ) {
+			unsigned long prob;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &prob, out))
+				return eCmdError;
+			CGOptions::null_pointer_dereference_prob(prob);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--dangling-ptr-deref-prob") == 0 ) {
+			unsigned long prob;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &prob, out))
+				return eCmdError;
+			CGOptions::dead_pointer_dereference_prob(prob);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-expr-complexity") == 0 ) {
+			unsigned long comp;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &comp, out))
+				return eCmdError;
+			CGOptions::max_expr_depth(comp);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-block-depth") == 0 ) {
+			unsigned long depth;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &depth, out))
+				return eCmdError;
+			CGOptions::max_blk_depth(depth);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--union-read-type-sensitive") == 0) {
+			CGOptions::union_read_type_sensitive(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-union-read-type-sensitive") == 0) {
+			CGOptions::union_read_type_sensitive(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--pre-incr-operator") == 0) {
+			CGOptions::pre_incr_operator(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-pre-incr-operator") == 0) {
+			CGOptions::pre_incr_operator(false);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--pre-decr-operator") == 0) {
+			CGOptions::pre_decr_operator(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-pre-decr-operator") == 0) {
+			CGOptions::pre_decr_operator(false);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--post-incr-operator") == 0) {
+			CGOptions::post_incr_operator(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-post-incr-operator") == 0) {
+			CGOptions::post_incr_operator(false);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--post-decr-operator") == 0) {
+			CGOptions::post_decr_operator(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-post-decr-operator") == 0) {
+			CGOptions::post_decr_operator(false);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--unary-plus-operator") == 0) {
+			CGOptions::unary_plus_operator(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-unary-plus-operator") == 0) {
+			CGOptions::unary_plus_operator(false);
+			continue;
+		} 
+
+		if (strcmp (argv[i], "--embedded-assigns") == 0) {
+			CGOptions::use_embedded_assigns(true);
+			continue;
+		}
+
+        if (strcmp (argv[i], "--no-safe-math") == 0){
+            CGOptions::avoid_signed_overflow(false);
+            continue;
+        }
+
+        if (strcmp (argv[i], "--safe-math") == 0){
+            CGOptions::avoid_signed_overflow(true);
+            continue;
+        }
+
+		if (strcmp (argv[i], "--no-embedded-assigns") == 0) {
+			CGOptions::use_embedded_assigns(false);
+			continue;
+		} 
+	
+		if (strcmp (argv[i], "--comma-operators") == 0) {
+			CGOptions::use_comma_exprs(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-comma-operators") == 0) {
+			CGOptions::use_comma_exprs(false);
+			continue;
+		}  
+
+		if (strcmp (argv[i], "--take-no-union-field-addr") == 0) {
+			CGOptions::take_union_field_addr(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--take-union-field-addr") == 0) {
+			CGOptions::take_union_field_addr(true);
+			continue;
+		}  
+
+		if (strcmp (argv[i], "--vol-struct-union-fields") == 0) {
+			CGOptions::vol_struct_union_fields(true);
+			continue;
+		}  
+
+		if (strcmp (argv[i], "--no-vol-struct-union-fields") == 0) {
+			CGOptions::vol_struct_union_fields(false);
+			continue;
+		}  
+
+		if (strcmp (argv[i], "--no-hash-value-printf") == 0) {
+			CGOptions::hash_value_printf(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--no-signed-char-index") == 0) {
+			CGOptions::signed_char_index(false);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--profile") == 0) {
+			string filename;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], filename)) {
+				out<< "please pass profile output file!" << std::endl;
+				return eCmdError;
+			}
+			CGOptions::profile_file(filename);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-memory") == 0) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::max_memory(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--memory-stats") == 0) {
+			CGOptions::memory_stats(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--target-size") == 0) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::target_size(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--min-size") == 0) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::min_size(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-size") == 0) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::max_size(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--time-budget") == 0) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::time_budget(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--stmt-budget") == 0) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::stmt_budget(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--checksum-algo") == 0) {
+			string algo;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_string_arg(argv[i], algo) ||
+				(algo != "crc32" && algo != "crc32-slice8" && algo != "word")) {
+				out<< "please pass crc32, crc32-slice8 or word to --checksum-algo!" << std::endl;
+				return eCmdError;
+			}
+			CGOptions::checksum_algo(algo);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--bulk-array-hash") == 0) {
+			CGOptions::bulk_array_hash(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--prune-safe-math") == 0) {
+			CGOptions::prune_safe_math(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--runtime-lib") == 0) {
+			CGOptions::runtime_lib(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--max-exec-cost") == 0) {
+			unsigned long num;
+			i++;
+			if (!arg_check(argc, i, out))
+				return eCmdError;
+			if (!parse_int_arg(argv[i], &num, out))
+				return eCmdError;
+			CGOptions::max_exec_cost(num);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--emit-profile-counters") == 0) {
+			CGOptions::emit_profile_counters(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--checksum-trace") == 0) {
+			CGOptions::checksum_trace(true);
+			continue;
+		}
+
+		if (strcmp (argv[i], "--lang-cpp") == 0) {
+			CGOptions::lang_cpp(true);
+			continue;
+		} 
+
+		// OMIT help
+
+		// OMIT compute-hash
+		
+		// OMIT depth-protect
+		
+		// OMIT wrap-volatiles
+		
+		// OMIT allow-const-volatile
+		
+		// OMIT allow-int64
+		
+		// OMIT avoid-signed-overflow
+
+		// FIXME-- we should parse all options and then this should be
+		// an error
+		
+		out << "invalid option " << argv[i] << " at: "
+			 << i 
+			 << endl;
+		return eCmdError;
+	}
+
+	if (CGOptions::has_conflict()) {
+		out << "error: options conflict - " << CGOptions::conflict_msg() << std::endl;
+		return eCmdError;
+	}
+
+	// the limit is shared by the generations under --jobs, so it is set
+	// here, before they start, rather than by each of them
+	MemoryAccounting::set_limit((unsigned long long)CGOptions::max_memory() << 20);
+
+	return eCmdGenerate;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,93 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// The Csmith command line.  parse() turns the arguments into the settings
+/// in CGOptions, plus the few settings that belong to the driver rather than
+/// to the generator (the seed, the batch and the server mode).  It is shared by the
+/// csmith program and by the library interface in libcsmith.h, which is why
+/// it reports problems to a stream instead of exiting.
+///
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <ostream>
+#include <string>
+
+enum eCommandLineResult {
+	eCmdGenerate,	// go on and generate
+	eCmdDone,		// nothing to generate, e.g., --help or --version
+	eCmdError		// bad command line; the message went to the stream
+};
+
+class CommandLine
+{
+public:
+	CommandLine(void);
+
+	// parse argv[1 .. argc-1]; help and error messages go to out
+	eCommandLineResult parse(int argc, char *argv[], std::ostream &out);
+
+	// the seed of the (first) program, random if not given
+	unsigned long seed;
+
+	// batch mode: generate programs for seeds batch_first..batch_last,
+	// or batch_count programs starting from seed
+	bool batch;
+	unsigned long batch_count;
+	unsigned long batch_first;
+	unsigned long batch_last;
+
+	// number of threads for batch mode
+	unsigned long jobs;
+
+	// batch mode: the archive to write the programs to, if any
+	std::string archive;
+
+	// server mode: take requests from stdin, or from serve_socket if set
+	bool serve;
+	std::string serve_socket;
+
+	// server mode: generate each program in a forked child
+	bool fork_server;
+
+	// set by libcsmith: parse without writing platform.info, and report a
+	// bad one as an error
+	bool library;
+};
+
+#endif // COMMAND_LINE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -35,4 +35,11 @@
   ClassName(const ClassName&);               \
   void operator=(const ClassName&)
 
+// Thread-local storage class for plain-old-data variables
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 #endif // COMMON_MACROS_H
@@ -64,35 +64,40 @@
 #include "FunctionInvocationUser.h"
 #include "FunctionInvocationBinary.h"
 #include "FunctionInvocationUnary.h"
+#include "Profiler.h"
+#include "GenerationContext.h"
+#include "GenerationBudget.h"
 
 using namespace std;
 
-DefaultCOutputMgr *DefaultCOutputMgr::instance_ = NULL;
+DefaultCOutputMgr *&
+DefaultCOutputMgr::instance_(void)
+{
+	return GenerationContext::current().output_mgr;
+}
 
 // Make sure this is a singleton
 DefaultCOutputMgr *
 DefaultCOutputMgr::CreateInstance()
 {
-	if (DefaultCOutputMgr::instance_)
-		return DefaultCOutputMgr::instance_; 
+	if (DefaultCOutputMgr::instance_())
+		return DefaultCOutputMgr::instance_(); 
 
-	DefaultCOutputMgr::instance_ = new DefaultCOutputMgr(); 
+	DefaultCOutputMgr::instance_() = new DefaultCOutputMgr(); 
 
-	assert(DefaultCOutputMgr::instance_);
-	DefaultCOutputMgr::instance_->Init();
-	return DefaultCOutputMgr::instance_;
+	assert(DefaultCOutputMgr::instance_());
+	DefaultCOutputMgr::instance_()->Init();
+	return DefaultCOutputMgr::instance_();
 }  
 
 void 
 DefaultCOutputMgr::OutputUserDefinedType(const Type& t)
 { 
-	static vector<const Type*> printedTypes;
-
     // sanity check
     assert (t.IsUserDefined());
 
 	std::ostream& out = Out();
-	if (std::find(printedTypes.begin(), printedTypes.end(), &t) == printedTypes.end()) { 
+	if (std::find(printed_types_.begin(), printed_types_.end(), &t) == printed_types_.end()) { 
         // output dependent structs, if any
         for (size_t i=0; i<t.fields.size(); i++) { 
 			if (t.fields[i]->IsUserDefined()) {
@@ -145,7 +150,7 @@ DefaultCOutputMgr::OutputUserDefinedType(const Type& t)
         } 
 		out << newline_;
 
-		printedTypes.push_back(&t);
+		printed_types_.push_back(&t);
     }
 }
 
@@ -153,31 +158,88 @@ void
 DefaultCOutputMgr::OutputProgram()
 {
 	std::ostream &out = Out(); 
+	vector<const Function*> funcList = Function::GetRandomFunctions();
+
+	// the header was written before the generation; it is only now known
+	// whether the clock shaped the program
+	if (GenerationBudget::stop_sid()) {
+		out << Comment2Str("--time-budget stopped the generation: use --stmt-budget " +
+						   StringUtils::int2str(GenerationBudget::stop_sid()) +
+						   " instead to regenerate this program") + newline_ + newline_;
+	}
+
+	if (CGOptions::prune_safe_math()) {
+		OutputSafeMathUses(funcList);
+		OutputRuntimeInclude();
+	}
 		
 	// define wrapper function number
 	if (CGOptions::identify_wrappers()) { 
-		out << "#define N_WRAP " << SafeOpFlags::wrapper_names.size() << std::endl; 
+		out << "#define N_WRAP " << SafeOpFlags::wrapper_names().size() << std::endl; 
 	}
 
-	OutputUserDefinedTypes();
-
-	out << Comment2Str("--- GLOBAL VARIABLES ---") + newline_;
-	out << VarDefs2Str(*(VariableSelector::GetGlobalVariables()));
+	{
+		ProfileScope scope("OutputTypes");
+		OutputUserDefinedTypes();
+	}
+	{
+		ProfileScope scope("OutputGlobals");
+		out << Comment2Str("--- GLOBAL VARIABLES ---") + newline_;
+		out << VarDefs2Str(*(VariableSelector::GetGlobalVariables()));
+	}
 	 
-	vector<const Function*> funcList = Function::GetRandomFunctions();
-	OutputForwardDeclarations(funcList);
+	// The program is written only after GenerateFunctions has returned, and
+	// no function can be written (or its body freed) any earlier.  New
+	// functions, and so new forward declarations, are created on demand
+	// while the bodies are generated, and so are the globals they use.  A
+	// call generated later into an already built function makes the
+	// data-flow analysis walk its body again and widen the effects printed
+	// above it.  Everything is final only at the end of generation.
+	{
+		ProfileScope scope("OutputFunctions");
+		OutputForwardDeclarations(funcList);
 
-	out << newline_ + newline_; 
-	out << Comment2Str("--- FUNCTIONS ---") + newline_;
-	for (size_t i=0; i<funcList.size(); i++) {
-		OutputFunction(*funcList[i]); 
+		out << newline_ + newline_; 
+		out << Comment2Str("--- FUNCTIONS ---") + newline_;
+		for (size_t i=0; i<funcList.size(); i++) {
+			OutputFunction(*funcList[i]); 
+		}
+	}
+
+	if (CGOptions::emit_profile_counters()) {
+		OutputProfileCounters();
 	}
 		
-	if (!CGOptions::nomain())
+	if (!CGOptions::nomain()) {
+		ProfileScope scope("OutputMain");
 		OutputMain();
+	}
 	OutputTail(); 
 }   
 
+// Tell the runtime which safe math wrappers the functions call, so that
+// safe_math.h only defines those. The wrappers are registered with
+// SafeOpFlags as the functions are rendered, so render them once first.
+void
+DefaultCOutputMgr::OutputSafeMathUses(const vector<const Function*>& funcList)
+{
+	ProfileScope scope("OutputSafeMathUses");
+	std::ostream &out = Out();
+	for (size_t i=0; i<funcList.size(); i++) {
+		FunctionSize(*funcList[i]);
+	}
+
+	out << "#define CSMITH_PRUNE_SAFE_MATH" << endl;
+	const vector<string>& names = SafeOpFlags::wrapper_names();
+	for (size_t i=0; i<names.size(); i++) {
+		// safe_math_macros.h defines the macro variants in full
+		if (names[i].compare(0, 5, "safe_") == 0 && names[i].find("_func_") != string::npos) {
+			out << "#define CSMITH_USE_" << names[i].substr(5) << endl;
+		}
+	}
+	out << endl;
+}
+
 // Output a type. For user defined types, this is just a delcaration
 std::string
 DefaultCOutputMgr::Type2Str(const Type& t)
@@ -236,10 +298,10 @@ DefaultCOutputMgr::QualifiedType2Str(const Type& t, const TypeQualifiers* qfer)
 	return str;
 }     
 
-std::string
-DefaultCOutputMgr::Expression2Str(const Expression& e)
+void
+DefaultCOutputMgr::AppendExpression(std::string &str, const Expression& e)
 { 
-	string str;
+	const size_t start = str.size();
 	// output type case if there is one
 	if (e.cast_type != NULL) { 
 		str += "(" + Type2Str(*e.cast_type) + ")"; 
@@ -251,7 +313,9 @@ DefaultCOutputMgr::Expression2Str(const Expression& e)
 			const Constant& ec = (const Constant&)e;
 			//enclose negative numbers in parenthesis to avoid syntax errors such as "--8"
 			if (!ec.get_value().empty() && ec.get_value()[0] == '-') {
-				str += "(" + ec.get_value() + ")";
+				str += "(";
+				str += ec.get_value();
+				str += ")";
 			} 
 			else if (ec.get_type().eType == ePointer && ec.equals(0)){ 
 				str += "NULL";
@@ -266,13 +330,12 @@ DefaultCOutputMgr::Expression2Str(const Expression& e)
 			int indirect_level = ev.get_indirect_level(); 
 			if (indirect_level > 0) {
 				str += "(";
-				for (int i=0; i<indirect_level; i++) 
-					str += "*"; 
+				str.append(indirect_level, '*');
 			} else if (indirect_level < 0) {
 				assert(indirect_level == -1);
 				str += "&";
 			}
-			str += VarRef2Str(*ev.get_var());
+			AppendVarRef(str, *ev.get_var());
 			if (indirect_level > 0)
 				str += ")";
 			break;
@@ -280,25 +343,37 @@ DefaultCOutputMgr::Expression2Str(const Expression& e)
 		case eLhs: {
 			const Lhs& lhs = (const Lhs&)e; 
 			ExpressionVariable ev(*(lhs.get_var()), &lhs.get_type());
-			str = Expression2Str(ev);
-			if (lhs.get_var()->is_volatile() && CGOptions::wrap_volatiles())  
-				 str = "VOL_LVAL(" + str + ", " + Type2Str(lhs.get_type()) + ")";
+			// an lvalue replaces whatever cast was output above
+			str.resize(start);
+			if (lhs.get_var()->is_volatile() && CGOptions::wrap_volatiles()) {
+				str += "VOL_LVAL(";
+				AppendExpression(str, ev);
+				str += ", " + Type2Str(lhs.get_type()) + ")";
+			}
+			else {
+				AppendExpression(str, ev);
+			}
 			break;
 		}
 		case eFunction: {
-			str += FunctionInvocation2Str(((const ExpressionFuncall&)e).get_invoke()); 
+			AppendFunctionInvocation(str, ((const ExpressionFuncall&)e).get_invoke()); 
 			break;
 		}
 		case eCommaExpr: {
 			const ExpressionComma& ec = (const ExpressionComma&)e; 
-			str += "(" + Expression2Str(*ec.get_lhs()) + ", " + Expression2Str(*ec.get_rhs()) + ")"; 
+			str += "(";
+			AppendExpression(str, *ec.get_lhs());
+			str += ", ";
+			AppendExpression(str, *ec.get_rhs());
+			str += ")"; 
 			break;
 		}
 		case eAssignment: 
-			str += "(" + Assign2Str(*((const ExpressionAssign&)e).get_stm_assign()) + ")";  
+			str += "(";
+			AppendAssign(str, *((const ExpressionAssign&)e).get_stm_assign());
+			str += ")";  
 			break; 
 	}
-	return str;
 }  
 
 void
@@ -499,14 +574,13 @@ string
 DefaultCOutputMgr::BuildArrayInitRecursive(const ArrayVariable& av, size_t dimen, const vector<string>& init_strings) 
 {
 	assert (dimen < av.get_dimension());
-	static unsigned seed = 0xABCDEF; 
 	string ret = "{";
 	for (size_t i=0; i<av.get_sizes()[dimen]; i++) {
 		if (dimen == av.get_sizes().size() - 1) {
 			// use magic number to choose an initial value 
-			size_t rnd_index = ((seed * seed + (i+7) * (i+13)) * 52369) % (init_strings.size()); 
+			size_t rnd_index = ((array_init_seed_ * array_init_seed_ + (i+7) * (i+13)) * 52369) % (init_strings.size()); 
 			ret += init_strings[rnd_index];
-			seed++;
+			array_init_seed_++;
 		 } else {
 			ret += BuildArrayInitRecursive(av, dimen + 1, init_strings);
 		 }
@@ -516,6 +590,24 @@ DefaultCOutputMgr::BuildArrayInitRecursive(const ArrayVariable& av, size_t dimen
 	return ret;
 }
 
+size_t
+DefaultCOutputMgr::FunctionSize(const Function& f)
+{
+	unsigned saved_seed = array_init_seed_;
+	size_t size = CFamilyOutputMgr::FunctionSize(f);
+	array_init_seed_ = saved_seed;
+	return size;
+}
+
+size_t
+DefaultCOutputMgr::GlobalSize(const Variable& v)
+{
+	unsigned saved_seed = array_init_seed_;
+	size_t size = CFamilyOutputMgr::GlobalSize(v);
+	array_init_seed_ = saved_seed;
+	return size;
+}
+
 // build the string initializer in form of "{...}"
 std::string
 DefaultCOutputMgr::ArrayInits2Str(const ArrayVariable& av, const vector<const Expression*>& inits) 
@@ -532,17 +624,16 @@ DefaultCOutputMgr::ArrayInits2Str(const ArrayVariable& av, const vector<const Ex
 	return BuildArrayInitRecursive(av, 0, init_strings); 
 }  
 
-std::string
-DefaultCOutputMgr::FunctionInvocation2Str(const FunctionInvocation* fi)
+void
+DefaultCOutputMgr::AppendFunctionInvocation(std::string &str, const FunctionInvocation* fi)
 {
 	assert(fi);
-	string str;
 	if (fi->invoke_type == eFuncCall) {
 		const FunctionInvocationUser* fiu = (const FunctionInvocationUser*)fi;
 		str += fiu->get_func()->name + "(";
 		for (size_t i=0; i<fiu->param_value.size(); i++) {
 			if (i > 0) str += ", ";
-			str += Expression2Str(*fiu->param_value[i]); 
+			AppendExpression(str, *fiu->param_value[i]); 
 		}
 		str += ")";
 	} 
@@ -560,17 +651,23 @@ DefaultCOutputMgr::FunctionInvocation2Str(const FunctionInvocation* fi)
 			string fname = fib->GetOpFlags()->to_string(op); 
 			int id = SafeOpFlags::to_id(fname);
 						 
-			str += fname + "(" + (CGOptions::math_notmp() ? (fib->get_tmp_var1() + ", ") : "");  
-			str += Expression2Str(*fib->param_value[0]) + ", ";
-			str += CGOptions::math_notmp() ? (fib->get_tmp_var2() + ", ") : ""; 
-			str += Expression2Str(*fib->param_value[1]);
+			str += fname + "(";
+			if (CGOptions::math_notmp())
+				str += fib->get_tmp_var1() + ", ";
+			AppendExpression(str, *fib->param_value[0]);
+			str += ", ";
+			if (CGOptions::math_notmp())
+				str += fib->get_tmp_var2() + ", ";
+			AppendExpression(str, *fib->param_value[1]);
 
 			if (CGOptions::identify_wrappers()) {
 				str += ", " + id;
 			}
 		} 
 		else {
-			str += Expression2Str(*fib->param_value[0]) + BinaryOperator2Str(op) + Expression2Str(*fib->param_value[1]);
+			AppendExpression(str, *fib->param_value[0]);
+			str += BinaryOperator2Str(op);
+			AppendExpression(str, *fib->param_value[1]);
 		}
 		str += ")";	
 	}  
@@ -586,18 +683,20 @@ DefaultCOutputMgr::FunctionInvocation2Str(const FunctionInvocation* fi)
 			string fname = fiu->GetOpFlags()->to_string(op);
 			int id = SafeOpFlags::to_id(fname); 
 
-			str += fname + "(" + (CGOptions::math_notmp() ? (fiu->get_tmp_var() + ", ") : ""); 
-			str += Expression2Str(*fiu->param_value[0]);
+			str += fname + "(";
+			if (CGOptions::math_notmp())
+				str += fiu->get_tmp_var() + ", ";
+			AppendExpression(str, *fiu->param_value[0]);
 			if (CGOptions::identify_wrappers()) {
 				str += ", " + id;
 			}
 		}
 		else {
-			str += UnaryOperator2Str(op) + Expression2Str(*fiu->param_value[0]);
+			str += UnaryOperator2Str(op);
+			AppendExpression(str, *fiu->param_value[0]);
 		}
 		str += ")";  
 	}
-	return str;
 }   
  
 std::string
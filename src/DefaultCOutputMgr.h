@@ -56,10 +56,10 @@ class DefaultCOutputMgr : public CFamilyOutputMgr {
 public:
 	static DefaultCOutputMgr *CreateInstance();
 
-	DefaultCOutputMgr() {}
-	virtual ~DefaultCOutputMgr() {};  
+	DefaultCOutputMgr() : array_init_seed_(0xABCDEF) {}
+	virtual ~DefaultCOutputMgr() { instance_() = NULL; }
 
-	virtual std::string Expression2Str(const Expression& e);  
+	virtual void AppendExpression(std::string &str, const Expression& e);
 	  
 	virtual void OutputStmtAssertions(const Statement* stm, bool forFactsOut);
 
@@ -76,7 +76,11 @@ public:
 	virtual std::string FactPointsTo2Str(const FactPointTo& fp);
 	virtual std::string ArrayInits2Str(const ArrayVariable& av, const vector<const Expression*>& inits);  
 
-	std::string FunctionInvocation2Str(const FunctionInvocation* fi);   
+	virtual void AppendFunctionInvocation(std::string &str, const FunctionInvocation* fi);
+
+	// measuring must not advance the array initializer seed
+	virtual size_t FunctionSize(const Function& f);
+	virtual size_t GlobalSize(const Variable& v);
 
 protected:  
 
@@ -89,7 +93,15 @@ private:
 
 	void OutputForwardDeclarations(const vector<const Function*>& funcList);
 
-	static DefaultCOutputMgr *instance_; 
+	void OutputSafeMathUses(const vector<const Function*>& funcList);
+
+	static DefaultCOutputMgr *&instance_(void);
+
+	// user-defined types that have been printed
+	vector<const Type*> printed_types_;
+
+	// magic number used to pick array initializers
+	unsigned array_init_seed_;
 };
 
 #endif // DEFAULT_C_OUTPUT_MGR_H
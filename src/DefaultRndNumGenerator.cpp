@@ -39,15 +39,13 @@
 #include "SequenceFactory.h"
 #include "Sequence.h"
 #include "CGOptions.h"
+#include "GenerationContext.h"
 
-#ifdef WIN32
-extern "C" {
-	extern void srand48(long seed);
-	extern long lrand48(void);
+DefaultRndNumGenerator *&
+DefaultRndNumGenerator::impl_(void)
+{
+	return GenerationContext::current().default_rnd;
 }
-#endif
-
-DefaultRndNumGenerator *DefaultRndNumGenerator::impl_ = 0;
 
 /*
  *
@@ -66,6 +64,7 @@ DefaultRndNumGenerator::DefaultRndNumGenerator(const unsigned long, Sequence *co
 DefaultRndNumGenerator::~DefaultRndNumGenerator()
 {
 	SequenceFactory::destroy_sequences();
+	impl_() = NULL;
 }
 
 /*
@@ -74,16 +73,16 @@ DefaultRndNumGenerator::~DefaultRndNumGenerator()
 DefaultRndNumGenerator*
 DefaultRndNumGenerator::make_rndnum_generator(const unsigned long seed)
 {
-	if (impl_)
-		return impl_;
+	if (impl_())
+		return impl_();
 
 	Sequence *seq = SequenceFactory::make_sequence();
 
-	impl_ = new DefaultRndNumGenerator(seed, seq);
-	assert(impl_);
+	impl_() = new DefaultRndNumGenerator(seed, seq);
+	assert(impl_());
 	//impl_->seedrand(seed);
 	
-	return impl_;
+	return impl_();
 }
 
 /*
@@ -114,7 +113,7 @@ DefaultRndNumGenerator::add_number(int v, int bound, int k)
 unsigned int
 DefaultRndNumGenerator::rnd_upto(const unsigned int n, const Filter *f, const std::string *where)
 {
-	static int g = 0;
+	static THREAD_LOCAL int g = 0;
 	int h = g;
 	if (h == 440)
 		BREAK_NOP;   // for debugging
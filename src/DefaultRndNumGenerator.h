@@ -70,7 +70,7 @@ private:
 
 	void add_number(int v, int bound, int k);
 
-	static DefaultRndNumGenerator *impl_;
+	static DefaultRndNumGenerator *&impl_(void);
 
 	unsigned INT64 rand_depth_;
 
@@ -35,6 +35,7 @@
 #include "Block.h"
 #include "Type.h"
 #include "AbsOutputMgr.h"
+#include "MemoryAccounting.h"
 
 using namespace std;
 
@@ -88,12 +89,12 @@ Effect::Effect(void) :
  * 
  */
 Effect::Effect(const Effect &e) :
-	read_vars(e.read_vars),
-	write_vars(e.write_vars),
 	pure(e.pure),
 	side_effect_free(e.side_effect_free)
 {
-	// Nothing else to do.
+	MemoryScope mem(eMemEffects);
+	read_vars = e.read_vars;
+	write_vars = e.write_vars;
 }
 
 /*
@@ -114,6 +115,7 @@ Effect::operator=(const Effect &e)
 		return *this;
 	}
 
+	MemoryScope mem(eMemEffects);
 	read_vars = e.read_vars;
 	write_vars = e.write_vars;
 	pure = e.pure;
@@ -128,6 +130,7 @@ Effect::operator=(const Effect &e)
 void
 Effect::read_var(const Variable *v)
 {
+	MemoryScope mem(eMemEffects);
 	if (!is_read(v)) {
 		read_vars.push_back(v);
 	}
@@ -153,6 +156,7 @@ Effect::access_deref_volatile(const Variable *v, int deref_level)
 void
 Effect::write_var(const Variable *v)
 {
+	MemoryScope mem(eMemEffects);
 	if (!is_written(v)) {
 		write_vars.push_back(v);
 	}
@@ -180,6 +184,7 @@ Effect::add_effect(const Effect &e, bool include_lhs_effects)
 	if (this == &e) {
 		return;
 	}
+	MemoryScope mem(eMemEffects);
 
 	// Stuff that so badly wants to be rewritten using decent STL containers
 	// and algorithms... compute the union effect.
@@ -218,6 +223,7 @@ Effect::add_external_effect(const Effect &e)
 	if (this == &e) {
 		return;
 	}
+	MemoryScope mem(eMemEffects);
 	
 	vector<Variable *>::size_type len;
 	vector<Variable *>::size_type i;
@@ -250,6 +256,7 @@ Effect::add_external_effect(const Effect &e, std::vector<const Block*> call_chai
 	if (this == &e) {
 		return;
 	}
+	MemoryScope mem(eMemEffects);
 	
 	vector<Variable *>::size_type len;
 	vector<Variable *>::size_type i, j;
@@ -0,0 +1,322 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+#include "ExecCost.h"
+
+#include <vector>
+#include "CGOptions.h"
+#include "Function.h"
+#include "FunctionInvocationUser.h"
+#include "Block.h"
+#include "Statement.h"
+#include "StatementFor.h"
+#include "StatementArrayOp.h"
+#include "ArrayVariable.h"
+#include "Expression.h"
+#include "Type.h"
+#include "GenerationContext.h"
+
+using namespace std;
+
+// trip count of a loop that wraps around its control variable or never ends
+static const double unbounded_trips = 1e12;
+
+// steps simulated before a loop is taken as unbounded; the loops the
+// generator makes end within a hundred steps if they end without wrapping
+static const int max_simulated_trips = 4096;
+
+// assumed cost of one run of a loop body, or of a function, that is still
+// to be generated
+static const double loop_body_guess = 8;
+static const double new_function_guess = 64;
+
+// loop limits stay within the range make_random_loop_control picks them from
+static const int shrunk_limit_max = 60;
+static const int shrunk_limit_min = -30;
+
+bool
+ExecCost::enabled(void)
+{
+	return CGOptions::max_exec_cost() > 0;
+}
+
+// the value `v' takes when stored in a variable of the given width
+static long long
+as_type(long long v, int bits, bool is_signed)
+{
+	if (bits >= 64)
+		return v;
+	unsigned long long mask = (1ULL << bits) - 1;
+	unsigned long long u = (unsigned long long)v & mask;
+	if (is_signed && (u >> (bits - 1)))
+		u |= ~mask;
+	return (long long)u;
+}
+
+template <class T>
+static bool
+holds(T a, T b, eBinaryOps op)
+{
+	switch (op) {
+	case eCmpLt: return a < b;
+	case eCmpLe: return a <= b;
+	case eCmpGt: return a > b;
+	case eCmpGe: return a >= b;
+	case eCmpEq: return a == b;
+	case eCmpNe: return a != b;
+	default: return false;
+	}
+}
+
+static bool
+is_increment(eAssignOps incr_op)
+{
+	return incr_op == eAddAssign || incr_op == ePreIncr || incr_op == ePostIncr;
+}
+
+double
+ExecCost::trip_count(int init, int limit, int incr, eBinaryOps test_op,
+					 eAssignOps incr_op, const Type &type)
+{
+	int bits = type.SizeInBytes() * 8;
+	if (bits <= 0 || bits > 64)
+		bits = 32;
+	bool is_signed = type.is_signed();
+	long long step = (incr_op == eAddAssign || incr_op == eSubAssign) ? incr : 1;
+	if (!is_increment(incr_op))
+		step = -step;
+
+	// as in C, a variable narrower than int is compared as an int, and an
+	// unsigned one of int size or more makes the comparison unsigned
+	bool unsigned_cmp = !is_signed && bits >= 32;
+	long long v = as_type(init, bits, is_signed);
+	long long lim = unsigned_cmp ? as_type(limit, bits, false) : limit;
+	for (int trips = 0; trips < max_simulated_trips; trips++) {
+		bool more = unsigned_cmp ?
+			holds<unsigned long long>(v, lim, test_op) : holds<long long>(v, lim, test_op);
+		if (!more)
+			return trips;
+		v = as_type(v + step, bits, is_signed);
+	}
+	return unbounded_trips;
+}
+
+double
+ExecCost::allowed_trips(void)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	double remaining = CGOptions::max_exec_cost() - ctx.exec_spent;
+	if (remaining <= 0)
+		return 0;
+	// nothing costs anything in a loop body that never runs
+	if (ctx.exec_weight <= 0)
+		return unbounded_trips;
+	double trips = remaining / (ctx.exec_weight * loop_body_guess);
+	return trips < 1 ? 0 : (double)(long long)trips;
+}
+
+double
+ExecCost::shrink_loop(int &init, int &limit, int incr, eBinaryOps &test_op,
+					  eAssignOps incr_op, const Type &type)
+{
+	double allowed = allowed_trips();
+	int step = (incr_op == eAddAssign || incr_op == eSubAssign) ? incr : 1;
+	// a negative start would wrap an unsigned variable to a huge value
+	if (!type.is_signed() && init < 0)
+		init = 0;
+	int k = (allowed > shrunk_limit_max) ? shrunk_limit_max : (int)allowed;
+	if (is_increment(incr_op)) {
+		if (init + k * step > shrunk_limit_max)
+			k = (shrunk_limit_max - init) / step;
+		limit = init + k * step;
+		test_op = eCmpLt;
+	} else {
+		int low = type.is_signed() ? shrunk_limit_min : 0;
+		if (init - k * step < low)
+			k = (init - low) / step;
+		limit = init - k * step;
+		test_op = eCmpGt;
+	}
+	return trip_count(init, limit, incr, test_op, incr_op, type);
+}
+
+double
+ExecCost::shrink_array_loop(int init, int &limit, int incr, eBinaryOps test_op,
+							eAssignOps incr_op, const Type &type, unsigned int &bound)
+{
+	int k = (int)allowed_trips();
+	if (k >= 1) {
+		// the loop visits init, init +/- incr, ... up to and including the limit
+		if (test_op == eCmpLe) {
+			limit = init + (k - 1) * incr;
+			bound = limit;
+		} else {
+			limit = init - (k - 1) * incr;
+		}
+	}
+	return trip_count(init, limit, incr, test_op, incr_op, type);
+}
+
+double
+ExecCost::enter_loop(double trips)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	double weight = ctx.exec_weight;
+	ctx.exec_weight *= trips;
+	return weight;
+}
+
+void
+ExecCost::leave_loop(double weight)
+{
+	GenerationContext::current().exec_weight = weight;
+}
+
+void
+ExecCost::charge(double cost)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	ctx.exec_spent += ctx.exec_weight * cost;
+}
+
+bool
+ExecCost::hot(double cost)
+{
+	if (!enabled())
+		return false;
+	GenerationContext &ctx = GenerationContext::current();
+	return ctx.exec_weight * cost > CGOptions::max_exec_cost() - ctx.exec_spent;
+}
+
+bool
+ExecCost::too_hot_for_loop(void)
+{
+	return hot(2 * loop_body_guess);
+}
+
+bool
+ExecCost::too_hot_for_new_function(void)
+{
+	return hot(new_function_guess);
+}
+
+double
+ExecCost::block_cost(const Block &b)
+{
+	double cost = 0;
+	for (size_t i = 0; i < b.stms.size(); i++) {
+		cost += statement_cost(*b.stms[i]);
+	}
+	return cost;
+}
+
+double
+ExecCost::statement_cost(const Statement &s)
+{
+	size_t i;
+	// the statement itself, and the calls in its expressions
+	double cost = 1;
+	vector<const Expression*> exprs;
+	vector<const FunctionInvocationUser*> calls;
+	s.get_exprs(exprs);
+	for (i = 0; i < exprs.size(); i++) {
+		exprs[i]->get_called_funcs(calls);
+	}
+	for (i = 0; i < calls.size(); i++) {
+		if (calls[i]->get_func())
+			cost += function_cost(*calls[i]->get_func());
+	}
+
+	vector<const Block*> blks;
+	s.get_blocks(blks);
+	switch (s.get_type()) {
+	case eFor: {
+		const StatementFor &sf = static_cast<const StatementFor&>(s);
+		return 1 + sf.get_trips() * (cost + block_cost(*sf.get_body()));
+	}
+	case eArrayOp: {
+		const StatementArrayOp &sa = static_cast<const StatementArrayOp&>(s);
+		const vector<unsigned int> &sizes = sa.array_var->get_sizes();
+		double trips = 1;
+		for (i = 0; i < sizes.size(); i++) {
+			trips *= sizes[i];
+		}
+		double body = sa.body ? block_cost(*sa.body) : 0;
+		return 1 + trips * (cost + body);
+	}
+	case eIfElse: {
+		// the dearer branch
+		double branch = 0;
+		for (i = 0; i < blks.size(); i++) {
+			double c = block_cost(*blks[i]);
+			if (c > branch)
+				branch = c;
+		}
+		return cost + branch;
+	}
+	default:
+		for (i = 0; i < blks.size(); i++) {
+			cost += block_cost(*blks[i]);
+		}
+		return cost;
+	}
+}
+
+void
+ExecCost::function_built(const Function &f)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	ctx.exec_func_cost[&f] = f.body ? block_cost(*f.body) : 0;
+}
+
+double
+ExecCost::function_cost(const Function &f)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	map<const Function*, double>::const_iterator i = ctx.exec_func_cost.find(&f);
+	if (i != ctx.exec_func_cost.end())
+		return i->second;
+	// not built through Function::GenerateBody, e.g. a builtin
+	double cost = f.body ? block_cost(*f.body) : 0;
+	ctx.exec_func_cost[&f] = cost;
+	return cost;
+}
+
+double
+ExecCost::estimate(void)
+{
+	// main calls the entry function once
+	return 1 + function_cost(*GetFirstFunction());
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
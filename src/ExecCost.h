@@ -0,0 +1,105 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+/// Class Description
+///
+/// A static estimate of how long a generated program runs, in executed
+/// statements, and the "--max-exec-cost" limit built on it.  A loop costs
+/// its trip count, worked out from its constant init, limit and step when
+/// it is made, times its body; a call costs the callee's body; an `if'
+/// costs its dearer branch.  While the generator builds a program it keeps
+/// the product of the trip counts of the loops it is inside ("the weight",
+/// carried into the functions created from there) and charges every new
+/// statement and call at that weight.  When the limit is set, loops are
+/// shrunk to the trips the remaining cost allows, and loops, calls to
+/// expensive functions and new functions are skipped in contexts that are
+/// already too hot, so that a program does not spend minutes in nested
+/// loops multiplied through its call chains.
+///
+#ifndef EXEC_COST_H
+#define EXEC_COST_H
+
+#include "FunctionInvocation.h"
+#include "StatementAssign.h"
+
+class Function;
+class Block;
+class Statement;
+class Type;
+
+class ExecCost
+{
+public:
+	// true if "--max-exec-cost" is given
+	static bool enabled(void);
+
+	// the number of times a loop `for (v = init; v test_op limit; v incr_op incr)'
+	// runs its body, for a control variable of the given type; loops that
+	// wrap around or never end get a huge count
+	static double trip_count(int init, int limit, int incr, eBinaryOps test_op,
+							 eAssignOps incr_op, const Type &type);
+
+	// the trips the remaining cost allows a new loop in the current context
+	static double allowed_trips(void);
+
+	// rewrite the control of a new loop, counting away from init, so that it
+	// runs at most allowed_trips() times; returns the new trip count
+	static double shrink_loop(int &init, int &limit, int incr, eBinaryOps &test_op,
+							  eAssignOps incr_op, const Type &type);
+
+	// likewise for a loop over an array, keeping `bound' its last index
+	static double shrink_array_loop(int init, int &limit, int incr, eBinaryOps test_op,
+									eAssignOps incr_op, const Type &type, unsigned int &bound);
+
+	// enter a loop body that runs `trips' times; returns the weight to restore
+	static double enter_loop(double trips);
+	static void leave_loop(double weight);
+
+	// charge the cost of something executed once per run of the current context
+	static void charge(double cost);
+
+	// true if something that costs `cost' does not fit in the current context
+	static bool hot(double cost);
+	static bool too_hot_for_loop(void);
+	static bool too_hot_for_new_function(void);
+
+	// cost the body of a function that has just been built
+	static void function_built(const Function &f);
+
+	// estimated statements executed by one call of `f'
+	static double function_cost(const Function &f);
+
+	// estimated statements executed by the whole program
+	static double estimate(void);
+
+private:
+	static double block_cost(const Block &b);
+	static double statement_cost(const Statement &s);
+};
+
+#endif // EXEC_COST_H
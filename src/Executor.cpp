@@ -0,0 +1,408 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+#include "Executor.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "platform.h"
+
+extern char **environ;
+
+using namespace std;
+
+#if defined(__linux__) && defined(SYS_memfd_create)
+#define HAVE_MEMFD 1
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#endif
+
+#if defined(__linux__) && defined(SYS_pidfd_open)
+#define HAVE_PIDFD 1
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A file that lives in memory where possible, and an unlinked temporary
+// file otherwise
+static int
+anonymous_file(const char *name)
+{
+#ifdef HAVE_MEMFD
+	int fd = static_cast<int>(syscall(SYS_memfd_create, name, MFD_CLOEXEC));
+	if (fd != -1)
+		return fd;
+#endif
+	const char *dir = getenv("TMPDIR");
+	string path = string(dir ? dir : "/tmp") + "/" + name + ".XXXXXX";
+	vector<char> buf(path.begin(), path.end());
+	buf.push_back('\0');
+	int tmp = mkstemp(&buf[0]);
+	if (tmp != -1) {
+		unlink(&buf[0]);
+		fcntl(tmp, F_SETFD, FD_CLOEXEC);
+	}
+	return tmp;
+}
+
+// The program args[0] names, looked up in $PATH if it has no slash, as
+// the child may only make async-signal-safe calls
+static string
+find_program(const string &name)
+{
+	if (name.find('/') != string::npos)
+		return name;
+	const char *path = getenv("PATH");
+	string dirs = path ? path : "/bin:/usr/bin";
+	size_t pos = 0;
+	for (;;) {
+		size_t end = dirs.find(':', pos);
+		string dir = dirs.substr(pos, end == string::npos ? string::npos : end - pos);
+		string file = (dir.empty() ? "." : dir) + "/" + name;
+		if (access(file.c_str(), X_OK) == 0)
+			return file;
+		if (end == string::npos)
+			return name;
+		pos = end + 1;
+	}
+}
+
+static void
+set_limit(int resource, unsigned long limit)
+{
+	struct rlimit rl;
+	rl.rlim_cur = limit;
+	rl.rlim_max = limit;
+	setrlimit(resource, &rl);
+}
+
+// The child side of Executor::run: a process group of its own, so that a
+// timeout kills everything it starts, the signals the parent may ignore
+// back to normal, and the limits in place before the program runs.  With
+// the hard CPU limit equal to the soft one, Linux kills with SIGKILL, as
+// "ulimit -t" in RunSafely does.  Only async-signal-safe calls, as the
+// child shares the memory of the parent until the exec
+static void
+exec_child(const char *program, char *const argv[], char *const envp[],
+		   const char *input_file, int capture, const char *output_file,
+		   const Executor::Limits &limits, volatile int *exec_errno)
+{
+	setpgid(0, 0);
+	int in = open(input_file, O_RDONLY);
+	if (in != -1 && in != 0) {
+		dup2(in, 0);
+		close(in);
+	}
+	if (capture != -1) {
+		dup2(capture, 1);
+	} else {
+		int out = open(output_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (out != -1 && out != 1) {
+			dup2(out, 1);
+			close(out);
+		}
+	}
+	dup2(1, 2);
+	signal(SIGPIPE, SIG_DFL);
+	signal(SIGINT, SIG_DFL);
+	signal(SIGTERM, SIG_DFL);
+	if (limits.cpu)
+		set_limit(RLIMIT_CPU, limits.cpu);
+	if (limits.memory)
+		set_limit(RLIMIT_AS, limits.memory);
+	if (limits.file_size)
+		set_limit(RLIMIT_FSIZE, limits.file_size);
+	sigset_t none;
+	sigemptyset(&none);
+	sigprocmask(SIG_SETMASK, &none, NULL);
+	execve(program, argv, envp);
+	*exec_errno = errno ? errno : ENOEXEC;
+	_exit(127);
+}
+
+// vfork, and exec in the child; on a failed exec, exec_errno is set
+static pid_t
+spawn(const char *program, char *const argv[], char *const envp[],
+	  const char *input_file, int capture, const char *output_file,
+	  const Executor::Limits &limits, volatile int *exec_errno)
+{
+	pid_t pid = vfork();
+	if (pid == 0)
+		exec_child(program, argv, envp, input_file, capture, output_file, limits, exec_errno);
+	return pid;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Executor::Result::Result(void)
+	: started(false),
+	  timed_out(false),
+	  exit_code(-1),
+	  signal(0),
+	  user_secs(0),
+	  sys_secs(0),
+	  wall_usecs(0),
+	  max_rss_kb(0)
+{
+}
+
+int
+Executor::Result::shell_status(void) const
+{
+	if (!started)
+		return 127;
+	return signal ? 128 + signal : exit_code;
+}
+
+Executor::Executor(void)
+	: capture_fd_(-1)
+{
+}
+
+Executor::~Executor(void)
+{
+	if (capture_fd_ != -1)
+		close(capture_fd_);
+	for (size_t i = 0; i < memory_fds_.size(); i++)
+		close(memory_fds_[i]);
+}
+
+int
+Executor::capture_fd(void)
+{
+	if (capture_fd_ == -1)
+		capture_fd_ = anonymous_file("csmith-output");
+	if (capture_fd_ != -1) {
+		if (ftruncate(capture_fd_, 0) != 0 || lseek(capture_fd_, 0, SEEK_SET) != 0) {
+			close(capture_fd_);
+			capture_fd_ = -1;
+		}
+	}
+	return capture_fd_;
+}
+
+bool
+Executor::run(const vector<string> &args, const vector<string> &env,
+			  const Limits &limits, Result &result,
+			  const string &input, const string &output)
+{
+	result = Result();
+	captured_.clear();
+	if (args.empty())
+		return false;
+
+	vector<char *> argv;
+	for (size_t i = 0; i < args.size(); i++)
+		argv.push_back(const_cast<char *>(args[i].c_str()));
+	argv.push_back(NULL);
+	// the added variables come first, so that they win
+	vector<char *> envp;
+	for (size_t i = 0; i < env.size(); i++)
+		envp.push_back(const_cast<char *>(env[i].c_str()));
+	for (char **e = environ; *e; e++)
+		envp.push_back(*e);
+	envp.push_back(NULL);
+
+	int fd = -1;
+	if (output.empty()) {
+		fd = capture_fd();
+		if (fd == -1)
+			return false;
+	}
+
+	string program = find_program(args[0]);
+	const char *input_file = input.empty() ? "/dev/null" : input.c_str();
+	const char *output_file = output.c_str();
+
+	// No signal handler of this process may run in the child, which shares
+	// its memory until the exec
+	sigset_t all, old_mask;
+	sigfillset(&all);
+	pthread_sigmask(SIG_SETMASK, &all, &old_mask);
+
+	unsigned long long start = platform_get_usecs();
+	volatile int exec_errno = 0;
+	pid_t pid = spawn(program.c_str(), &argv[0], &envp[0], input_file, fd, output_file, limits, &exec_errno);
+	pthread_sigmask(SIG_SETMASK, &old_mask, NULL);
+	if (pid == -1)
+		return false;
+	if (exec_errno) {
+		int status;
+		while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+			;
+		return false;
+	}
+	result.started = true;
+
+	unsigned long long deadline = limits.timeout ? start + limits.timeout * 1000000ULL : 0;
+	int status = 0;
+	struct rusage ru;
+	memset(&ru, 0, sizeof(ru));
+	bool reaped = false;
+
+#ifdef HAVE_PIDFD
+	// the pidfd becomes readable when the child exits, without reaping it
+	int pidfd = static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+	if (pidfd != -1) {
+		for (;;) {
+			int wait_ms = -1;
+			if (deadline) {
+				unsigned long long now = platform_get_usecs();
+				if (now >= deadline) {
+					result.timed_out = true;
+					break;
+				}
+				wait_ms = static_cast<int>((deadline - now + 999) / 1000);
+			}
+			struct pollfd p;
+			p.fd = pidfd;
+			p.events = POLLIN;
+			int r = poll(&p, 1, wait_ms);
+			if (r > 0 || (r == -1 && errno != EINTR))
+				break;
+		}
+		close(pidfd);
+	} else
+#endif
+	{
+		useconds_t delay = 500;
+		for (;;) {
+			pid_t r = wait4(pid, &status, WNOHANG, &ru);
+			if (r == pid || (r == -1 && errno != EINTR)) {
+				reaped = true;
+				break;
+			}
+			if (deadline && platform_get_usecs() >= deadline) {
+				result.timed_out = true;
+				break;
+			}
+			usleep(delay);
+			if (delay < 20000)
+				delay *= 2;
+		}
+	}
+
+	// Until the child is reaped its pid stays taken, so its group can still
+	// be killed safely: on a timeout, and for whatever it left behind
+	if (!reaped) {
+		kill(-pid, SIGKILL);
+		while (wait4(pid, &status, 0, &ru) == -1 && errno == EINTR)
+			;
+	}
+	result.wall_usecs = platform_get_usecs() - start;
+
+	if (WIFSIGNALED(status)) {
+		result.signal = WTERMSIG(status);
+	} else if (WIFEXITED(status)) {
+		result.exit_code = WEXITSTATUS(status);
+	}
+	result.user_secs = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+	result.sys_secs = ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+	result.max_rss_kb = ru.ru_maxrss;
+#ifdef __APPLE__
+	// bytes, not kilobytes
+	result.max_rss_kb /= 1024;
+#endif
+
+	if (fd != -1) {
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_size > 0) {
+			captured_.resize(static_cast<size_t>(st.st_size));
+			ssize_t n = pread(fd, &captured_[0], captured_.size(), 0);
+			captured_.resize(n > 0 ? static_cast<size_t>(n) : 0);
+		}
+	}
+	return true;
+}
+
+bool
+Executor::run_shell(const string &command, const Limits &limits, Result &result, const string &output)
+{
+	vector<string> args;
+	args.push_back("/bin/sh");
+	args.push_back("-c");
+	args.push_back(command);
+	return run(args, vector<string>(), limits, result, "", output);
+}
+
+string
+Executor::load_in_memory(const string &file)
+{
+#ifdef HAVE_MEMFD
+	int in = open(file.c_str(), O_RDONLY);
+	if (in == -1)
+		return file;
+	int fd = static_cast<int>(syscall(SYS_memfd_create, "csmith-exe", MFD_CLOEXEC));
+	bool ok = (fd != -1);
+	char buf[65536];
+	ssize_t n;
+	while (ok && (n = read(in, buf, sizeof(buf))) != 0) {
+		ok = (n > 0 && write(fd, buf, n) == n);
+	}
+	close(in);
+	if (!ok) {
+		if (fd != -1)
+			close(fd);
+		return file;
+	}
+	memory_fds_.push_back(fd);
+	// the path of this process's descriptor, so that the child can open it
+	// after its own copy is closed on exec
+	ostringstream path;
+	path << "/proc/" << getpid() << "/fd/" << fd;
+	return path.str();
+#else
+	return file;
+#endif
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
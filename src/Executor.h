@@ -0,0 +1,119 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+/// Class Description
+///
+/// Runs a test program or a compiler for the drivers (csmith-test,
+/// csmith-exec), with a wall-clock timeout, CPU, memory and file size
+/// limits, and the resource usage of the run.  The process is started
+/// with vfork and execve, in a process group of its own so that a timeout
+/// kills everything it started, and with its limits set before the exec.
+/// On Linux, the timeout waits on a pidfd and the
+/// output is captured in a memfd, so a run touches neither the work
+/// directory nor a polling loop; elsewhere, a temporary file and polling
+/// take their place.  The child is reaped with wait4, for its CPU time and
+/// peak RSS.
+///
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <string>
+#include <vector>
+#include "CommonMacros.h"
+
+class Executor
+{
+public:
+	struct Limits {
+		// wall-clock seconds; 0 for none
+		unsigned int timeout;
+		// CPU seconds, address space and file size in bytes; 0 for none
+		unsigned long cpu;
+		unsigned long memory;
+		unsigned long file_size;
+
+		Limits(void) : timeout(0), cpu(0), memory(0), file_size(0) {}
+	};
+
+	struct Result {
+		bool started;
+		bool timed_out;
+		// the exit code, or -1 if the program was killed by a signal
+		int exit_code;
+		int signal;
+		double user_secs;
+		double sys_secs;
+		unsigned long long wall_usecs;
+		// peak resident set size in kilobytes
+		long max_rss_kb;
+
+		Result(void);
+
+		// the exit status as a shell reports it, with 128 + the signal
+		int shell_status(void) const;
+	};
+
+	Executor(void);
+
+	~Executor(void);
+
+	// Run args[0] (searched for in $PATH if it has no slash) with args as
+	// its arguments.  env is added to the environment of this process.
+	// Standard input comes from input (/dev/null if empty).  Standard output
+	// and error go to output if it is given, and are captured otherwise
+	bool run(const std::vector<std::string> &args, const std::vector<std::string> &env,
+			 const Limits &limits, Result &result,
+			 const std::string &input = "", const std::string &output = "");
+
+	// what the last run wrote, if it was captured
+	const std::string &captured(void) const { return captured_; }
+
+	// run a command line with /bin/sh
+	bool run_shell(const std::string &command, const Limits &limits, Result &result,
+				   const std::string &output = "");
+
+	// Copy an executable into memory, for runs that should not depend on
+	// the file: the returned path names the copy as long as this executor
+	// lives.  Returns the file itself where that is not possible
+	std::string load_in_memory(const std::string &file);
+
+private:
+	int capture_fd(void);
+
+	std::string captured_;
+
+	// the file the output of a run is captured in, kept for the next run
+	int capture_fd_;
+
+	// the executables loaded in memory
+	std::vector<int> memory_fds_;
+
+	DISALLOW_COPY_AND_ASSIGN(Executor);
+};
+
+#endif // EXECUTOR_H
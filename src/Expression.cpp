@@ -57,38 +57,52 @@
 #include "random.h"
 #include "TypeQualifiers.h" 
 #include "AbsOutputMgr.h"
+#include "GenerationContext.h"
+#include "ProgramSize.h"
+#include "GenerationBudget.h"
 
-int eid = 0;
+static inline int &eid(void) { return GenerationContext::current().expr_eid; }
 
-DistributionTable Expression::exprTable_;
-DistributionTable Expression::paramTable_;
+DistributionTable &
+Expression::exprTable_(void)
+{
+	return GenerationContext::current().expr_table;
+}
+
+DistributionTable &
+Expression::paramTable_(void)
+{
+	return GenerationContext::current().param_table;
+}
 
 void
 Expression::InitExprProbabilityTable()
 { 
-	exprTable_.add_entry((int)eFunction, 70);  
-	exprTable_.add_entry((int)eVariable, 20);
-	exprTable_.add_entry((int)eConstant, 10);
+	exprTable_().clear();
+	exprTable_().add_entry((int)eFunction, 70);  
+	exprTable_().add_entry((int)eVariable, 20);
+	exprTable_().add_entry((int)eConstant, 10);
 	if (CGOptions::use_embedded_assigns()) {
-		exprTable_.add_entry((int)eAssignment, 10);
+		exprTable_().add_entry((int)eAssignment, 10);
 	}
 	if (CGOptions::use_comma_exprs()) {
-		exprTable_.add_entry((int)eCommaExpr, 10);
+		exprTable_().add_entry((int)eCommaExpr, 10);
 	}
 }
 
 void
 Expression::InitParamProbabilityTable()
 {
-	paramTable_.add_entry((int)eFunction, 40);  
-	paramTable_.add_entry((int)eVariable, 40);
+	paramTable_().clear();
+	paramTable_().add_entry((int)eFunction, 40);  
+	paramTable_().add_entry((int)eVariable, 40);
 	// constant parameters lead to non-interesting code 
-	paramTable_.add_entry((int)eConstant, 0);  
+	paramTable_().add_entry((int)eConstant, 0);  
 	if (CGOptions::use_embedded_assigns()) {
-		paramTable_.add_entry((int)eAssignment, 10);
+		paramTable_().add_entry((int)eAssignment, 10);
 	}
 	if (CGOptions::use_comma_exprs()) {
-		paramTable_.add_entry((int)eCommaExpr, 10);
+		paramTable_().add_entry((int)eCommaExpr, 10);
 	}
 }
 
@@ -99,6 +113,12 @@ Expression::InitProbabilityTables()
 	Expression::InitParamProbabilityTable();
 }
 
+void
+Expression::doFinalization(void)
+{
+	eid() = 0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /*
@@ -151,7 +171,7 @@ Expression::make_random(CGContext &cg_context, const Type* type, const TypeQuali
 	 
 	// if no term type is provided, choose a random term type with restrictions
 	if (tt == MAX_TERM_TYPES) {
-		VectorFilter filter(&Expression::exprTable_);
+		VectorFilter filter(&Expression::exprTable_());
 		if (no_func || 
 			(!CGOptions::return_structs() && type->eType == eStruct) ||
 			(!CGOptions::return_unions() && type->eType == eUnion)) {
@@ -166,7 +186,9 @@ Expression::make_random(CGContext &cg_context, const Type* type, const TypeQuali
 		if (type->is_const_struct_union() || type->is_volatile_struct_union()) {
 			filter.add(eAssignment);
 		}
-		if (cg_context.expr_depth + 2 > CGOptions::max_expr_depth()) {
+		// past the size target or the budget, keep the nested expressions simple
+		if ((cg_context.expr_depth + 2 > CGOptions::max_expr_depth()) ||
+		    (cg_context.expr_depth > 0 && (ProgramSize::target_reached() || GenerationBudget::exhausted()))) {
 			filter.add(eFunction).add(eAssignment).add(eCommaExpr);
 		}
 		tt = ExpressionTypeProbability(&filter); 
@@ -227,7 +249,7 @@ Expression::make_random_param(CGContext &cg_context, const Type* type, const Typ
 	assert(type);
 	// if a term type is provided, no need to choose random term type
 	if (tt == MAX_TERM_TYPES) {
-		VectorFilter filter(&Expression::paramTable_);
+		VectorFilter filter(&Expression::paramTable_());
 		filter.add(eConstant);   // don't call functions with constant parameters because it is not interesting
 		if ((!CGOptions::return_structs() && type->eType == eStruct) ||
 			(!CGOptions::return_unions() && type->eType == eUnion)) {
@@ -236,7 +258,9 @@ Expression::make_random_param(CGContext &cg_context, const Type* type, const Typ
 		if (type->is_const_struct_union()) {
 			filter.add(eAssignment);
 		}
-		if (cg_context.expr_depth + 2 > CGOptions::max_expr_depth()) {
+		// past the size target or the budget, keep the nested expressions simple
+		if ((cg_context.expr_depth + 2 > CGOptions::max_expr_depth()) ||
+		    (cg_context.expr_depth > 0 && (ProgramSize::target_reached() || GenerationBudget::exhausted()))) {
 			filter.add(eFunction).add(eAssignment).add(eCommaExpr);
 		}
 		tt = ExpressionTypeProbability(&filter);
@@ -278,7 +302,7 @@ Expression::make_random_param(CGContext &cg_context, const Type* type, const Typ
  */
 Expression::Expression(eTermType e) :
 	term_type(e),
-	expr_id(eid++),
+	expr_id(eid()++),
 	cast_type(NULL)
 {
 	// Nothing to do.
@@ -100,6 +100,8 @@ public:
 
 	static void InitProbabilityTables();
 
+	static void doFinalization(void);
+
 	Expression(eTermType e);
 
 	Expression(const Expression &expr);
@@ -156,8 +158,8 @@ private:
 	static void InitExprProbabilityTable();
 	static void InitParamProbabilityTable();
 
-	static DistributionTable exprTable_;
-	static DistributionTable paramTable_;
+	static DistributionTable &exprTable_(void);
+	static DistributionTable &paramTable_(void);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -106,7 +106,7 @@ ExpressionVariable::make_random(CGContext &cg_context, const Type* type, const T
 	// statistics
 	int deref_level = ev->get_indirect_level();
 	if (deref_level > 0) {
-		incr_counter(Bookkeeper::read_dereference_cnts, deref_level); 
+		incr_counter(Bookkeeper::read_dereference_cnts(), deref_level); 
 	}
 	if (deref_level < 0) {
 		Bookkeeper::record_address_taken(ev->get_var());
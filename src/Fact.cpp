@@ -35,9 +35,14 @@
 #include "ArrayVariable.h"
 #include "StatementAssign.h"
 #include "StatementReturn.h"
+#include "GenerationContext.h"
 
 using namespace std; 
-std::vector<Fact*> Fact::facts_;
+std::vector<Fact*> &
+Fact::facts_(void)
+{
+	return GenerationContext::current().facts;
+}
  
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -90,10 +95,27 @@ void
 Fact::doFinalization()
 {
 	std::vector<Fact*>::iterator i;
-	for( i = facts_.begin(); i != facts_.end(); ++i) {
+	for( i = facts_().begin(); i != facts_().end(); ++i) {
 		delete (*i);
 	}
-	facts_.clear();
+	facts_().clear();
+}
+
+size_t
+Fact::pool_size(void)
+{
+	return facts_().size();
+}
+
+void
+Fact::trim_pool(size_t size)
+{
+	std::vector<Fact*> &facts = facts_();
+	for (size_t i = size; i < facts.size(); i++) {
+		delete facts[i];
+	}
+	if (size < facts.size())
+		facts.resize(size);
 }
 
 // fact manipulating functions
@@ -96,11 +96,16 @@ public:
 
 	static void doFinalization();
 
+	// the number of facts created so far, and a way to free the ones
+	// created since then once nothing refers to them any more
+	static size_t pool_size(void);
+	static void trim_pool(size_t size);
+
 	enum eFactCategory eCat;
 
 protected: 
 	// keep track all created facts. used for releasing memory in doFinalization
-	static std::vector<Fact*> facts_;
+	static std::vector<Fact*> &facts_(void);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -59,10 +59,15 @@
 #include "Lhs.h"
 #include "CFGEdge.h"
 #include "AbsOutputMgr.h"
+#include "GenerationContext.h"
 
 using namespace std; 
  
-std::vector<Fact*> FactMgr::meta_facts;
+std::vector<Fact*> &
+FactMgr::meta_facts(void)
+{
+	return GenerationContext::current().meta_facts;
+}
 
 void
 FactMgr::add_new_var_fact_and_update_inout_maps(const Block* blk, const Variable* var)
@@ -72,8 +77,8 @@ FactMgr::add_new_var_fact_and_update_inout_maps(const Block* blk, const Variable
 	}
 	// var is global if blk == 0, we add fact to all blocks of this function
 	// otherwise, only add fact to blocks equal or below blk (variable is declared in blk)  
-	for (size_t i=0; i<FactMgr::meta_facts.size(); i++) { 
-		FactVec facts = FactMgr::meta_facts[i]->abstract_fact_for_var_init(var); 
+	for (size_t i=0; i<FactMgr::meta_facts().size(); i++) { 
+		FactVec facts = FactMgr::meta_facts()[i]->abstract_fact_for_var_init(var); 
 		for (size_t k=0; k<facts.size(); k++) {
 			const Fact* f = facts[k];
 			// sometimes the facts is already included during the creation of child
@@ -117,8 +122,8 @@ void
 FactMgr::add_new_var_fact(const Variable* v, FactVec& facts)
 {
 	assert(v);
-	for (size_t i=0; i<FactMgr::meta_facts.size(); i++) { 
-		FactVec tmp_facts = FactMgr::meta_facts[i]->abstract_fact_for_var_init(v);   
+	for (size_t i=0; i<FactMgr::meta_facts().size(); i++) { 
+		FactVec tmp_facts = FactMgr::meta_facts()[i]->abstract_fact_for_var_init(v);   
 		for (size_t k=0; k<tmp_facts.size(); k++) {
 			const Fact* f = tmp_facts[k];
 			// sometimes the facts is already included during the creation of child
@@ -382,8 +387,8 @@ bool
 FactMgr::update_fact_for_assign(const Lhs* lhs, const Expression* rhs, FactVec& inputs)
 {
 	bool changed = false;
-    for (size_t i=0; i<FactMgr::meta_facts.size(); i++) {
-        vector<const Fact*> facts = FactMgr::meta_facts[i]->abstract_fact_for_assign(inputs, lhs, rhs);
+    for (size_t i=0; i<FactMgr::meta_facts().size(); i++) {
+        vector<const Fact*> facts = FactMgr::meta_facts()[i]->abstract_fact_for_assign(inputs, lhs, rhs);
 		if (facts.size() == 1 && !facts[0]->get_var()->isArray) { 
 			// for must-point-to fact concerning no-array variable, just renew the old fact
 			renew_fact(inputs, facts[0]); 
@@ -416,8 +421,8 @@ void
 FactMgr::update_fact_for_return(const StatementReturn* sr, FactVec& inputs)
 {
 	size_t i, j;
-    for (i=0; i<FactMgr::meta_facts.size(); i++) {
-        std::vector<const Fact*> facts = FactMgr::meta_facts[i]->abstract_fact_for_return(inputs, sr->get_var(), sr->func);
+    for (i=0; i<FactMgr::meta_facts().size(); i++) {
+        std::vector<const Fact*> facts = FactMgr::meta_facts()[i]->abstract_fact_for_return(inputs, sr->get_var(), sr->func);
 		for (j=0; j<facts.size(); j++) {
 			// merge with other return statements
 			if (merge_fact(inputs, facts[j])) {
@@ -495,11 +500,11 @@ FactMgr::add_interested_facts(int interests)
         //meta_facts.push_back(new FactPointTo(0));
         //meta_facts.push_back(FactPointTo::make_fact(0));
         FactPointTo *fp = FactPointTo::make_fact(0);
-        meta_facts.push_back(fp);
+        meta_facts().push_back(fp);
 	}
 	if (interests & eUnionWrite) {
 		FactUnion *fu = FactUnion::make_fact(0, 0);
-		meta_facts.push_back(fu);
+		meta_facts().push_back(fu);
     } 
 } 
 
@@ -738,7 +743,7 @@ void
 FactMgr::doFinalization()
 {
 	Fact::doFinalization();
-	meta_facts.clear();
+	meta_facts().clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
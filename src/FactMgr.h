@@ -136,7 +136,7 @@ public:
 	
 	void sanity_check_map() const;
 
-	static std::vector<Fact*> meta_facts; 
+	static std::vector<Fact*> &meta_facts(void);
 
 	// maps to track facts and effects at historical generation points.
 	// they are used for bypassing analyzing statements if possible 
@@ -50,6 +50,7 @@
 #include "AbsOutputMgr.h"
 #include "Lhs.h"
 #include "random.h"
+#include "GenerationContext.h"
 
 #include <assert.h>
 
@@ -61,8 +62,18 @@ using namespace std;
 const Variable* FactPointTo::null_ptr = VariableSelector::make_dummy_static_variable("null");
 const Variable* FactPointTo::garbage_ptr = VariableSelector::make_dummy_static_variable("garbage");
 const Variable* FactPointTo::tbd_ptr = VariableSelector::make_dummy_static_variable("tbd");
-vector<const Variable*> FactPointTo::all_ptrs;
-vector<vector<const Variable*> > FactPointTo::all_aliases;
+
+vector<const Variable*> &
+FactPointTo::all_ptrs(void)
+{
+	return GenerationContext::current().all_ptrs;
+}
+
+vector<vector<const Variable*> > &
+FactPointTo::all_aliases(void)
+{
+	return GenerationContext::current().all_aliases;
+}
 
 bool
 FactPointTo::is_null() const 
@@ -303,7 +314,7 @@ Fact*
 FactPointTo::clone(void) const
 {
 	FactPointTo *fact = new FactPointTo(var, point_to_vars);
-	facts_.push_back(fact);
+	facts_().push_back(fact);
 	return fact;
 }
 
@@ -311,7 +322,7 @@ FactPointTo *
 FactPointTo::make_fact(const Variable *v)
 {
 	FactPointTo *fact = new FactPointTo(v);
-	facts_.push_back(fact);
+	facts_().push_back(fact);
 	return fact;
 }
 
@@ -319,7 +330,7 @@ FactPointTo *
 FactPointTo::make_fact(const Variable* v, const vector<const Variable*>& set)
 {
 	FactPointTo *fact = new FactPointTo(v, set);
-	facts_.push_back(fact);
+	facts_().push_back(fact);
 	return fact;
 }
 
@@ -327,7 +338,7 @@ FactPointTo *
 FactPointTo::make_fact(const Variable* v, const Variable* point_to)
 {
 	FactPointTo *fact = new FactPointTo(v, point_to);
-	facts_.push_back(fact);
+	facts_().push_back(fact);
 	return fact;
 }
 
@@ -411,6 +422,17 @@ FactPointTo::~FactPointTo(void)
 	// Nothing else to do.
 }
 
+/*
+ * forget the pointer alias statistics of the current program. the facts
+ * themselves are owned by Fact::facts_
+ */
+void
+FactPointTo::doFinalization(void)
+{
+	all_ptrs().clear();
+	all_aliases().clear();
+}
+
 /*
  * return 1 if v (or a field of v) is in the point-to set
  */
@@ -790,10 +812,10 @@ FactPointTo::aggregate_all_pointto_sets(void)
 		FactMgr* fm = get_fact_mgr_for_func(funcs[i]);
 		map<const Statement*, vector<Fact*> >::iterator iter; 
 		for(iter = fm->map_facts_out_final.begin(); iter != fm->map_facts_out_final.end(); ++iter) { 
-			update_ptr_aliases(iter->second, all_ptrs, all_aliases);
+			update_ptr_aliases(iter->second, all_ptrs(), all_aliases());
 		} 
 	}
-	assert(all_ptrs.size() == all_aliases.size());
+	assert(all_ptrs().size() == all_aliases().size());
 }
 
 /* find union fields that are referred to by this expression */
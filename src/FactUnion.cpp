@@ -156,7 +156,7 @@ Fact*
 FactUnion::clone(void) const
 {
 	FactUnion *fact = new FactUnion(var, last_written_fid);
-	facts_.push_back(fact);
+	facts_().push_back(fact);
 	return fact;
 }
 
@@ -165,7 +165,7 @@ FactUnion::make_fact(const Variable* v, int fid)
 {
 	assert(v == NULL || v->type->eType == eUnion);
 	FactUnion *fact = new FactUnion(v, fid);
-	facts_.push_back(fact);
+	facts_().push_back(fact);
 	return fact;
 } 
 
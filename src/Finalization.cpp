@@ -37,6 +37,13 @@
 #include "Bookkeeper.h"
 #include "Probabilities.h"
 #include "StatementGoto.h"
+#include "Statement.h"
+#include "Expression.h"
+#include "FactPointTo.h"
+#include "SafeOpFlags.h"
+#include "Profiler.h"
+#include "MemoryAccounting.h"
+#include "util.h"
 
 void
 Finalization::doFinalization()
@@ -49,5 +56,13 @@ Finalization::doFinalization()
 	FunctionInvocationUser::doFinalization();
 	Probabilities::DestroyInstance();
 	StatementGoto::doFinalization();
+	Statement::doFinalization();
+	Expression::doFinalization();
+	FactPointTo::doFinalization();
+	SafeOpFlags::doFinalization();
+	Bookkeeper::doFinalization();
+	Profiler::doFinalization();
+	MemoryAccounting::doFinalization();
+	reset_gensym();
 }
 
@@ -58,6 +58,12 @@
 #include "FactPointTo.h"
 #include "FactMgr.h"
 #include "VectorFilter.h"
+#include "Profiler.h"
+#include "MemoryAccounting.h"
+#include "ProgramSize.h"
+#include "GenerationBudget.h"
+#include "ExecCost.h"
+#include "GenerationContext.h"
 
 #include "AbsOutputMgr.h"
 
@@ -65,10 +71,13 @@ using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static vector<Function*> FuncList;		// List of all functions in the program
-static vector<FactMgr*>  FMList;        // list of fact managers for each function
-static long cur_func_idx;				// Index into FuncList that we are currently working on 
-static int builtin_functions_cnt;
+// List of all functions in the program
+static inline vector<Function*> &FuncList(void) { return GenerationContext::current().func_list; }
+// list of fact managers for each function
+static inline vector<FactMgr*> &FMList(void) { return GenerationContext::current().fact_mgrs; }
+// Index into FuncList that we are currently working on 
+static inline long &cur_func_idx(void) { return GenerationContext::current().cur_func_idx; }
+static inline int &builtin_functions_cnt(void) { return GenerationContext::current().builtin_functions_cnt; }
 
 /*
  * find FactMgr for a function
@@ -76,9 +85,9 @@ static int builtin_functions_cnt;
 FactMgr* 
 get_fact_mgr_for_func(const Function* func)
 {
-	for (size_t i=0; i<FuncList.size(); i++) {
-		if (FuncList[i] == func) {
-			return FMList[i];
+	for (size_t i=0; i<FuncList().size(); i++) {
+		if (FuncList()[i] == func) {
+			return FMList()[i];
 		}
 	}
     return 0; 
@@ -97,9 +106,9 @@ const Function*
 find_function_by_name(const string& name)
 {
 	size_t i;
-	for (i=0; i<FuncList.size(); i++) {
-		if (FuncList[i]->name == name) {
-			return FuncList[i];
+	for (i=0; i<FuncList().size(); i++) {
+		if (FuncList()[i]->name == name) {
+			return FuncList()[i];
 		}
 	}
 	return NULL;
@@ -124,8 +133,8 @@ find_blk_for_var(const Variable* v)
 		return NULL;
 	}
 	size_t i, j;
-	for (i=0; i<FuncList.size(); i++) {
-		const Function* func = FuncList[i];
+	for (i=0; i<FuncList().size(); i++) {
+		const Function* func = FuncList()[i];
 		// for a parameter of a function, pretend it's a variable belongs to the top block
 		if (v->is_argument() && find_variable_in_set(func->param, v) != -1) {
 			return func->body;
@@ -191,13 +200,16 @@ Function::is_var_oos(const Variable* var, const Statement* stm) const
 bool 
 Function::reach_max_functions_cnt()
 {
-	return ((static_cast<int>(FuncList.size()) - builtin_functions_cnt) >= CGOptions::max_funcs());
+	return ((static_cast<int>(FuncList().size()) - builtin_functions_cnt()) >= CGOptions::max_funcs())
+		|| MemoryAccounting::limit_reached()
+		|| ProgramSize::target_reached()
+		|| GenerationBudget::exhausted();
 }
 
 const vector<Function*>& 
 get_all_functions(void)
 {
-	return FuncList;
+	return FuncList();
 }
  
 /*
@@ -207,7 +219,7 @@ get_all_functions(void)
 long
 FuncListSize(void)
 {
-	return FuncList.size();
+	return FuncList().size();
 }
 
 /*
@@ -216,8 +228,8 @@ FuncListSize(void)
 Function *
 GetFirstFunction(void)
 {
-	assert((builtin_functions_cnt >= 0) && "Invalid builtin_functions_cnt!");
-	return FuncList[builtin_functions_cnt];
+	assert((builtin_functions_cnt() >= 0) && "Invalid builtin_functions_cnt!");
+	return FuncList()[builtin_functions_cnt()];
 }
 
 /*
@@ -286,6 +298,10 @@ Function::choose_func(vector<Function *> funcs,
 		if (cg_context.in_conflict((*i)->get_feffect())) {
 			continue;
 		}
+		// nor one that would run too often for "--max-exec-cost"
+		if (ExecCost::hot(ExecCost::function_cost(**i))) {
+			continue;
+		}
 		if (CGOptions::strict_volatile_rule()) {
 			if (!((*i)->get_feffect().is_side_effect_free())
 			    && !cg_context.get_effect_context().is_side_effect_free()) {
@@ -383,7 +399,7 @@ Function::Function(const string &name, const Type *return_type)
 	  visited_cnt(0),
 	  build_state(UNBUILT)
 {
-	FuncList.push_back(this);			// Add to global list of functions.
+	FuncList().push_back(this);			// Add to global list of functions.
 }
 
 Function::Function(const string &name, const Type *return_type, bool builtin)
@@ -397,7 +413,7 @@ Function::Function(const string &name, const Type *return_type, bool builtin)
 	  visited_cnt(0),
 	  build_state(UNBUILT)
 {
-	FuncList.push_back(this);			// Add to global list of functions.
+	FuncList().push_back(this);			// Add to global list of functions.
 }
 
 Function *
@@ -415,7 +431,7 @@ Function::make_random_signature(const CGContext& cg_context, const Type* type, c
 	
 	f->rv = Variable::CreateVariable(rvname, type, NULL, &ret_qfer);
 	GenerateParameterList(*f); 
-	FMList.push_back(new FactMgr(f));
+	FMList().push_back(new FactMgr(f));
 	if (CGOptions::inline_function() && rnd_flipcoin(InlineFunctionProb))
 		f->is_inlined = true;
 	return f;
@@ -452,7 +468,7 @@ Function::make_first(void)
 
 	// create a fact manager for this function, with empty global facts 
 	FactMgr* fm = new FactMgr(f);
-	FMList.push_back(fm);
+	FMList().push_back(fm);
 
 	// No Parameter List
 	f->GenerateBody(CGContext::get_empty_context());
@@ -511,6 +527,7 @@ Function::GenerateBody(const CGContext &prev_context)
 	}
 
 	build_state = BUILDING;
+	ProfileScope scope("GenerateBody", name);
 	Effect effect_accum; 
 	CGContext cg_context(this, prev_context.get_effect_context(), &effect_accum);
 	cg_context.extend_call_chain(prev_context);
@@ -542,6 +559,10 @@ Function::GenerateBody(const CGContext &prev_context)
 	
 	// Mark this function as built.
 	build_state = BUILT;
+	if (ProgramSize::enabled())
+		ProgramSize::function_built(*this);
+	if (ExecCost::enabled())
+		ExecCost::function_built(*this);
 }
 
 void
@@ -553,6 +574,7 @@ Function::generate_body_with_known_params(const CGContext &prev_context, Effect&
 	}
 
 	build_state = BUILDING;
+	ProfileScope scope("GenerateBody", name);
 	FactMgr* fm = get_fact_mgr_for_func(this); 
 	CGContext cg_context(this, prev_context.get_effect_context(), &effect_accum);
 	cg_context.extend_call_chain(prev_context);
@@ -577,6 +599,10 @@ Function::generate_body_with_known_params(const CGContext &prev_context, Effect&
 	
 	// Mark this function as built.
 	build_state = BUILT;
+	if (ProgramSize::enabled())
+		ProgramSize::function_built(*this);
+	if (ExecCost::enabled())
+		ExecCost::function_built(*this);
 }
 
 void
@@ -642,7 +668,7 @@ Function::make_builtin_function(const string &function_string)
 
 	// create a fact manager for this function, with empty global facts 
 	FactMgr* fm = new FactMgr(f);
-	FMList.push_back(fm);
+	FMList().push_back(fm);
 
 	GenerateParameterListFromString(*f, StringUtils::get_substring(v[2], '(', ')'));
 	f->GenerateBody(CGContext::get_empty_context());
@@ -653,7 +679,7 @@ Function::make_builtin_function(const string &function_string)
 
 	// collect info about global dangling pointers
 	fm->find_dangling_global_ptrs(f);
-	++builtin_functions_cnt;
+	++builtin_functions_cnt();
 }
 
 void
@@ -688,13 +714,15 @@ GenerateFunctions(void)
 	
 	// -----------------
 	// Create body of each function, continue until no new functions are created.
-	for (cur_func_idx = 0; cur_func_idx < FuncListSize(); cur_func_idx++) {
+	for (cur_func_idx() = 0; cur_func_idx() < FuncListSize(); cur_func_idx()++) {
 		// Dynamically adds new functions to the end of the list..
-		if (FuncList[cur_func_idx]->is_built() == false) {
-			FuncList[cur_func_idx]->GenerateBody(CGContext::get_empty_context());
+		if (FuncList()[cur_func_idx()]->is_built() == false) {
+			FuncList()[cur_func_idx()]->GenerateBody(CGContext::get_empty_context());
 			
 		}
 	}
+	ProfileScope scope("FactPointTo::aggregate_all_pointto_sets");
+	MemoryScope mem(eMemFacts);
 	FactPointTo::aggregate_all_pointto_sets();
 } 
   
@@ -702,9 +730,9 @@ vector<const Function*>
 Function::GetRandomFunctions(void)
 {
 	vector<const Function*> funcs;
-	for (size_t i=0; i<FuncList.size(); i++) {
-		if (!FuncList[i]->is_builtin)
-			funcs.push_back(FuncList[i]);
+	for (size_t i=0; i<FuncList().size(); i++) {
+		if (!FuncList()[i]->is_builtin)
+			funcs.push_back(FuncList()[i]);
 	}
 	return funcs;
 }
@@ -728,16 +756,18 @@ Function::deleteFunction(Function* func)
 void
 Function::doFinalization(void)
 {
-	for_each(FuncList.begin(), FuncList.end(), std::ptr_fun(deleteFunction));
+	for_each(FuncList().begin(), FuncList().end(), std::ptr_fun(deleteFunction));
 
-	FuncList.clear();
+	FuncList().clear();
 
 	std::vector<FactMgr*>::iterator i;
-	for (i = FMList.begin(); i != FMList.end(); ++i) {
+	for (i = FMList().begin(); i != FMList().end(); ++i) {
 		delete (*i);
 	}
-	FMList.clear();
+	FMList().clear();
 	FactMgr::doFinalization();
+	cur_func_idx() = 0;
+	builtin_functions_cnt() = 0;
 }
 
 Function::~Function()
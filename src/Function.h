@@ -88,6 +88,7 @@ public:
 	bool SanityCheck() const;
 
 	bool is_built(void) const { return (build_state == BUILT); }
+	bool is_building(void) const { return (build_state == BUILDING); }
 	bool need_return_stmt();
 	bool is_effect_known(void) const { return (build_state == BUILT); }
 	const Effect &get_feffect(void) const { return feffect; }
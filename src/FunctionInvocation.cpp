@@ -64,6 +64,7 @@
 #include "CompatibleChecker.h" 
 #include "Constant.h"
 #include "CGOptions.h"
+#include "ExecCost.h"
 
 using namespace std; 
 
@@ -86,6 +87,7 @@ FunctionInvocation::make_random(bool is_std_func,
 			callee = Function::choose_func(get_all_functions(), cg_context, type, qfer);
 		}
 		if (callee != NULL) {
+			ExecCost::charge(ExecCost::function_cost(*callee));
 			FunctionInvocationUser *fiu = new FunctionInvocationUser(callee, true, NULL);
 			fiu->build_invocation(callee, cg_context);  
 			fi = fiu;
@@ -93,10 +95,11 @@ FunctionInvocation::make_random(bool is_std_func,
 				cg_context.get_current_func()->fact_changed |= fiu->func->fact_changed;
 			}
 		} 
-		else if (!Function::reach_max_functions_cnt()) {
+		else if (!Function::reach_max_functions_cnt() && !ExecCost::too_hot_for_new_function()) {
 			fi = FunctionInvocationUser::build_invocation_and_function(cg_context, type, qfer); 
 		} else {
-			// we can not find/create a function because we reach the limit, so give up
+			// we can not find/create a function because we reach the limit, or
+			// it would run too often, so give up
 			fi = new FunctionInvocationUser(NULL, false, NULL);
 			fi->failed = true;
 			return fi;
@@ -484,7 +487,7 @@ FunctionInvocation::visit_facts(vector<const Fact*>& inputs, CGContext& cg_conte
 	bool unordered = false; //has_uncertain_call();  
 	bool ok = false;
 	bool is_func_call = (invoke_type == eFuncCall);
-	static int g = 0;
+	static THREAD_LOCAL int g = 0;
 	Effect running_eff_context(cg_context.get_effect_context());
 	if (!unordered) {  
 		// unsigned int flags = ptr_cmp ? (cg_context.flags | NO_DANGLING_PTR) : cg_context.flags;
@@ -61,20 +61,23 @@
 #include "Fact.h"
 #include "SafeOpFlags.h"
 #include "AbsOutputMgr.h"
+#include "GenerationContext.h"
 
 
 using namespace std; 
 
-static vector<const FunctionInvocationUser*> invocations;   // list of function calls
-static vector<const Fact*> return_facts;              // list of return facts
+// list of function calls
+static inline vector<const FunctionInvocationUser*> &invocations(void) { return GenerationContext::current().invocations; }
+// list of return facts
+static inline vector<const Fact*> &return_facts(void) { return GenerationContext::current().return_facts; }
 
 const Fact*
 get_return_fact_for_invocation(const FunctionInvocationUser* fiu, const Variable* var, enum eFactCategory cat) 
 {
-	assert(invocations.size() == return_facts.size());
-	for (size_t i=0; i<return_facts.size(); i++) {
-		if (invocations[i] == fiu) {
-			const Fact* fact = return_facts[i];
+	assert(invocations().size() == return_facts().size());
+	for (size_t i=0; i<return_facts().size(); i++) {
+		if (invocations()[i] == fiu) {
+			const Fact* fact = return_facts()[i];
 			if (fact->eCat == cat && fact->get_var() == var) { 
 				return fact;
 			}
@@ -87,15 +90,15 @@ void
 add_return_fact_for_invocation(const FunctionInvocationUser* fiu, const Fact* f)
 {
 	size_t i;
-	assert(invocations.size() == return_facts.size());
-	for (i=0; i<invocations.size(); i++) {
-		if (invocations[i] == fiu && return_facts[i]->is_related(*f)) {
-			return_facts[i] = f;
+	assert(invocations().size() == return_facts().size());
+	for (i=0; i<invocations().size(); i++) {
+		if (invocations()[i] == fiu && return_facts()[i]->is_related(*f)) {
+			return_facts()[i] = f;
 			return;
 		}
 	}
-	invocations.push_back(fiu);
-	return_facts.push_back(f);
+	invocations().push_back(fiu);
+	return_facts().push_back(f);
 }
 
 /* 
@@ -383,8 +386,8 @@ FunctionInvocationUser::save_return_fact(const vector<const Fact*>& facts) const
 void
 FunctionInvocationUser::doFinalization(void)
 {
-	invocations.clear();
-	return_facts.clear();
+	invocations().clear();
+	return_facts().clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "GenerationBudget.h"
+
+#include "CGOptions.h"
+#include "Statement.h"
+#include "GenerationContext.h"
+#include "platform.h"
+
+void
+GenerationBudget::start(void)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	ctx.budget_start_usecs = platform_get_usecs();
+	ctx.budget_exhausted = false;
+	ctx.budget_stop_sid = 0;
+}
+
+bool
+GenerationBudget::exhausted(void)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	if (ctx.budget_exhausted)
+		return true;
+	int sid = Statement::get_current_sid();
+	if (CGOptions::time_budget() && !ctx.budget_stop_sid &&
+		platform_get_usecs() - ctx.budget_start_usecs >= (unsigned long long)CGOptions::time_budget() * 1000)
+		ctx.budget_stop_sid = sid + 1;
+	int stop = CGOptions::stmt_budget();
+	if (ctx.budget_stop_sid && (!stop || ctx.budget_stop_sid < stop))
+		stop = ctx.budget_stop_sid;
+	if (stop && sid >= stop)
+		ctx.budget_exhausted = true;
+	return ctx.budget_exhausted;
+}
+
+int
+GenerationBudget::stop_sid(void)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	if (!ctx.budget_exhausted || !ctx.budget_stop_sid)
+		return 0;
+	if (CGOptions::stmt_budget() && CGOptions::stmt_budget() <= ctx.budget_stop_sid)
+		return 0;
+	return ctx.budget_stop_sid;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
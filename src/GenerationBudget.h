@@ -0,0 +1,61 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// The generation budgets given by "--time-budget" and "--stmt-budget".
+/// The clock starts when the generation of a program starts.  Once either
+/// budget is used up, the generator switches to closing mode, like it does
+/// for "--stop-by-stmt" and "--max-memory": no new functions are created,
+/// every further statement is a return and the functions under
+/// construction are finished, so that a pathological seed still yields a
+/// valid program within a bounded time.
+///
+/// When the time budget runs out, the generation stops at the next new
+/// statement, exactly as the statement budget would, so that the program
+/// can be regenerated with "--stmt-budget" (see stop_sid).
+///
+#ifndef GENERATION_BUDGET_H
+#define GENERATION_BUDGET_H
+
+class GenerationBudget
+{
+public:
+	// start the clock for the program about to be generated
+	static void start(void);
+
+	// true, and stays true, once the time or the statement budget is used up
+	static bool exhausted(void);
+
+	// the "--stmt-budget" that regenerates the program without the clock,
+	// or 0 if the time budget did not stop the generation
+	static int stop_sid(void);
+};
+
+#endif // GENERATION_BUDGET_H
@@ -0,0 +1,137 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "GenerationContext.h"
+
+#include <cstddef>
+
+// the context installed in the calling thread, if any
+static THREAD_LOCAL GenerationContext *current_context = NULL;
+
+GenerationContext::GenerationContext(void)
+	: generator(NULL),
+	  random_number(NULL),
+	  default_rnd(NULL),
+	  sequence_sep_char('_'),
+	  probabilities(NULL),
+	  output_mgr(NULL),
+	  output_stream(NULL),
+	  cur_func_idx(0),
+	  builtin_functions_cnt(0),
+	  void_type(NULL),
+	  struct_sequence(0),
+	  var_created(false),
+	  tmp_count(0),
+	  scope_table(NULL),
+	  ctrl_vars_count(0),
+	  match_exact_qualifiers(false),
+	  stmt_table(NULL),
+	  stmt_sid(0),
+	  failed_stm(NULL),
+	  expr_eid(0),
+	  gensym_count(0),
+	  union_var_cnt(0),
+	  address_taken_cnt(0),
+	  cmp_ptr_to_null(0),
+	  cmp_ptr_to_ptr(0),
+	  cmp_ptr_to_addr(0),
+	  read_volatile_cnt(0),
+	  read_volatile_thru_ptr_cnt(0),
+	  write_volatile_cnt(0),
+	  write_volatile_thru_ptr_cnt(0),
+	  read_non_volatile_cnt(0),
+	  write_non_volatile_cnt(0),
+	  pointer_avail_for_dereference(0),
+	  volatile_avail(0),
+	  structs_with_bitfields(0),
+	  vars_with_bitfields_address_taken_cnt(0),
+	  bitfields_in_total(0),
+	  unamed_bitfields_in_total(0),
+	  const_bitfields_in_total(0),
+	  volatile_bitfields_in_total(0),
+	  lhs_bitfields_structs_vars_cnt(0),
+	  rhs_bitfields_structs_vars_cnt(0),
+	  lhs_bitfield_cnt(0),
+	  rhs_bitfield_cnt(0),
+	  forward_jump_cnt(0),
+	  backward_jump_cnt(0),
+	  use_new_var_cnt(0),
+	  use_old_var_cnt(0),
+	  rely_on_int_size(false),
+	  rely_on_ptr_size(false),
+	  size_func_bytes(0),
+	  size_func_stmts(0),
+	  size_global_bytes(0),
+	  size_globals_measured(0),
+	  size_target_reached(false),
+	  size_estimate_sid(-1),
+	  size_estimate(0),
+	  budget_start_usecs(0),
+	  budget_exhausted(false),
+	  budget_stop_sid(0),
+	  exec_weight(1),
+	  exec_spent(0)
+{
+	for (int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
+		simple_types[i] = NULL;
+	}
+}
+
+/*
+ * The program itself is released by Finalization::doFinalization when its
+ * ProgramGenerator is deleted; only the tables outlive a program.
+ */
+GenerationContext::~GenerationContext(void)
+{
+	delete scope_table;
+	delete stmt_table;
+	if (current_context == this)
+		current_context = NULL;
+}
+
+GenerationContext &
+GenerationContext::current(void)
+{
+	if (!current_context)
+		current_context = new GenerationContext();
+	return *current_context;
+}
+
+void
+GenerationContext::set_current(GenerationContext *ctx)
+{
+	current_context = ctx;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,218 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// All the mutable state of generating one program.  Csmith keeps this
+/// state behind singletons and static accessors (FuncList, AllTypes,
+/// VariableSelector::AllVars, the Bookkeeper counters ...); those accessors
+/// now read the fields of the GenerationContext that is current in the
+/// calling thread.  A thread that installs its own context can therefore
+/// generate a program concurrently with other threads.  The options in
+/// CGOptions are set up once, before any generation starts, and are shared
+/// read-only by all contexts.
+///
+/// A thread that never installs a context gets a default one on first use,
+/// so single-program code paths need no setup.
+///
+#ifndef GENERATION_CONTEXT_H
+#define GENERATION_CONTEXT_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <ostream>
+#include "CommonMacros.h"
+#include "ProbabilityTable.h"
+#include "Statement.h"
+#include "Type.h"
+#include "VariableSelector.h"
+
+class ProgramGenerator;
+class RandomNumber;
+class DefaultRndNumGenerator;
+class Sequence;
+class Probabilities;
+class DefaultCOutputMgr;
+class Function;
+class FactMgr;
+class FunctionInvocationUser;
+class Fact;
+class Variable;
+
+class GenerationContext
+{
+public:
+	GenerationContext(void);
+
+	~GenerationContext(void);
+
+	// the context of the calling thread
+	static GenerationContext &current(void);
+
+	// install ctx as the context of the calling thread
+	static void set_current(GenerationContext *ctx);
+
+	// ProgramGenerator, RandomNumber, Probabilities and DefaultCOutputMgr
+	ProgramGenerator *generator;
+	RandomNumber *random_number;
+	DefaultRndNumGenerator *default_rnd;
+	std::set<Sequence*> sequences;
+	char sequence_sep_char;
+	Probabilities *probabilities;
+	DefaultCOutputMgr *output_mgr;
+
+	// output file of the program; empty means CGOptions::output_file()
+	std::string output_file;
+
+	// if not NULL, the program is written here instead (libcsmith)
+	std::ostream *output_stream;
+
+	// Function
+	std::vector<Function*> func_list;
+	std::vector<FactMgr*> fact_mgrs;
+	long cur_func_idx;
+	int builtin_functions_cnt;
+
+	// FunctionInvocationUser
+	std::vector<const FunctionInvocationUser*> invocations;
+	std::vector<const Fact*> return_facts;
+
+	// Type
+	std::vector<Type*> all_types;
+	std::vector<Type*> derived_types;
+	const Type *simple_types[MAX_SIMPLE_TYPES];
+	Type *void_type;
+	unsigned int struct_sequence;
+
+	// VariableSelector and Variable
+	std::vector<Variable*> all_vars;
+	std::vector<Variable*> global_vars;
+	std::vector<Variable*> global_nonvolatile_vars;
+	bool var_created;
+	int tmp_count;
+	ProbabilityTable<unsigned int, eVariableScope> *scope_table;
+	std::vector<std::vector<const Variable*>*> ctrl_vars_vectors;
+	unsigned long ctrl_vars_count;
+	// set while an assignment needs the exact qualifiers of its lhs
+	bool match_exact_qualifiers;
+
+	// Fact, FactMgr and FactPointTo
+	std::vector<Fact*> facts;
+	std::vector<Fact*> meta_facts;
+	std::vector<const Variable*> all_ptrs;
+	std::vector<std::vector<const Variable*> > all_aliases;
+
+	// Statement, Expression and their probability tables
+	ProbabilityTable<unsigned int, ProbName> *stmt_table;
+	DistributionTable expr_table;
+	DistributionTable param_table;
+	DistributionTable assign_ops_table;
+	int stmt_sid;
+	const Statement *failed_stm;
+	int expr_eid;
+	std::map<const Statement*, std::string> stm_labels;
+	std::map<eStatementType, bool> expands;
+	std::map<eStatementType, bool> expands_backup;
+
+	// names
+	int gensym_count;
+	std::vector<std::string> wrapper_names;
+
+	// Bookkeeper statistics
+	std::vector<int> struct_depth_cnts;
+	int union_var_cnt;
+	std::vector<int> expr_depth_cnts;
+	std::vector<int> blk_depth_cnts;
+	std::vector<int> dereference_level_cnts;
+	int address_taken_cnt;
+	std::vector<int> write_dereference_cnts;
+	std::vector<int> read_dereference_cnts;
+	int cmp_ptr_to_null;
+	int cmp_ptr_to_ptr;
+	int cmp_ptr_to_addr;
+	int read_volatile_cnt;
+	int read_volatile_thru_ptr_cnt;
+	int write_volatile_cnt;
+	int write_volatile_thru_ptr_cnt;
+	int read_non_volatile_cnt;
+	int write_non_volatile_cnt;
+	int pointer_avail_for_dereference;
+	int volatile_avail;
+	int structs_with_bitfields;
+	std::vector<int> vars_with_bitfields;
+	std::vector<int> vars_with_full_bitfields;
+	int vars_with_bitfields_address_taken_cnt;
+	int bitfields_in_total;
+	int unamed_bitfields_in_total;
+	int const_bitfields_in_total;
+	int volatile_bitfields_in_total;
+	int lhs_bitfields_structs_vars_cnt;
+	int rhs_bitfields_structs_vars_cnt;
+	int lhs_bitfield_cnt;
+	int rhs_bitfield_cnt;
+	int forward_jump_cnt;
+	int backward_jump_cnt;
+	int use_new_var_cnt;
+	int use_old_var_cnt;
+	bool rely_on_int_size;
+	bool rely_on_ptr_size;
+
+	// ProgramSize
+	unsigned long size_func_bytes;
+	int size_func_stmts;
+	unsigned long size_global_bytes;
+	size_t size_globals_measured;
+	bool size_target_reached;
+	int size_estimate_sid;
+	unsigned long size_estimate;
+
+	// GenerationBudget
+	unsigned long long budget_start_usecs;
+	bool budget_exhausted;
+	int budget_stop_sid;
+
+	// ExecCost
+	double exec_weight;
+	double exec_spent;
+	std::map<const Function*, double> exec_func_cost;
+
+private:
+	DISALLOW_COPY_AND_ASSIGN(GenerationContext);
+};
+
+#endif // GENERATION_CONTEXT_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,251 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "GeneratorServer.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "libcsmith.h"
+#include "platform.h"
+
+#ifndef WIN32
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+GeneratorServer::GeneratorServer(const vector<string> &args, bool fork_per_request)
+	: args_(args),
+	  options_(NULL),
+	  fork_(fork_per_request)
+{
+	// Nothing else to do.
+}
+
+GeneratorServer::~GeneratorServer(void)
+{
+	csmith_options_destroy(options_);
+}
+
+/*
+ * Make options_ the server's options plus the given option delta.  The
+ * options are only parsed again when the delta changes.
+ */
+bool
+GeneratorServer::set_options(const string &delta, string &error)
+{
+	if (options_ && delta == delta_)
+		return true;
+	csmith_options_destroy(options_);
+	options_ = NULL;
+
+	vector<string> args = args_;
+	istringstream ss(delta);
+	string arg;
+	while (ss >> arg)
+		args.push_back(arg);
+	vector<const char *> argv;
+	for (size_t i = 0; i < args.size(); i++)
+		argv.push_back(args[i].c_str());
+
+	char err[256];
+	options_ = csmith_options_create(static_cast<int>(argv.size()), argv.empty() ? NULL : &argv[0],
+									 err, sizeof(err));
+	if (!options_) {
+		// the answer must stay on one line
+		error = err;
+		for (size_t i = 0; i < error.size(); i++) {
+			if (error[i] == '\n' || error[i] == '\r')
+				error[i] = ' ';
+		}
+		while (!error.empty() && error[error.size() - 1] == ' ')
+			error.erase(error.size() - 1);
+		return false;
+	}
+	delta_ = delta;
+	return true;
+}
+
+static void
+append_program(void *arg, const char *data, size_t len)
+{
+	static_cast<string *>(arg)->append(data, len);
+}
+
+void
+GeneratorServer::handle(const string &line, FILE *out)
+{
+	char *end = NULL;
+	unsigned long seed = strtoul(line.c_str(), &end, 10);
+	if (end == line.c_str()) {
+		fprintf(out, "error expected a seed\n");
+		return;
+	}
+	string error;
+	if (!set_options(end, error)) {
+		fprintf(out, "error %s\n", error.c_str());
+		return;
+	}
+	if (!fork_) {
+		generate(seed, out);
+		return;
+	}
+
+#ifndef WIN32
+	fflush(out);
+	pid_t pid = fork();
+	if (pid == 0) {
+		generate(seed, out);
+		fflush(out);
+		_exit(0);
+	}
+	int status = 0;
+	if (pid < 0 || waitpid(pid, &status, 0) < 0) {
+		fprintf(out, "error can't fork the generator\n");
+	}
+	else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		fprintf(out, "error generator crashed\n");
+	}
+#else
+	generate(seed, out);
+#endif
+}
+
+/*
+ * Generate the program for seed with the current options and answer it.
+ */
+void
+GeneratorServer::generate(unsigned long seed, FILE *out)
+{
+	string program;
+	csmith_sink sink;
+	memset(&sink, 0, sizeof(sink));
+	sink.write = append_program;
+	sink.arg = &program;
+	unsigned long long start = platform_get_usecs();
+	if (csmith_generate(options_, seed, &sink) != CSMITH_OK) {
+		fprintf(out, "error generation failed\n");
+		return;
+	}
+	unsigned long long usecs = platform_get_usecs() - start;
+
+	fprintf(out, "program %lu\n", static_cast<unsigned long>(program.size()));
+	fwrite(program.data(), 1, program.size(), out);
+	fprintf(out, "stats seed=%lu bytes=%lu usecs=%llu\n",
+			seed, static_cast<unsigned long>(program.size()), usecs);
+}
+
+void
+GeneratorServer::serve_requests(FILE *in, FILE *out)
+{
+	string line;
+	int c;
+	while ((c = getc(in)) != EOF) {
+		if (c != '\n') {
+			line += static_cast<char>(c);
+			continue;
+		}
+		if (line.find_first_not_of(" \t\r") != string::npos) {
+			handle(line, out);
+			fflush(out);
+		}
+		line.clear();
+	}
+}
+
+void
+GeneratorServer::serve(FILE *in, FILE *out)
+{
+	serve_requests(in, out);
+}
+
+bool
+GeneratorServer::serve_socket(const string &path)
+{
+#ifndef WIN32
+	struct sockaddr_un addr;
+	if (path.size() >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "error: socket path too long: %s\n", path.c_str());
+		return false;
+	}
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		perror("socket");
+		return false;
+	}
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy(addr.sun_path, path.c_str());
+	unlink(path.c_str());
+	if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 ||
+		listen(fd, 16) < 0) {
+		perror(path.c_str());
+		close(fd);
+		return false;
+	}
+	// a client that goes away mid-answer must not take the server down
+	signal(SIGPIPE, SIG_IGN);
+
+	for (;;) {
+		int conn = accept(fd, NULL, NULL);
+		if (conn < 0) {
+			if (errno == EINTR)
+				continue;
+			perror("accept");
+			close(fd);
+			return false;
+		}
+		FILE *in = fdopen(conn, "r");
+		FILE *out = fdopen(dup(conn), "w");
+		if (in && out)
+			serve_requests(in, out);
+		if (in)
+			fclose(in);
+		if (out)
+			fclose(out);
+	}
+#else
+	fprintf(stderr, "error: --serve-socket is not supported on this platform\n");
+	return false;
+#endif
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,116 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// The `--serve' mode: a long-running generator that answers requests for
+/// programs, so that test drivers don't pay for starting Csmith once per
+/// program.  Every program is generated in a fresh generation context, the
+/// same reset as between the programs of a batch, so nothing carries over
+/// from one request to the next.
+///
+/// The protocol is line based.  A request is a line
+///
+///     <seed> [<option> ...]
+///
+/// where the options, if any, are added to the server's own command line
+/// for this request (they are separated by blanks and can't be quoted).
+/// The answer is
+///
+///     program <length>
+///     <length bytes of program text>
+///     stats seed=<seed> bytes=<length> usecs=<generation time>
+///
+/// or, if the request can't be served, a single line "error <message>".
+/// The server stops at the end of its input; in socket mode it then waits
+/// for the next connection.
+///
+/// With `--fork-server' every request is generated by a fork()ed copy of
+/// the server, which exits after answering.  The generator state of one
+/// request can't leak into the next by construction, and a request that
+/// crashes the generator only costs its own answer ("error generator
+/// crashed").  This is for isolation only: the generator keeps no state
+/// that a child could reuse, so forking makes every request slower than
+/// plain serving.
+///
+#ifndef GENERATOR_SERVER_H
+#define GENERATOR_SERVER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "CommonMacros.h"
+
+struct csmith_options;
+
+class GeneratorServer
+{
+public:
+	// args: the server's command line, without the program name and
+	// without the --serve options
+	GeneratorServer(const std::vector<std::string> &args, bool fork_per_request);
+
+	~GeneratorServer(void);
+
+	// serve the requests read from in, answering to out
+	void serve(FILE *in, FILE *out);
+
+	// serve the connections to a Unix-domain socket, one at a time;
+	// returns only if the socket can't be set up
+	bool serve_socket(const std::string &path);
+
+private:
+	void serve_requests(FILE *in, FILE *out);
+
+	void handle(const std::string &line, FILE *out);
+
+	void generate(unsigned long seed, FILE *out);
+
+	bool set_options(const std::string &delta, std::string &error);
+
+	std::vector<std::string> args_;
+
+	// the options for the option delta delta_
+	csmith_options *options_;
+
+	std::string delta_;
+
+	bool fork_;
+
+	DISALLOW_COPY_AND_ASSIGN(GeneratorServer);
+};
+
+#endif // GENERATOR_SERVER_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
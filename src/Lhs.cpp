@@ -107,7 +107,7 @@ Lhs::make_random(CGContext &cg_context, const Type* t, const TypeQualifiers* qfe
 				// bookkeeping
 				int deref_level = tmp.get_indirect_level();
 				if (deref_level > 0) {
-					incr_counter(Bookkeeper::write_dereference_cnts, deref_level); 
+					incr_counter(Bookkeeper::write_dereference_cnts(), deref_level); 
 				}
 				Bookkeeper::record_volatile_access(var, deref_level, true);
 				return new Lhs(*var, t, compound_assign);
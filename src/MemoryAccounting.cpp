@@ -0,0 +1,73 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "MemoryAccounting.h"
+
+#include "platform.h"
+
+using namespace std;
+
+THREAD_LOCAL eMemSubsystem MemoryAccounting::current_ = eMemOther;
+THREAD_LOCAL unsigned long long MemoryAccounting::allocs_[MAX_MEM_SUBSYSTEM];
+THREAD_LOCAL unsigned long long MemoryAccounting::bytes_[MAX_MEM_SUBSYSTEM];
+THREAD_LOCAL unsigned long long MemoryAccounting::live_ = 0;
+THREAD_LOCAL unsigned long long MemoryAccounting::peak_ = 0;
+unsigned long long MemoryAccounting::limit_ = 0;
+THREAD_LOCAL bool MemoryAccounting::limit_reached_ = false;
+
+static const char *subsystem_names[MAX_MEM_SUBSYSTEM] = {
+	"other",
+	"types",
+	"AST",
+	"facts",
+	"effects",
+	"output",
+};
+
+void
+MemoryAccounting::output_statistics(std::ostream &out)
+{
+	out << "XXX heap allocations by subsystem:" << endl;
+	for (int i = 0; i < MAX_MEM_SUBSYSTEM; i++) {
+		out << "   " << subsystem_names[i] << ": " << allocs_[i] << " allocations, "
+			<< (bytes_[i] >> 10) << " KB" << endl;
+	}
+	out << "XXX peak heap: " << (peak_ >> 10) << " KB" << endl;
+}
+
+void
+MemoryAccounting::doFinalization(void)
+{
+	for (int i = 0; i < MAX_MEM_SUBSYSTEM; i++) {
+		allocs_[i] = 0;
+		bytes_[i] = 0;
+	}
+	peak_ = live_;
+	limit_reached_ = false;
+}
@@ -0,0 +1,134 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// Heap accounting for the generator.  The csmith program replaces the
+/// global operator new and operator delete (see MemoryHooks.cpp; the
+/// library does not) so that every allocation is charged to the
+/// subsystem that is active when it is made; MemoryScope objects switch the
+/// active subsystem for the duration of a C++ scope.  The totals feed the
+/// "--memory-stats" section of the statistics and the "--max-memory" guard:
+/// once the live heap exceeds the limit, the generator stops growing the
+/// program (no new statements or functions) and finishes what it has.
+///
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+#include <ostream>
+#include "CommonMacros.h"
+
+enum eMemSubsystem {
+	eMemOther,
+	eMemTypes,
+	eMemAST,
+	eMemFacts,
+	eMemEffects,
+	eMemOutput,
+	MAX_MEM_SUBSYSTEM
+};
+
+class MemoryAccounting
+{
+public:
+	static void on_alloc(unsigned long bytes) {
+		allocs_[current_]++;
+		bytes_[current_] += bytes;
+		live_ += bytes;
+		if (live_ > peak_)
+			peak_ = live_;
+	}
+
+	static void on_free(unsigned long bytes) {
+		// with --jobs a block may be freed by another thread than the one
+		// it was charged to
+		live_ = (live_ > bytes) ? live_ - bytes : 0;
+	}
+
+	static eMemSubsystem current(void) { return current_; }
+
+	static void set_current(eMemSubsystem s) { current_ = s; }
+
+	// limit on the live heap in bytes, 0 for none; set while no program is
+	// being generated (see CommandLine::parse)
+	static void set_limit(unsigned long long bytes) { limit_ = bytes; }
+
+	// true, and stays true, once the live heap has exceeded the limit
+	static bool limit_reached(void) {
+		if (!limit_reached_ && limit_ && live_ > limit_)
+			limit_reached_ = true;
+		return limit_reached_;
+	}
+
+	static void output_statistics(std::ostream &out);
+
+	// start the counters and the limit over for the next program
+	static void doFinalization(void);
+
+private:
+	// the counters are per thread, i.e. per generation; the limit is global
+	static THREAD_LOCAL eMemSubsystem current_;
+
+	static THREAD_LOCAL unsigned long long allocs_[MAX_MEM_SUBSYSTEM];
+
+	static THREAD_LOCAL unsigned long long bytes_[MAX_MEM_SUBSYSTEM];
+
+	static THREAD_LOCAL unsigned long long live_;
+
+	static THREAD_LOCAL unsigned long long peak_;
+
+	static unsigned long long limit_;
+
+	static THREAD_LOCAL bool limit_reached_;
+};
+
+/*
+ * RAII helper: charges allocations in the enclosing C++ scope to a subsystem.
+ */
+class MemoryScope
+{
+public:
+	explicit MemoryScope(eMemSubsystem s)
+		: saved_(MemoryAccounting::current())
+	{
+		MemoryAccounting::set_current(s);
+	}
+
+	~MemoryScope(void)
+	{
+		MemoryAccounting::set_current(saved_);
+	}
+
+private:
+	const eMemSubsystem saved_;
+
+	DISALLOW_COPY_AND_ASSIGN(MemoryScope);
+};
+
+#endif // MEMORY_ACCOUNTING_H
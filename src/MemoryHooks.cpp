@@ -0,0 +1,146 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//
+// The replacement global allocation functions behind MemoryAccounting.
+// Blocks are charged by their usable size, which is what the allocator
+// reports again when they are freed.
+//
+// They are linked into the csmith program only, not into libcsmith_gen.a,
+// so that a program embedding the generator keeps its own allocator.
+//
+
+#include "MemoryAccounting.h"
+
+#include <cstdlib>
+#include <new>
+#include "platform.h"
+
+#if __cplusplus >= 201103L
+#define THROW_BAD_ALLOC
+#define THROW_NOTHING noexcept
+#else
+#define THROW_BAD_ALLOC throw(std::bad_alloc)
+#define THROW_NOTHING throw()
+#endif
+
+static inline void *
+accounted_malloc(size_t size)
+{
+	void *p = malloc(size ? size : 1);
+	if (p)
+		MemoryAccounting::on_alloc(platform_alloc_size(p));
+	return p;
+}
+
+static inline void
+accounted_free(void *p)
+{
+	if (p) {
+		MemoryAccounting::on_free(platform_alloc_size(p));
+		free(p);
+	}
+}
+
+void *
+operator new(size_t size) THROW_BAD_ALLOC
+{
+	void *p = accounted_malloc(size);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void *
+operator new[](size_t size) THROW_BAD_ALLOC
+{
+	void *p = accounted_malloc(size);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void *
+operator new(size_t size, const std::nothrow_t &) THROW_NOTHING
+{
+	return accounted_malloc(size);
+}
+
+void *
+operator new[](size_t size, const std::nothrow_t &) THROW_NOTHING
+{
+	return accounted_malloc(size);
+}
+
+void
+operator delete(void *p) THROW_NOTHING
+{
+	accounted_free(p);
+}
+
+void
+operator delete[](void *p) THROW_NOTHING
+{
+	accounted_free(p);
+}
+
+void
+operator delete(void *p, const std::nothrow_t &) THROW_NOTHING
+{
+	accounted_free(p);
+}
+
+void
+operator delete[](void *p, const std::nothrow_t &) THROW_NOTHING
+{
+	accounted_free(p);
+}
+
+#if __cplusplus >= 201402L
+// C++14 sized deallocation; the size is the one the block was allocated
+// with, not the usable size it was charged by
+void
+operator delete(void *p, size_t) THROW_NOTHING
+{
+	accounted_free(p);
+}
+
+void
+operator delete[](void *p, size_t) THROW_NOTHING
+{
+	accounted_free(p);
+}
+#endif
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,101 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "OutputBuffer.h"
+
+OutputBuffer::OutputBuffer(std::streambuf *sink, size_t size)
+	: sink_(sink),
+	  buf_(new char[size]),
+	  size_(size)
+{
+	setp(buf_, buf_ + size_);
+}
+
+OutputBuffer::~OutputBuffer(void)
+{
+	flush();
+	delete[] buf_;
+}
+
+// Hand the put area over to the sink and start it over.
+void
+OutputBuffer::drain(void)
+{
+	std::streamsize n = pptr() - pbase();
+	if (n > 0)
+		sink_->sputn(pbase(), n);
+	setp(buf_, buf_ + size_);
+}
+
+void
+OutputBuffer::flush(void)
+{
+	drain();
+	sink_->pubsync();
+}
+
+OutputBuffer::int_type
+OutputBuffer::overflow(int_type c)
+{
+	drain();
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+std::streamsize
+OutputBuffer::xsputn(const char *s, std::streamsize n)
+{
+	if (n > epptr() - pptr()) {
+		drain();
+		// too big for the put area even when it is empty: write it through
+		if ((size_t)n > size_)
+			return sink_->sputn(s, n);
+	}
+	memcpy(pptr(), s, n);
+	pbump((int)n);
+	return n;
+}
+
+// Called by ostream::flush, i.e. for every endl.  The text stays buffered
+// until the output manager flushes it.
+int
+OutputBuffer::sync(void)
+{
+	return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,91 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// The emitter behind the output managers: a stream buffer with one large,
+/// reusable put area in front of the real output (a file, std::cout or a
+/// stream given by the embedding application).  Writes, including direct
+/// appends of whole statements and expressions, are plain copies into the
+/// put area; the real output is only written when the area is full or when
+/// the output manager calls flush().  sync() does not write through, so an
+/// "endl" in the output code no longer flushes the file.
+///
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include <streambuf>
+#include <string>
+#include <cstring>
+#include "CommonMacros.h"
+
+class OutputBuffer : public std::streambuf
+{
+public:
+	static const size_t default_size = 1 << 20;
+
+	explicit OutputBuffer(std::streambuf *sink, size_t size = default_size);
+
+	virtual ~OutputBuffer(void);
+
+	void append(const char *s, size_t n) {
+		if (n <= (size_t)(epptr() - pptr())) {
+			memcpy(pptr(), s, n);
+			pbump((int)n);
+		}
+		else {
+			xsputn(s, n);
+		}
+	}
+
+	void append(const std::string &s) { append(s.data(), s.size()); }
+
+	// write the buffered text to the sink and flush the sink
+	void flush(void);
+
+protected:
+	virtual int_type overflow(int_type c);
+
+	virtual std::streamsize xsputn(const char *s, std::streamsize n);
+
+	virtual int sync(void);
+
+private:
+	void drain(void);
+
+	std::streambuf *sink_;
+
+	char *buf_;
+
+	size_t size_;
+
+	DISALLOW_COPY_AND_ASSIGN(OutputBuffer);
+};
+
+#endif // OUTPUT_BUFFER_H
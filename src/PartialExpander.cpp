@@ -30,12 +30,21 @@
 #include "PartialExpander.h"
 #include <cassert>
 #include <iostream>
+#include "GenerationContext.h"
 
 using namespace std;
 
-std::map<eStatementType, bool> PartialExpander::expands_;
+std::map<eStatementType, bool> &
+PartialExpander::expands_(void)
+{
+	return GenerationContext::current().expands;
+}
 
-std::map<eStatementType, bool> PartialExpander::expands_backup_;
+std::map<eStatementType, bool> &
+PartialExpander::expands_backup_(void)
+{
+	return GenerationContext::current().expands_backup;
+}
 
 void
 print_map(const map<eStatementType, bool> &m)
@@ -61,12 +70,12 @@ PartialExpander::init_map(map<eStatementType, bool> &m, bool value)
 bool
 PartialExpander::init_partial_expander(const std::string &options)
 {
-	PartialExpander::init_map(expands_, false);
+	PartialExpander::init_map(expands_(), false);
 	if (!PartialExpander::parse_options(options, ','))
 		return false;
 
-	PartialExpander::expands_[MAX_STATEMENT_TYPE] = true;
-	PartialExpander::copy_expands(PartialExpander::expands_backup_, PartialExpander::expands_);
+	PartialExpander::expands_()[MAX_STATEMENT_TYPE] = true;
+	PartialExpander::copy_expands(PartialExpander::expands_backup_(), PartialExpander::expands_());
 	return true;
 }
 
@@ -95,7 +104,7 @@ PartialExpander::parse_options(const std::string &options, char sep_char)
 void
 PartialExpander::set_stmt_expand(eStatementType t, bool value)
 {
-	expands_[t] = value;
+	expands_()[t] = value;
 }
 
 bool
@@ -121,7 +130,7 @@ PartialExpander::set_expand(const std::string s)
 		PartialExpander::set_stmt_expand(eReturn, true);
 	}
 	else if (!s.compare("all")) {
-		PartialExpander::init_map(expands_, true);
+		PartialExpander::init_map(expands_(), true);
 	}
 	else {
 		return false;
@@ -142,30 +151,30 @@ PartialExpander::copy_expands(std::map<eStatementType, bool> &dest, const map<eS
 void 
 PartialExpander::restore_init_values()
 {
-	PartialExpander::copy_expands(PartialExpander::expands_, PartialExpander::expands_backup_);
+	PartialExpander::copy_expands(PartialExpander::expands_(), PartialExpander::expands_backup_());
 }
 
 bool
 PartialExpander::direct_expand_check(eStatementType t)
 {
 	//assert(expands_.find(t) != expands_.end());
-	return expands_[t];
+	return expands_()[t];
 }
 
 bool
 PartialExpander::expand_check(eStatementType t)
 {
 	// If expand is false, then all values are valid
-	if (!expands_[MAX_STATEMENT_TYPE])
+	if (!expands_()[MAX_STATEMENT_TYPE])
 		return true;
 
-	assert(expands_.find(t) != expands_.end());
+	assert(expands_().find(t) != expands_().end());
 
 	bool rv = false;
-	rv = expands_[t];
+	rv = expands_()[t];
 
 	if (t == eAssign) {
-		rv = rv || expands_[eInvoke];
+		rv = rv || expands_()[eInvoke];
 	}
 
 	if (rv) {
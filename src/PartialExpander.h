@@ -59,9 +59,9 @@ private:
 
 	static bool parse_options(const std::string &options, char sep_char);
 
-	static std::map<eStatementType, bool> expands_;
+	static std::map<eStatementType, bool> &expands_(void);
 
-	static std::map<eStatementType, bool> expands_backup_;
+	static std::map<eStatementType, bool> &expands_backup_(void);
 };
 
 #endif
@@ -43,6 +43,7 @@
 #include "CGOptions.h" 
 #include "VectorFilter.h"
 #include "random.h"
+#include "GenerationContext.h"
 
 ////////////////////////////////////////////////////////////////////////////////////
 #define VAL_ASSERT(val) assert(((val) <= 100) && ((val) >= -1))
@@ -357,26 +358,37 @@ GroupProbElem::dump_val(std::ostream &out)
 
 /////////////////////////////////////////////////////////////////
 
-Probabilities* Probabilities::instance_ = NULL;
+Probabilities *&
+Probabilities::instance_(void)
+{
+	return GenerationContext::current().probabilities;
+}
 
 Probabilities *
 Probabilities::GetInstance()
 {
-	if (Probabilities::instance_)
-		return Probabilities::instance_;
-
-	Probabilities::instance_ = new Probabilities();
-	assert(Probabilities::instance_);
-	Probabilities::instance_->initialize();
-	return Probabilities::instance_;
+	if (Probabilities::instance_())
+		return Probabilities::instance_();
+
+	Probabilities::instance_() = new Probabilities();
+	assert(Probabilities::instance_());
+	Probabilities::instance_()->initialize();
+	// the file was checked for readability by CGOptions::has_conflict
+	if (!CGOptions::probability_configuration().empty()) {
+		string msg;
+		bool ok = Probabilities::instance_()->parse_configuration(msg, CGOptions::probability_configuration());
+		assert(ok && "invalid probability configuration file");
+		(void)ok;
+	}
+	return Probabilities::instance_();
 }
 
 void
 Probabilities::DestroyInstance()
 {
-	if (Probabilities::instance_) {
-		delete Probabilities::instance_;
-		Probabilities::instance_ = NULL;
+	if (Probabilities::instance_()) {
+		delete Probabilities::instance_();
+		Probabilities::instance_() = NULL;
 	}
 }
 
@@ -506,9 +518,9 @@ Probabilities::set_prob_table(ProbabilityTable<unsigned int, ProbName> *const ta
 unsigned int
 Probabilities::pname_to_type(ProbName pname)
 {
-	assert(Probabilities::instance_);
+	assert(Probabilities::instance_());
 	
-	return instance_->pname_to_type_[pname];
+	return instance_()->pname_to_type_[pname];
 }
 
 int 
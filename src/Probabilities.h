@@ -426,7 +426,7 @@ private:
 
 	void initialize();
 
-	static Probabilities *instance_;
+	static Probabilities *&instance_(void);
 
 	static const char comment_line_prefix;
 
@@ -179,6 +179,7 @@ public:
 	~DistributionTable() {}; 
 
 	void add_entry(int key, int prob); 
+	void clear(void) { max_prob_ = 0; keys_.clear(); probs_.clear(); }
 	int get_max(void) const { return max_prob_;}
 	int key_to_prob(int key) const;
 	int rnd_num_to_key(int rnd) const;
@@ -0,0 +1,170 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "Profiler.h"
+
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include "platform.h"
+
+using namespace std;
+
+THREAD_LOCAL bool Profiler::enabled_ = false;
+THREAD_LOCAL std::string *Profiler::file_ = NULL;
+THREAD_LOCAL Profiler::Node *Profiler::root_ = NULL;
+THREAD_LOCAL Profiler::Node *Profiler::current_ = NULL;
+
+Profiler::Node::~Node()
+{
+	std::map<std::string, Node*>::iterator i;
+	for (i = children.begin(); i != children.end(); ++i) {
+		delete i->second;
+	}
+}
+
+void
+Profiler::enable(const std::string &file)
+{
+	if (enabled_)
+		return;
+	file_ = new std::string(file);
+	root_ = new Node("csmith", NULL);
+	root_->calls = 1;
+	root_->start = platform_get_usecs();
+	current_ = root_;
+	enabled_ = true;
+}
+
+void
+Profiler::enter(const std::string &name)
+{
+	assert(current_);
+	Node *&child = current_->children[name];
+	if (child == NULL) {
+		child = new Node(name, current_);
+	}
+	child->calls++;
+	child->start = platform_get_usecs();
+	current_ = child;
+}
+
+void
+Profiler::leave(void)
+{
+	assert(current_ && current_ != root_);
+	current_->usecs += platform_get_usecs() - current_->start;
+	current_ = current_->parent;
+}
+
+unsigned long long
+Profiler::self_usecs(const Node *n)
+{
+	unsigned long long children_usecs = 0;
+	std::map<std::string, Node*>::const_iterator i;
+	for (i = n->children.begin(); i != n->children.end(); ++i) {
+		children_usecs += i->second->usecs;
+	}
+	// clock granularity can make children sum up slightly larger
+	return (n->usecs > children_usecs) ? (n->usecs - children_usecs) : 0;
+}
+
+/*
+ * One line per call path: "root;phase;subphase <self usecs>"
+ */
+void
+Profiler::output_folded(std::ostream &out, const Node *n, const std::string &prefix)
+{
+	string path = prefix.empty() ? n->name : (prefix + ";" + n->name);
+	unsigned long long self = self_usecs(n);
+	if (self > 0) {
+		out << path << " " << self << endl;
+	}
+	std::map<std::string, Node*>::const_iterator i;
+	for (i = n->children.begin(); i != n->children.end(); ++i) {
+		output_folded(out, i->second, path);
+	}
+}
+
+void
+Profiler::output_json(std::ostream &out, const Node *n, int indent)
+{
+	string tab(indent * 2, ' ');
+	out << tab << "{\"name\": \"" << n->name << "\", \"calls\": " << n->calls
+		<< ", \"total_us\": " << n->usecs << ", \"self_us\": " << self_usecs(n)
+		<< ", \"children\": [";
+	if (!n->children.empty()) {
+		out << endl;
+		std::map<std::string, Node*>::const_iterator i;
+		for (i = n->children.begin(); i != n->children.end(); ++i) {
+			if (i != n->children.begin()) out << "," << endl;
+			output_json(out, i->second, indent + 1);
+		}
+		out << endl << tab;
+	}
+	out << "]}";
+}
+
+void
+Profiler::output_profile(void)
+{
+	if (!enabled_)
+		return;
+	// only the root scope may still be open
+	assert(current_ == root_);
+	root_->usecs = platform_get_usecs() - root_->start;
+
+	const string &file = *file_;
+	ofstream out(file.c_str());
+	if (out.fail()) {
+		cerr << "warning: cannot write profile to " << file << endl;
+		return;
+	}
+	const string json_ext = ".json";
+	if (file.size() >= json_ext.size() &&
+		file.compare(file.size() - json_ext.size(), json_ext.size(), json_ext) == 0) {
+		output_json(out, root_, 0);
+		out << endl;
+	}
+	else {
+		output_folded(out, root_, "");
+	}
+	out.close();
+}
+
+void
+Profiler::doFinalization(void)
+{
+	delete root_;
+	root_ = NULL;
+	current_ = NULL;
+	delete file_;
+	file_ = NULL;
+	enabled_ = false;
+}
@@ -0,0 +1,126 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// A phase-level self-profiler for the generator. Code regions are
+/// bracketed with ProfileScope objects; nested scopes form a call tree
+/// whose inclusive and self times are written, at the end of generation,
+/// to the file given by "--profile <file>". The output is in the folded
+/// stack format understood by flamegraph.pl ("a;b;c <usecs>" per line),
+/// or a JSON tree if the file name ends with ".json".
+///
+/// When profiling is disabled, a ProfileScope costs a single flag test.
+///
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+#include "CommonMacros.h"
+
+class Profiler
+{
+public:
+	static void enable(const std::string &file);
+
+	static bool enabled(void) { return enabled_; }
+
+	static void enter(const std::string &name);
+
+	static void leave(void);
+
+	// write the profile to the file given to enable()
+	static void output_profile(void);
+
+	static void doFinalization(void);
+
+private:
+	struct Node {
+		Node(const std::string &n, Node *p) : name(n), parent(p), usecs(0), calls(0), start(0) {}
+		~Node();
+		std::string name;
+		Node *parent;
+		std::map<std::string, Node*> children;
+		unsigned long long usecs;
+		unsigned long calls;
+		// start time of the scope while it is open
+		unsigned long long start;
+	};
+
+	static unsigned long long self_usecs(const Node *n);
+
+	static void output_folded(std::ostream &out, const Node *n, const std::string &prefix);
+
+	static void output_json(std::ostream &out, const Node *n, int indent);
+
+	// one profile per thread, i.e. per generation under --jobs. file_ is a
+	// pointer because thread-local storage can't hold a non-POD object.
+	static THREAD_LOCAL bool enabled_;
+
+	static THREAD_LOCAL std::string *file_;
+
+	static THREAD_LOCAL Node *root_;
+
+	static THREAD_LOCAL Node *current_;
+};
+
+/*
+ * RAII helper: profiles the enclosing C++ scope under the given name.
+ */
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char *name)
+		: active_(Profiler::enabled())
+	{
+		if (active_) Profiler::enter(name);
+	}
+
+	// profiles under "name(arg)", which is only built when profiling
+	ProfileScope(const char *name, const std::string &arg)
+		: active_(Profiler::enabled())
+	{
+		if (active_) Profiler::enter(std::string(name) + "(" + arg + ")");
+	}
+
+	~ProfileScope(void)
+	{
+		if (active_) Profiler::leave();
+	}
+
+private:
+	const bool active_;
+
+	DISALLOW_COPY_AND_ASSIGN(ProfileScope);
+};
+
+#endif // PROFILER_H
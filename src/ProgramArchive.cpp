@@ -0,0 +1,185 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "ProgramArchive.h"
+
+#include <cstring>
+#include "platform.h"
+
+using namespace std;
+
+static const char index_magic[] = "CSMITHIX";
+
+static void
+put_u64(char *buf, unsigned long long v)
+{
+	for (int i = 0; i < 8; i++) {
+		buf[i] = static_cast<char>(v & 0xff);
+		v >>= 8;
+	}
+}
+
+static unsigned long long
+get_u64(const char *buf)
+{
+	unsigned long long v = 0;
+	for (int i = 7; i >= 0; i--) {
+		v = (v << 8) | static_cast<unsigned char>(buf[i]);
+	}
+	return v;
+}
+
+// the size of a file, 0 if it doesn't exist
+static unsigned long long
+file_size(const string &name)
+{
+	ifstream in(name.c_str(), ios::binary | ios::ate);
+	if (!in)
+		return 0;
+	return static_cast<unsigned long long>(in.tellg());
+}
+
+ProgramArchive::ProgramArchive(void)
+	: size_(0),
+	  lock_(platform_mutex_create())
+{
+	// Nothing else to do.
+}
+
+ProgramArchive::~ProgramArchive(void)
+{
+	close();
+	platform_mutex_destroy(lock_);
+}
+
+bool
+ProgramArchive::open(const string &name)
+{
+	size_ = file_size(name);
+	bool new_index = (file_size(index_file(name)) == 0);
+	data_.open(name.c_str(), ios::binary | ios::app);
+	index_.open(index_file(name).c_str(), ios::binary | ios::app);
+	if (!data_ || !index_)
+		return false;
+	if (new_index) {
+		char header[header_size];
+		memcpy(header, index_magic, 8);
+		put_u64(header + 8, version);
+		index_.write(header, header_size);
+	}
+	return true;
+}
+
+void
+ProgramArchive::append(unsigned long seed, unsigned long long options_hash,
+					   const string &program, unsigned long long usecs)
+{
+	char entry[entry_size];
+	platform_mutex_lock(lock_);
+	put_u64(entry, seed);
+	put_u64(entry + 8, options_hash);
+	put_u64(entry + 16, size_);
+	put_u64(entry + 24, program.size());
+	put_u64(entry + 32, usecs);
+	data_.write(program.data(), program.size());
+	index_.write(entry, entry_size);
+	// keep the two files consistent if we get killed between programs
+	data_.flush();
+	index_.flush();
+	size_ += program.size();
+	platform_mutex_unlock(lock_);
+}
+
+void
+ProgramArchive::close(void)
+{
+	if (data_.is_open())
+		data_.close();
+	if (index_.is_open())
+		index_.close();
+}
+
+unsigned long long
+ProgramArchive::hash_options(const string &options)
+{
+	unsigned long long h = 14695981039346656037ULL;
+	for (size_t i = 0; i < options.size(); i++) {
+		h ^= static_cast<unsigned char>(options[i]);
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+bool
+ProgramArchive::read_index(const string &name, vector<Entry> &entries, string &error)
+{
+	ifstream in(index_file(name).c_str(), ios::binary);
+	if (!in) {
+		error = "can't open " + index_file(name);
+		return false;
+	}
+	char header[header_size];
+	if (!in.read(header, header_size) || memcmp(header, index_magic, 8) != 0 ||
+		get_u64(header + 8) != version) {
+		error = index_file(name) + " is not a Csmith archive index";
+		return false;
+	}
+	entries.clear();
+	char buf[entry_size];
+	while (in.read(buf, entry_size)) {
+		Entry e;
+		e.seed = get_u64(buf);
+		e.options_hash = get_u64(buf + 8);
+		e.offset = get_u64(buf + 16);
+		e.length = get_u64(buf + 24);
+		e.usecs = get_u64(buf + 32);
+		entries.push_back(e);
+	}
+	return true;
+}
+
+bool
+ProgramArchive::read_program(const string &name, const Entry &entry, string &program)
+{
+	ifstream in(name.c_str(), ios::binary);
+	if (!in || !in.seekg(static_cast<streamoff>(entry.offset)))
+		return false;
+	program.resize(static_cast<size_t>(entry.length));
+	if (entry.length == 0)
+		return true;
+	in.read(&program[0], static_cast<streamsize>(entry.length));
+	return !in.fail();
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
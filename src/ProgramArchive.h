@@ -0,0 +1,116 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// An archive of generated programs, for batch runs that would otherwise
+/// write one small file per program.  An archive <name> is two files:
+///
+///   <name>      the programs, concatenated; only ever appended to
+///   <name>.idx  a 16-byte header ("CSMITHIX", then the version as a
+///               64-bit number) followed by one 40-byte entry per program
+///
+/// An entry is five little-endian 64-bit numbers: the seed, a hash of the
+/// options the program was generated with, the offset and the length of the
+/// program in <name>, and its generation time in microseconds.  The fixed
+/// size makes the index easy to memory-map; csmith-archive lists an archive
+/// and extracts programs from it.
+///
+#ifndef PROGRAM_ARCHIVE_H
+#define PROGRAM_ARCHIVE_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "CommonMacros.h"
+
+struct PlatformMutex;
+
+class ProgramArchive
+{
+public:
+	struct Entry {
+		unsigned long long seed;
+		unsigned long long options_hash;
+		unsigned long long offset;
+		unsigned long long length;
+		unsigned long long usecs;
+	};
+
+	static const unsigned long long version = 1;
+
+	static const size_t header_size = 16;
+
+	static const size_t entry_size = 40;
+
+	ProgramArchive(void);
+
+	~ProgramArchive(void);
+
+	// open the archive for appending, creating it if needed
+	bool open(const std::string &name);
+
+	// add a program; may be called from several threads
+	void append(unsigned long seed, unsigned long long options_hash,
+				const std::string &program, unsigned long long usecs);
+
+	void close(void);
+
+	static std::string index_file(const std::string &name) { return name + ".idx"; }
+
+	// a hash of the options of a program (FNV-1a)
+	static unsigned long long hash_options(const std::string &options);
+
+	// read the index of an archive
+	static bool read_index(const std::string &name, std::vector<Entry> &entries, std::string &error);
+
+	// read the program of an entry
+	static bool read_program(const std::string &name, const Entry &entry, std::string &program);
+
+private:
+	std::ofstream data_;
+
+	std::ofstream index_;
+
+	// the current size of the data file
+	unsigned long long size_;
+
+	PlatformMutex *lock_;
+
+	DISALLOW_COPY_AND_ASSIGN(ProgramArchive);
+};
+
+#endif // PROGRAM_ARCHIVE_H
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
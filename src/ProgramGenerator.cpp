@@ -38,8 +38,12 @@
 #include "Type.h" 
 #include "CGOptions.h"
 #include "SafeOpFlags.h"
+#include "Profiler.h"
+#include "MemoryAccounting.h"
+#include "GenerationBudget.h"
+#include "GenerationContext.h"
 
-ProgramGenerator* current_generator_ = NULL;
+static inline ProgramGenerator *&current_generator_(void) { return GenerationContext::current().generator; }
 
 ProgramGenerator::ProgramGenerator(int argc, char *argv[], unsigned long seed)
 	: argc_(argc),
@@ -53,45 +57,66 @@ ProgramGenerator::ProgramGenerator(int argc, char *argv[], unsigned long seed)
 /* Factory method */
 ProgramGenerator* ProgramGenerator::CreateInstance(int argc, char *argv[], unsigned long seed)
 {
-	if (current_generator_ == NULL)
-		current_generator_ = new ProgramGenerator(argc, argv, seed);
-	return current_generator_;
+	if (current_generator_() == NULL)
+		current_generator_() = new ProgramGenerator(argc, argv, seed);
+	return current_generator_();
 }
 
 ProgramGenerator::~ProgramGenerator()
 {
 	Finalization::doFinalization();
 	delete output_mgr_;
+	current_generator_() = NULL;
 }
 
 void
 ProgramGenerator::Init()
 { 
+	if (!CGOptions::profile_file().empty())
+		Profiler::enable(CGOptions::profile_file());
+
 	RandomNumber::CreateInstance(rDefaultRndNumGenerator, seed_);
 	  
 	// TODO: build different output managers based on user input 
 	// (either in a descriptive language or as a template)
+	// (CreateInstance already initializes the manager; a second Init would
+	// leak the output stream it opened)
 	output_mgr_ = DefaultCOutputMgr::CreateInstance();
 	 
 	assert(output_mgr_);
-	output_mgr_->Init();
 } 
 
 void
 ProgramGenerator::GoGenerator()
 {
 	output_mgr_->OutputProgramHeader(argc_, argv_, seed_);
+	// write the header out now, so a hang can be reproduced from it
+	output_mgr_->Flush();
+	GenerationBudget::start();
 
-	GenerateAllTypes();
-	GenerateFunctions();
- 
-	output_mgr_->OutputProgram(); 
+	{
+		ProfileScope scope("GenerateAllTypes");
+		MemoryScope mem(eMemTypes);
+		GenerateAllTypes();
+	}
+	{
+		ProfileScope scope("GenerateFunctions");
+		MemoryScope mem(eMemAST);
+		GenerateFunctions();
+	}
+	{
+		ProfileScope scope("OutputProgram");
+		MemoryScope mem(eMemOutput);
+		output_mgr_->OutputProgram(); 
+		output_mgr_->Flush();
+	}
+	Profiler::output_profile();
 }
 
 ProgramGenerator*
 ProgramGenerator::CurrentGenerator()
 {
-	return current_generator_;
+	return current_generator_();
 }
 
 AbsOutputMgr*
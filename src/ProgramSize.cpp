@@ -0,0 +1,159 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "ProgramSize.h"
+
+#include <vector>
+#include "CGOptions.h"
+#include "Function.h"
+#include "Block.h"
+#include "Statement.h"
+#include "Variable.h"
+#include "VariableSelector.h"
+#include "ProgramGenerator.h"
+#include "AbsOutputMgr.h"
+#include "GenerationContext.h"
+#include "Profiler.h"
+
+using namespace std;
+
+// bytes of the program outside the functions and the globals: header,
+// runtime include, type definitions, forward declarations and main
+static const unsigned long fixed_bytes = 2500;
+
+// assumed size of a statement before the first function is measured
+static const unsigned long default_stmt_bytes = 250;
+
+bool
+ProgramSize::enabled(void)
+{
+	return CGOptions::target_size() || CGOptions::min_size() || CGOptions::max_size();
+}
+
+unsigned long
+ProgramSize::target(void)
+{
+	if (CGOptions::target_size())
+		return CGOptions::target_size();
+	// leave room for the functions under construction to be finished
+	return CGOptions::max_size() / 2;
+}
+
+unsigned long
+ProgramSize::min_size(void)
+{
+	if (CGOptions::min_size())
+		return CGOptions::min_size();
+	return CGOptions::target_size() / 2;
+}
+
+unsigned long
+ProgramSize::max_size(void)
+{
+	if (CGOptions::max_size())
+		return CGOptions::max_size();
+	return (unsigned long)CGOptions::target_size() * 2;
+}
+
+// every block is a statement of its own
+static int
+count_stmts(const Function &f)
+{
+	int cnt = 0;
+	for (size_t i = 0; i < f.blocks.size(); i++) {
+		cnt += 1 + f.blocks[i]->stms.size();
+	}
+	return cnt;
+}
+
+void
+ProgramSize::measure_globals(void)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	const vector<Variable*> &globals = *VariableSelector::GetGlobalVariables();
+	AbsOutputMgr *output_mgr = ProgramGenerator::CurrentOutputMgr();
+	for (; ctx.size_globals_measured < globals.size(); ctx.size_globals_measured++) {
+		const Variable *v = globals[ctx.size_globals_measured];
+		ctx.size_global_bytes += output_mgr->GlobalSize(*v);
+	}
+}
+
+void
+ProgramSize::function_built(const Function &f)
+{
+	ProfileScope scope("ProgramSize");
+	GenerationContext &ctx = GenerationContext::current();
+	ctx.size_func_bytes += ProgramGenerator::CurrentOutputMgr()->FunctionSize(f);
+	ctx.size_func_stmts += count_stmts(f);
+	measure_globals();
+	ctx.size_estimate_sid = -1;
+}
+
+unsigned long
+ProgramSize::estimate(void)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	// the estimate only changes with new statements and new measurements
+	if (ctx.size_estimate_sid == Statement::get_current_sid())
+		return ctx.size_estimate;
+
+	unsigned long stmt_bytes = ctx.size_func_stmts ?
+		ctx.size_func_bytes / ctx.size_func_stmts : default_stmt_bytes;
+	unsigned long unmeasured = 0;
+	const vector<Function*> &funcs = get_all_functions();
+	for (size_t i = 0; i < funcs.size(); i++) {
+		if (funcs[i]->is_building())
+			unmeasured += count_stmts(*funcs[i]);
+	}
+	ctx.size_estimate_sid = Statement::get_current_sid();
+	ctx.size_estimate = fixed_bytes + ctx.size_global_bytes + ctx.size_func_bytes + unmeasured * stmt_bytes;
+	return ctx.size_estimate;
+}
+
+bool
+ProgramSize::below_min(void)
+{
+	return min_size() && !target_reached() && estimate() < min_size();
+}
+
+bool
+ProgramSize::target_reached(void)
+{
+	GenerationContext &ctx = GenerationContext::current();
+	if (!ctx.size_target_reached && target() && estimate() >= target())
+		ctx.size_target_reached = true;
+	return ctx.size_target_reached;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
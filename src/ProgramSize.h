@@ -0,0 +1,81 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/// Class Description
+///
+/// Generation-time program size targeting ("--target-size", "--min-size"
+/// and "--max-size").  Every function is measured exactly, by rendering it
+/// into a byte counter, as soon as its body is built; the statements of the
+/// functions still being built are estimated from the average size of the
+/// statements measured so far.  The generator consults the estimate to keep
+/// growing the entry function while the program is below the minimum, and
+/// to wind down (no new functions, statements or deep expressions) once it
+/// has reached the target, so that a driver rarely has to discard a program
+/// for being too small or too large.
+///
+/// The window is a hint, not a guarantee, and drivers must still check the
+/// size of what they get.  The data-flow analysis of the entry function can
+/// drop a tail of its statements after the minimum was judged reached, and a
+/// single call can build a tree of new functions that runs well past the
+/// target before anything winds down.  With "--min-size" alone there is no
+/// target, so the program is not held back once it is big enough.
+///
+#ifndef PROGRAM_SIZE_H
+#define PROGRAM_SIZE_H
+
+class Function;
+
+class ProgramSize
+{
+public:
+	// true if any of the size options is given
+	static bool enabled(void);
+
+	// measure a function whose body has just been built
+	static void function_built(const Function &f);
+
+	// estimated size in bytes of the program generated so far
+	static unsigned long estimate(void);
+
+	// true while the estimate is below the minimum size
+	static bool below_min(void);
+
+	// true, and stays true, once the estimate has reached the target
+	static bool target_reached(void);
+
+	// the size window in effect, derived from the options
+	static unsigned long target(void);
+	static unsigned long min_size(void);
+	static unsigned long max_size(void);
+
+private:
+	static void measure_globals(void);
+};
+
+#endif // PROGRAM_SIZE_H
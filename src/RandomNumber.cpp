@@ -33,8 +33,13 @@
 #include <iostream>
 #include "AbsRndNumGenerator.h"
 #include "Filter.h"
+#include "GenerationContext.h"
 
-RandomNumber *RandomNumber::instance_ = NULL;
+RandomNumber *&
+RandomNumber::instance_(void)
+{
+	return GenerationContext::current().random_number;
+}
 
 RandomNumber::RandomNumber(const unsigned long seed)
 	: seed_(seed)
@@ -68,33 +73,33 @@ RandomNumber::make_all_rndnum_generators(const unsigned long seed)
 void
 RandomNumber::CreateInstance(RNDNUM_GENERATOR rImpl, const unsigned long seed)
 {
-	if (!instance_) {
-		instance_ = new RandomNumber(seed);
+	if (!instance_()) {
+		instance_() = new RandomNumber(seed);
 		//instance_->make_all_rndnum_generators(seed);
 		//instance_->curr_generator_ = instance_->generators_[rImpl];
 		AbsRndNumGenerator *generator = AbsRndNumGenerator::make_rndnum_generator(rImpl, seed);
 		assert(generator);
-		instance_->curr_generator_ = generator;
-		instance_->generators_[rImpl] = generator;
+		instance_()->curr_generator_ = generator;
+		instance_()->generators_[rImpl] = generator;
 	}
 	else {
-		instance_->curr_generator_ = instance_->generators_[rImpl];
-		assert(instance_->curr_generator_);
+		instance_()->curr_generator_ = instance_()->generators_[rImpl];
+		assert(instance_()->curr_generator_);
 	}
 }
 
 RandomNumber*
 RandomNumber::GetInstance(void)
 {
-	assert(instance_);
-	return instance_;
+	assert(instance_());
+	return instance_();
 }
 
 AbsRndNumGenerator*
 RandomNumber::GetRndNumGenerator(void)
 {
-	assert(instance_->curr_generator_);
-	return instance_->curr_generator_;
+	assert(instance_()->curr_generator_);
+	return instance_()->curr_generator_;
 }
 
 /*
@@ -105,17 +110,17 @@ RNDNUM_GENERATOR
 RandomNumber::SwitchRndNumGenerator(RNDNUM_GENERATOR rImpl)
 {
 	unsigned int count = AbsRndNumGenerator::count();
-	AbsRndNumGenerator *generator = instance_->generators_[rImpl];
+	AbsRndNumGenerator *generator = instance_()->generators_[rImpl];
 	if (generator == NULL) {
-		generator = AbsRndNumGenerator::make_rndnum_generator(rImpl, instance_->seed_);
+		generator = AbsRndNumGenerator::make_rndnum_generator(rImpl, instance_()->seed_);
 		assert(generator);
-		instance_->generators_[rImpl] = generator;
+		instance_()->generators_[rImpl] = generator;
 	}
 
-	RNDNUM_GENERATOR old = instance_->curr_generator_->kind();
+	RNDNUM_GENERATOR old = instance_()->curr_generator_->kind();
 	assert(static_cast<unsigned int>(old) < count);
 
-	instance_->curr_generator_ = generator;
+	instance_()->curr_generator_ = generator;
 	return old;
 }
 
@@ -169,11 +174,12 @@ RandomNumber::doFinalization()
 
 	for (unsigned int i = 0; i < count; ++i) {
 		RNDNUM_GENERATOR rImpl = static_cast<RNDNUM_GENERATOR>(i);
-		generator = instance_->generators_[rImpl];
+		generator = instance_()->generators_[rImpl];
 		if (generator != NULL) {
 			delete generator;
 		}
 	}
-	delete instance_;
+	delete instance_();
+	instance_() = NULL;
 }
 
@@ -83,7 +83,7 @@ protected:
 
 	AbsRndNumGenerator *curr_generator_;
 
-	static RandomNumber *instance_;
+	static RandomNumber *&instance_(void);
 
 	std::map<RNDNUM_GENERATOR, AbsRndNumGenerator*> generators_;
 
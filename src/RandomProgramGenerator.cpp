@@ -82,11 +82,17 @@ FUTURE:
 #include <fstream>
 #include <cstring>
 #include <cstdio>
+#include <sstream>
+#include <vector>
 
 #include "Common.h"
 
 #include "CGOptions.h"
 #include "ProgramGenerator.h"
+#include "GenerationContext.h"
+#include "CommandLine.h"
+#include "GeneratorServer.h"
+#include "ProgramArchive.h"
 
 #include "platform.h"
 #include "random.h"
@@ -97,1045 +103,248 @@ using namespace std;
 ///////////////////////////////////////////////////////////////////////////////
 
 // ----------------------------------------------------------------------------
-// Globals
-
-// Program seed - allow user to regenerate the same program on different
-// platforms.
-static unsigned long g_Seed = 0;
-
-// ----------------------------------------------------------------------------
-static void
-print_version(void)
-{
-	cout << PACKAGE_STRING << endl;
-#ifdef GIT_VERSION
-	cout << "Git version: " << GIT_VERSION << endl;
-#endif
-	// XXX print copyright, contact info, etc.?
-}
-
-// ----------------------------------------------------------------------------
-// ----------------------------------------------------------------------------
-bool parse_string_arg(const char *arg, string &s)
-{
-	s.assign(arg);
-	return ((!s.empty()) && 
-		(s.compare(0, 2, "--")));
-}
-
-static bool
-parse_int_arg(char *arg, unsigned long *ret)
-{
-	int res;
-	res = sscanf (arg, "%lu", ret);
-	
-	if (res == 0) {
-		cout << "expected integer at arg position " << endl;
-		return false;
-	}
-	return true;
-}
-
-static void print_help()
-{
-	cout << "Command line options: " << endl << endl; 
-	// most common options
-	cout << "  --help or -h: print this information." << endl << endl; 
-	cout << "  -hh: describe extra options probably useful only for Csmith developers." << endl << endl; 
-	cout << "  --version or -v: print the version of Csmith." << endl << endl; 
-	cout << "  --seed <seed> or -s <seed>: use <seed> instead of a random seed generated by Csmith." << endl << endl;
-	cout << "  --output <filename> or -o <filename>: specify the output file name." << endl << endl;
-
-	// enabling/disabling options
-	cout << "  --argc | --no-argc: genereate main function with/without argv and argc being passed (enabled by default)." << endl << endl; 
-	cout << "  --arrays | --no-arrays: enable | disable arrays (enabled by default)." << endl << endl;
-	cout << "  --bitfields | --no-bitfields: enable | disable full-bitfields structs (disabled by default)." << endl << endl;
-	cout << "  --checksum | --no-checksum: enable | disable checksum calculation (enabled by default)." << endl << endl;
-	cout << "  --comma-operators | --no-comma-operators: enable | disable comma operators (enabled by default)." << endl << endl;
-	cout << "  --compound-assignment | --no-compound-assignment: enable | disable compound assignments (enabled by default)." << endl << endl; 
-	cout << "  --concise: generated programs with minimal comments (disabled by default)." << endl << endl;
-	cout << "  --consts | --no-consts: enable | disable const qualifier (enabled by default)." << endl << endl;
-	cout << "  --divs | --no-divs: enable | disable divisions (enabled by default)." << endl << endl;
-	cout << "  --embedded-assigns | --no-embedded-assigns: enable | disable embedded assignments as sub-expressions (enabled by default)." << endl << endl;
-	cout << "  --pre-incr-operator | --no-pre-incr-operator: enable | disable pre ++ operator (enabled by default)." << endl << endl;
-	cout << "  --pre-decr-operator | --no-pre-decr-operator: enable | disable pre -- operator (enabled by default)." << endl << endl;
-	cout << "  --post-incr-operator | --no-post-incr-operator: enable | disable post ++ operator (enabled by default)." << endl << endl;
-	cout << "  --post-decr-operator | --no-post-decr-operator: enable | disable post -- operator (enabled by default)." << endl << endl;
-	cout << "  --unary-plus-operator | --no-unary-plus-operator: enable | disable + operator (enabled by default)." << endl << endl;
-	cout << "  --jumps | --no-jumps: enable | disable jumps (enabled by default)." << endl << endl;
-	cout << "  --longlong| --no-longlong: enable | disable long long (enabled by default)." << endl << endl;
-	cout << "  --int8 | --no-int8: enable | disable int8_t (enabled by default)." << endl << endl;
-	cout << "  --uint8 | --no-uint8: enable | disable uint8_t (enabled by default)." << endl << endl;
-	cout << "  --main | --nomain: enable | disable to generate main function (enabled by default)." << endl <<  endl;  
-	cout << "  --math64 | --no-math64: enable | disable 64-bit math ops (enabled by default)." << endl << endl;
-	cout << "  --inline-function | --no-inline-function: enable | disable inline attributes on generated functions." << endl << endl;
-	cout << "  --inline-function-prob <num>: set the probability of each function being marked as inline (default is 50)." << endl << endl;
-
-	// numbered controls	
-	cout << "  --max-array-dim <num>: limit array dimensions to <num>. (default 3)" << endl << endl;
-	cout << "  --max-array-len-per-dim <num>: limit array length per dimension to <num> (default 10)." << endl << endl;
-	cout << "  --max-block-depth <num>: limit depth of nested blocks to <num> (default 5)." << endl << endl;
-	cout << "  --max-block-size <size>: limit the number of non-return statements in a block to <size> (default 4)." << endl << endl; 
-	cout << "  --max-expr-complexity <num>: limit expression complexities to <num> (default 10)." << endl << endl;
-	cout << "  --max-funcs <num>: limit the number of functions (besides main) to <num>  (default 10)." << endl << endl;
-	cout << "  --max-pointer-depth <depth>: limit the indirect depth of pointers to <depth> (default 2)." << endl << endl;
-	cout << "  --max-struct-fields <num>: limit the number of struct fields to <num> (default 10). " << endl << endl;
-	cout << "  --max-union-fields <num>: limit the number of union fields to <num> (default 5). " << endl << endl;
-
-	cout << "  --muls | --no-muls: enable | disable multiplications (enabled by default)." << endl << endl;
-	cout << "  --safe-math | --no-safe-math: Emit safe math wrapper functions (enabled by default)." << endl << endl;
-	cout << "  --packed-struct | --no-packed-struct: enable | disable packed structs by adding #pragma pack(1) before struct definition (disabled by default)." << endl << endl; 
-	cout << "  --paranoid | --no-paranoid: enable | disable pointer-related assertions (disabled by default)." << endl << endl; 
-	cout << "  --pointers | --no-pointers: enable | disable pointers (enabled by default)." << endl << endl;
-	cout << "  --quiet: generate programs with less comments (disabled by default)." << endl << endl; 
-	cout << "  --structs | --no-structs: enable | disable to generate structs (enable by default)." << endl << endl;
-	cout << "  --unions | --no-unions: enable | disable to generate unions (enable by default)." << endl << endl;
-	cout << "  --volatiles | --no-volatiles: enable | disable volatiles (enabled by default)." << endl << endl;
-	cout << "  --volatile-pointers | --no-volatile-pointers: enable | disable volatile pointers (enabled by default)." << endl << endl;
-	cout << "  --const-pointers | --no-const-pointers: enable | disable const pointers (enabled by default)." << endl << endl;
-
-	cout << "  --builtins | --no-builtins: enable | disable to generate builtin functions (disabled by default)." << endl << endl;
-	cout << "  --enable-builtin-kinds k1,k2 | --disable-builtin-kinds k1,k2: enable | disable certain kinds of builtin functions." << endl << endl;
-	cout << "  --builtin-function-prob <num>: set the probability of choosing a builtin function (default is 20)." << endl << endl;
-
-        // language options
-	cout << "  --lang-cpp : generate C++ code (C by default)." << endl << endl;
-
-}
-
-static void print_advanced_help()
-{
-	cout << "'Advanced' command line options that are probably only useful for Csmith's" << endl;
-	cout << "original developers:" << endl << endl;   
-
-	cout << "  --max-nested-struct-level <num>: limit maximum nested level of structs to <num>(default 3). " << endl << endl; 
-
-	cout << "  --compatible-check: disallow trivial code such as i = i in random programs. " << endl << endl;   
-	 
-	// struct/union related options
-	cout << "  --fixed-struct-fields: fix the size of struct fields to max-struct-fields (default 10)." << endl << endl; 
-	cout << "  --return-structs | --no-return-structs: enable | disable return structs from a function (enabled by default)." << endl << endl; 
-	cout << "  --arg-structs | --no-arg-structs: enable | disable structs being used as args (enabled by default)." << endl << endl; 
-	cout << "  --return-unions | --no-return-unions: enable | disable return unions from a function (enabled by default)." << endl << endl; 
-	cout << "  --arg-unions | --no-arg-unions: enable | disable unions being used as args (enabled by default)." << endl << endl; 
-	cout << "  --take-union-field-addr | --take-no-union-field-addr: allow | disallow addresses of union fields to be taken (allowed by default)." << endl << endl; 
-	cout << "  --vol-struct-union-fields | --no-vol-struct-union-fields: enable | disable volatile struct/union fields (enabled by default)" << endl << endl;
-	 
-	// probability options
-	cout << "  --dump-default-probabilities <file>: dump the default probability settings into <file>" << endl << endl;
-	cout << "  --dump-random-probabilities <file>: dump the randomized probabilities into <file>" << endl << endl;
-	cout << "  --probability-configuration <file>: use probability configuration <file>" << endl << endl;
-	cout << "  --random-random: enable random probabilities." << endl << endl;
-
-	// volatile checking options
-	cout << "  --enable-access-once: enable testing access once macro." << endl << endl;
-	cout << "  --strict-volatile-rule: make sure only one volatile access between any pair of sequence points. " << endl << endl;
-
-	cout << "  --addr-taken-of-locals: enable addr-taken of local vars. [default]" << endl << endl;
-	cout << "  --no-addr-taken-of-locals: disable addr-taken of local vars. " << endl << endl;
-
-	cout << "  --fresh-array-ctrl-var-names: create fresh names [i1,i2,i3...] for array control vars rather than use unique names such as i, j, k." << endl << endl;
-
-	// other options
-	cout << "  --math-notmp: make csmith generate code for safe_math_macros_notmp." << endl << endl;
-	 
-	cout << "  --strict-const-arrays: restrict array elements to constants." << endl << endl;
-	
-	cout << "  --partial-expand <assignment[,for[,block[,if-else[,invoke[,return]]]]]: ";
-	cout <<"partial-expand controls which what kind of statements should be generated first. ";
-	cout <<"For example, it could make Csmith start to generate if-else without go over assignment or for." << endl << endl;
-
-	cout << "  --dangling-global-pointers | --no-dangling-global-pointers: enable | disable to reset all dangling global pointers to null at the end of main. (enabled by default)" << endl << endl;
-
-	cout << "  --check-global: print the values of all integer global variables." << endl << endl;
-
-	cout << "  --stop-by-stmt <num>: try to stop generating statements after the statement with id <num>." << endl << endl;
-	
-	cout << "  --const-as-condition: enable const to be conditions of if-statements. " << endl << endl;
-
-	cout << "  --match-exact-qualifiers: match exact const/volatile qualifiers for LHS and RHS of assignments." << endl << endl; 
-
-	cout << "  --return-dead-pointer | --no-return-dead-pointer: allow | disallow functions from returning dangling pointers (disallowed by default)." << endl << endl;
-
-	cout <<	"  --identify-wrappers: assign ids to used safe math wrappers." << endl << endl;
-		 
-	cout << "  --safe-math-wrappers <id1,id2...>: specifiy ids of wrapper functions that are necessary to avoid undefined behaviors, use 0 to specify none." << endl << endl;
-				
-	cout << "  --mark-mutable-const: mark constants that can be mutated with parentheses (disabled by default)." << endl << endl; 
-
-	cout << "  --force-non-uniform-arrays | --no-force-non-uniform-arrays: force integer arrays to be initialized with multiple values (enabled by default)." << endl << endl; 
- 
-	cout << "  --null-ptr-deref-prob <N>: allow null pointers to be dereferenced with probability N% (0 by default)." << endl << endl;
-
-	cout << "  --dangling-ptr-deref-prob <N>: allow dangling pointers to be dereferenced with probability N% (0 by default)." << endl << endl; 
-
-	cout << "  --union-read-type-sensitive | --no-union-read-type-sensitive: allow | disallow reading an union field when there is no risk of "
-		 << "reading padding bits (enabled by default)." << endl << endl; 
-	 
-	cout << "  --no-hash-value-printf: do not emit printf on the index of an array" << endl << endl;
-	cout << "  --no-signed-char-index: do not allow a var of type char to be used as array index" << endl << endl;
-}
-
-void arg_check(int argc, int i)
+// Batch mode: replace every "%s" in the output file template by the seed
+static string
+batch_output_file(const string &templ, unsigned long seed)
 {
-	if (i >= argc) {
-		cout << "expect arg at pos " << i << std::endl;
-		exit(-1);
+	ostringstream ss;
+	ss << seed;
+	string file = templ;
+	size_t pos = 0;
+	while ((pos = file.find("%s", pos)) != string::npos) {
+		file.replace(pos, 2, ss.str());
+		pos += ss.str().length();
 	}
+	return file;
 }
 
-// ----------------------------------------------------------------------------
-int
-main(int argc, char **argv)
+// Batch mode: the command line of a single run that generates the program
+// with the given seed, so that the "Options:" line in the program header is
+// the same as if Csmith had been invoked for this program alone
+static void
+batch_args(int argc, char **argv, unsigned long seed, const string &file,
+		   vector<string> &args)
 {
-	g_Seed = platform_gen_seed();
-
-	CGOptions::set_default_settings();
-			 
-	for (int i=1; i<argc; i++) {
-
-		if (strcmp (argv[i], "--help") == 0 ||
-			strcmp (argv[i], "-h") == 0) {
-			print_help();
-			return 0;
-		}
-
-		if (strcmp (argv[i], "-hh") == 0) {
-			print_advanced_help();
-			return 0;
-		}
-
-		if (strcmp (argv[i], "--version") == 0 ||
-			strcmp (argv[i], "-v") == 0) {
-			print_version();
-			return 0;
-		}
-		
-		if (strcmp (argv[i], "--seed") == 0 ||
-			strcmp (argv[i], "-s") == 0) {
-			i++;
-			arg_check(argc, i);
-
-			if (!parse_int_arg(argv[i], &g_Seed))
-				exit(-1);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-block-size") == 0) {
-			unsigned long size = 0;
+	ostringstream ss;
+	ss << seed;
+	bool has_seed = false;
+	size_t batch_pos = 0;
+
+	args.clear();
+	args.push_back(argv[0]);
+	for (int i = 1; i < argc; i++) {
+		if (strcmp (argv[i], "--count") == 0 ||
+			strcmp (argv[i], "--seed-range") == 0) {
+			batch_pos = args.size();
 			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &size))
-				exit(-1);
-			CGOptions::max_block_size(size);
 			continue;
 		}
-
-		if (strcmp (argv[i], "--max-funcs") == 0) {
-			unsigned long size = 0;
+		if (strcmp (argv[i], "--jobs") == 0 ||
+			strcmp (argv[i], "--archive") == 0) {
 			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &size))
-				exit(-1);
-			CGOptions::max_funcs(size);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--packed-struct") == 0) {
-			CGOptions::packed_struct(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-packed-struct") == 0) {
-			CGOptions::packed_struct(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--bitfields") == 0) {
-			CGOptions::bitfields(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-bitfields") == 0) {
-			CGOptions::bitfields(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--compatible-check") == 0) {
-			CGOptions::compatible_check(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--partial-expand") == 0) {
-			string s;
-			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], s)) {
-				cout << "--partial-expand needs options" << std::endl;
-				exit(-1);
-			}
-			CGOptions::partial_expand(s);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--paranoid") == 0) {
-			CGOptions::paranoid(true);
-			continue;
-		}
-		if (strcmp (argv[i], "--no-paranoid") == 0) {
-			CGOptions::paranoid(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--quiet") == 0) {
-			CGOptions::quiet(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--main") == 0) {
-			CGOptions::nomain(false);
 			continue;
 		}
-
-		if (strcmp (argv[i], "--nomain") == 0) {
-			CGOptions::nomain(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--compound-assignment") == 0) {
-			CGOptions::compound_assignment(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-compound-assignment") == 0) {
-			CGOptions::compound_assignment(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--structs") == 0) {
-			CGOptions::use_struct(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-structs") == 0) {
-			CGOptions::use_struct(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--unions") == 0) {
-			CGOptions::use_union(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-unions") == 0) {
-			CGOptions::use_union(false);
+		args.push_back(argv[i]);
+		if (i + 1 >= argc)
 			continue;
-		}
-
-		if (strcmp (argv[i], "--argc") == 0) {
-			CGOptions::accept_argc(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-argc") == 0) {
-			CGOptions::accept_argc(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--expand-struct") == 0) {
-			CGOptions::expand_struct(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--fixed-struct-fields") == 0) {
-			CGOptions::fixed_struct_fields(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-struct-fields") ==0 ) {
-			unsigned long ret;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &ret))
-				exit(-1);
-			CGOptions::max_struct_fields(ret);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-union-fields") ==0 ) {
-			unsigned long ret;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &ret))
-				exit(-1);
-			CGOptions::max_union_fields(ret);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-nested-struct-level") ==0 ) {
-			unsigned long ret;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &ret))
-				exit(-1);
-			CGOptions::max_nested_struct_level(ret);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--dfs-debug-sequence") == 0) {
-			string s;
-			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], s))
-				exit(-1);
-			CGOptions::dfs_debug_sequence(s);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-pointer-depth") ==0 ) {
-			unsigned long ret;
+		if (strcmp (argv[i], "--seed") == 0 ||
+			strcmp (argv[i], "-s") == 0) {
+			args.push_back(ss.str());
+			has_seed = true;
 			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &ret))
-				exit(-1);
-			CGOptions::max_indirect_level(ret);
-			continue;
 		}
-
-		if (strcmp (argv[i], "--output") == 0 ||
+		else if (strcmp (argv[i], "--output") == 0 ||
 			strcmp (argv[i], "-o") == 0) {
-			string o_file;
+			args.push_back(file);
 			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], o_file))
-				exit(-1);
-			CGOptions::output_file(o_file);
-			continue;
-		}    
-
-		if (strcmp (argv[i], "--math-notmp") == 0) {
-			CGOptions::math_notmp(true);
-			continue;
 		}
+	}
+	if (!has_seed) {
+		args.insert(args.begin() + batch_pos, ss.str());
+		args.insert(args.begin() + batch_pos, "--seed");
+	}
+}
 
-		if (strcmp (argv[i], "--math64") == 0) {
-			CGOptions::math64(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-math64") == 0) {
-			CGOptions::math64(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--inline-function") == 0) {
-			CGOptions::inline_function(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-inline-function") == 0) {
-			CGOptions::inline_function(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--longlong") == 0) {
-			CGOptions::longlong(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-longlong") == 0) {
-			CGOptions::longlong(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--int8") == 0) {
-			CGOptions::int8(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-int8") == 0) {
-			CGOptions::int8(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--uint8") == 0) {
-			CGOptions::uint8(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-uint8") == 0) {
-			CGOptions::uint8(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--pointers") == 0) {
-			CGOptions::pointers(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-pointers") == 0) {
-			CGOptions::pointers(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-array-dim") ==0 ) {
-			unsigned long dim;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &dim))
-				exit(-1);
-			CGOptions::max_array_dimensions(dim);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-array-len-per-dim") ==0 ) {
-			unsigned long length;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &length))
-				exit(-1);
-			CGOptions::max_array_length_per_dimension(length);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--arrays") == 0) {
-			CGOptions::arrays(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-arrays") == 0) {
-			CGOptions::arrays(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--strict-const-arrays") == 0) {
-			CGOptions::strict_const_arrays(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--jumps") == 0) {
-			CGOptions::jumps(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-jumps") == 0) {
-			CGOptions::jumps(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--return-structs") == 0) {
-			CGOptions::return_structs(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-return-structs") == 0) {
-			CGOptions::return_structs(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--arg-structs") == 0) {
-			CGOptions::arg_structs(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-arg-structs") == 0) {
-			CGOptions::arg_structs(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--return-unions") == 0) {
-			CGOptions::return_unions(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-return-unions") == 0) {
-			CGOptions::return_unions(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--arg-unions") == 0) {
-			CGOptions::arg_unions(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-arg-unions") == 0) {
-			CGOptions::arg_unions(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--volatiles") == 0) {
-			CGOptions::volatiles(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-volatiles") == 0) {
-			CGOptions::volatiles(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--volatile-pointers") == 0) {
-			CGOptions::volatile_pointers(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-volatile-pointers") == 0) {
-			CGOptions::volatile_pointers(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--const-pointers") == 0) {
-			CGOptions::const_pointers(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-const-pointers") == 0) {
-			CGOptions::const_pointers(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--enable-access-once") == 0) {
-			CGOptions::access_once(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--strict-volatile-rule") == 0) {
-			CGOptions::strict_volatile_rule(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--addr-taken-of-locals") == 0) {
-			CGOptions::addr_taken_of_locals(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-addr-taken-of-locals") == 0) {
-			CGOptions::addr_taken_of_locals(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--fresh-array-ctrl-var-names") == 0) {
-			CGOptions::fresh_array_ctrl_var_names(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--consts") == 0) {
-			CGOptions::consts(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-consts") == 0) {
-			CGOptions::consts(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--dangling-global-pointers") == 0) {
-			CGOptions::dangling_global_ptrs(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-dangling-global-pointers") == 0) {
-			CGOptions::dangling_global_ptrs(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--divs") == 0) {
-			CGOptions::divs(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-divs") == 0) {
-			CGOptions::divs(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--muls") == 0) {
-			CGOptions::muls(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-muls") == 0) {
-			CGOptions::muls(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--checksum") == 0) {
-			CGOptions::compute_hash(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-checksum") == 0) {
-			CGOptions::compute_hash(false);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--builtins") == 0) {
-			CGOptions::builtins(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-builtins") == 0) {
-			CGOptions::builtins(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--random-random") == 0) {
-			CGOptions::random_random(true);
-			continue;
-		}
-		
-		if (strcmp (argv[i], "--check-global") == 0) {
-			CGOptions::blind_check_global(true);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--stop-by-stmt") ==0 ) {
-			unsigned long num;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &num))
-				exit(-1);
-			CGOptions::stop_by_stmt(num);
+// Server mode: the command line without the program name and the --serve
+// options, which applies to every request
+static vector<string>
+server_args(int argc, char **argv)
+{
+	vector<string> args;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp (argv[i], "--serve") == 0 ||
+			strcmp (argv[i], "--fork-server") == 0)
 			continue;
-		}  
-
-		if (strcmp (argv[i], "--dump-default-probabilities") == 0) {
-			string filename;
+		if (strcmp (argv[i], "--serve-socket") == 0) {
 			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], filename)) {
-				cout<< "please pass probability configuration output file!" << std::endl;
-				exit(-1);
-			}
-			CGOptions::dump_default_probabilities(filename);
 			continue;
 		}
+		args.push_back(argv[i]);
+	}
+	return args;
+}
 
-		if (strcmp (argv[i], "--dump-random-probabilities") == 0) {
-			string filename;
-			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], filename)) {
-				cout<< "please pass probability configuration output file!" << std::endl;
-				exit(-1);
+// Batch mode: generate the program for one seed in a fresh generation
+// context, which makes it independent of the programs generated before it
+// and of those generated concurrently on other threads
+static void
+batch_generate(int argc, char **argv, const string &templ, unsigned long seed,
+			   ProgramArchive *archive)
+{
+	string file = batch_output_file(templ, seed);
+	vector<string> args;
+	batch_args(argc, argv, seed, file, args);
+	vector<char *> args_v;
+	for (size_t j = 0; j < args.size(); j++)
+		args_v.push_back(const_cast<char *>(args[j].c_str()));
+	args_v.push_back(NULL);
+
+	GenerationContext ctx;
+	GenerationContext::set_current(&ctx);
+	ostringstream program;
+	if (archive)
+		ctx.output_stream = &program;
+	else
+		ctx.output_file = file;
+	unsigned long long start = platform_get_usecs();
+	ProgramGenerator *generator = ProgramGenerator::CreateInstance(static_cast<int>(args.size()), &args_v[0], seed);
+	if (!generator) {
+		cout << "error: can't create generator!" << std::endl;
+		exit(-1);
+	}
+	generator->Init();
+	generator->GoGenerator();
+	delete generator;
+	GenerationContext::set_current(NULL);
+
+	if (archive) {
+		// the options without the seed, so that programs generated with
+		// the same options share the hash
+		string options;
+		for (size_t j = 1; j < args.size(); j++) {
+			if ((args[j] == "--seed" || args[j] == "-s") && j + 1 < args.size()) {
+				j++;
+				continue;
 			}
-			CGOptions::dump_random_probabilities(filename);
-			continue;
+			options += " " + args[j];
 		}
+		archive->append(seed, ProgramArchive::hash_options(options), program.str(),
+						platform_get_usecs() - start);
+	}
+}
 
-		if (strcmp (argv[i], "--probability-configuration") == 0) {
-			string filename;
-			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], filename)) {
-				cout<< "please probability configuration file!" << std::endl;
-				exit(-1);
-			}
-			CGOptions::probability_configuration(filename);
-			continue;
-		}
+// Batch mode with --jobs: the seeds handed out to the worker threads
+struct BatchJobs {
+	int argc;
+	char **argv;
+	string templ;
+	ProgramArchive *archive;
+	unsigned long first;
+	unsigned long count;
+	volatile long next;
+};
 
-		if (strcmp (argv[i], "--const-as-condition") == 0) {
-			CGOptions::const_as_condition(true);
-			continue;
-		} 
+static void
+batch_worker(void *p)
+{
+	BatchJobs *jobs = static_cast<BatchJobs *>(p);
+	for (;;) {
+		unsigned long i = static_cast<unsigned long>(platform_fetch_and_inc(&jobs->next));
+		if (i >= jobs->count)
+			break;
+		batch_generate(jobs->argc, jobs->argv, jobs->templ, jobs->first + i, jobs->archive);
+	}
+}
 
-		if (strcmp (argv[i], "--match-exact-qualifiers") == 0) {
-			CGOptions::match_exact_qualifiers(true);
-			continue;
-		}
+// ----------------------------------------------------------------------------
+int
+main(int argc, char **argv)
+{
+	CommandLine cl;
+	switch (cl.parse(argc, argv, cout)) {
+	case eCmdGenerate:
+		break;
+	case eCmdDone:
+		return 0;
+	default:
+		exit(-1);
+	}
 
-		if (strcmp (argv[i], "--no-return-dead-pointer") == 0) {
-			CGOptions::no_return_dead_ptr(true);
-			continue;
+	if (cl.serve) {
+		if (cl.batch || cl.jobs > 1) {
+			cout << "error: --serve can't be combined with batch mode" << std::endl;
+			exit(-1);
 		}
-
-		if (strcmp (argv[i], "--return-dead-pointer") == 0) {
-			CGOptions::no_return_dead_ptr(false);
-			continue;
+		GeneratorServer server(server_args(argc, argv), cl.fork_server);
+		if (cl.serve_socket.empty()) {
+			server.serve(stdin, stdout);
+			return 0;
 		}
+		return server.serve_socket(cl.serve_socket) ? 0 : -1;
+	}
 
-		if (strcmp (argv[i], "--concise") == 0) {
-			//CGOptions::quiet(true);
-			//CGOptions::paranoid(false);
-			CGOptions::concise(true);
-			continue;
-		}
+	if (cl.fork_server) {
+		cout << "error: --fork-server needs --serve or --serve-socket" << std::endl;
+		exit(-1);
+	}
 
-		if (strcmp (argv[i], "--identify-wrappers") == 0) {
-			CGOptions::identify_wrappers(true);
-			continue;
-		}
+	if (!cl.archive.empty() && !cl.batch) {
+		cout << "error: --archive needs --count or --seed-range" << std::endl;
+		exit(-1);
+	}
 
-		if (strcmp (argv[i], "--safe-math-wrappers") == 0) {
-			string ids;
-			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], ids)) {
-				cout<< "please specify safe math wrappers in the form of id1,id2..." << std::endl;
+	if (cl.batch) {
+		string templ = CGOptions::output_file();
+		ProgramArchive archive;
+		if (!cl.archive.empty()) {
+			if (!templ.empty()) {
+				cout << "error: --archive replaces --output" << std::endl;
 				exit(-1);
 			}
-			CGOptions::safe_math_wrapper(ids);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--mark-mutable-const") == 0) {
-			CGOptions::mark_mutable_const(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--force-globals-static") == 0) {
-			CGOptions::force_globals_static(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--force-non-uniform-arrays") == 0) {
-			CGOptions::force_non_uniform_array_init(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-force-non-uniform-arrays") == 0) {
-			CGOptions::force_non_uniform_array_init(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--inline-function-prob") == 0 ) {
-			unsigned long prob;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &prob))
-				exit(-1);
-			CGOptions::inline_function_prob(prob);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--builtin-function-prob") == 0 ) {
-			unsigned long prob;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &prob))
-				exit(-1);
-			CGOptions::builtin_function_prob(prob);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--enable-builtin-kinds") == 0) {
-			string kinds;
-			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], kinds)) {
-				cout<< "please specify enabled builtin kinds in the form of k1,k2..." << std::endl;
+			if (!archive.open(cl.archive)) {
+				cout << "error: can't open archive " << cl.archive << std::endl;
 				exit(-1);
 			}
-			CGOptions::enable_builtin_kinds(kinds);
-			continue;
 		}
-
-		if (strcmp (argv[i], "--disable-builtin-kinds") == 0) {
-			string kinds;
-			i++;
-			arg_check(argc, i);
-			if (!parse_string_arg(argv[i], kinds)) {
-				cout<< "please specify disabled builtin kinds in the form of k1,k2..." << std::endl;
+		else if (templ.find("%s") == string::npos) {
+			cout << "error: batch mode needs an output file name containing %s" << std::endl;
+			exit(-1);
+		}
+		ProgramArchive *to_archive = cl.archive.empty() ? NULL : &archive;
+		if (cl.batch_count) {
+			cl.batch_first = cl.seed;
+			cl.batch_last = cl.seed + cl.batch_count - 1;
+		}
+
+		if (cl.jobs > 1) {
+			BatchJobs work;
+			work.argc = argc;
+			work.argv = argv;
+			work.templ = templ;
+			work.archive = to_archive;
+			work.first = cl.batch_first;
+			work.count = cl.batch_last - cl.batch_first + 1;
+			work.next = 0;
+			if (!platform_run_threads(static_cast<int>(cl.jobs), batch_worker, &work)) {
+				cout << "error: can't create threads for --jobs" << std::endl;
 				exit(-1);
 			}
-			CGOptions::disable_builtin_kinds(kinds);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--null-ptr-deref-prob") == 0 ) {
-			unsigned long prob;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &prob))
-				exit(-1);
-			CGOptions::null_pointer_dereference_prob(prob);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--dangling-ptr-deref-prob") == 0 ) {
-			unsigned long prob;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &prob))
-				exit(-1);
-			CGOptions::dead_pointer_dereference_prob(prob);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-expr-complexity") == 0 ) {
-			unsigned long comp;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &comp))
-				exit(-1);
-			CGOptions::max_expr_depth(comp);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--max-block-depth") == 0 ) {
-			unsigned long depth;
-			i++;
-			arg_check(argc, i);
-			if (!parse_int_arg(argv[i], &depth))
-				exit(-1);
-			CGOptions::max_blk_depth(depth);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--union-read-type-sensitive") == 0) {
-			CGOptions::union_read_type_sensitive(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-union-read-type-sensitive") == 0) {
-			CGOptions::union_read_type_sensitive(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--pre-incr-operator") == 0) {
-			CGOptions::pre_incr_operator(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-pre-incr-operator") == 0) {
-			CGOptions::pre_incr_operator(false);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--pre-decr-operator") == 0) {
-			CGOptions::pre_decr_operator(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-pre-decr-operator") == 0) {
-			CGOptions::pre_decr_operator(false);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--post-incr-operator") == 0) {
-			CGOptions::post_incr_operator(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-post-incr-operator") == 0) {
-			CGOptions::post_incr_operator(false);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--post-decr-operator") == 0) {
-			CGOptions::post_decr_operator(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-post-decr-operator") == 0) {
-			CGOptions::post_decr_operator(false);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--unary-plus-operator") == 0) {
-			CGOptions::unary_plus_operator(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-unary-plus-operator") == 0) {
-			CGOptions::unary_plus_operator(false);
-			continue;
-		} 
-
-		if (strcmp (argv[i], "--embedded-assigns") == 0) {
-			CGOptions::use_embedded_assigns(true);
-			continue;
-		}
-
-        if (strcmp (argv[i], "--no-safe-math") == 0){
-            CGOptions::avoid_signed_overflow(false);
-            continue;
-        }
-
-        if (strcmp (argv[i], "--safe-math") == 0){
-            CGOptions::avoid_signed_overflow(true);
-            continue;
-        }
-
-		if (strcmp (argv[i], "--no-embedded-assigns") == 0) {
-			CGOptions::use_embedded_assigns(false);
-			continue;
-		} 
-	
-		if (strcmp (argv[i], "--comma-operators") == 0) {
-			CGOptions::use_comma_exprs(true);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--no-comma-operators") == 0) {
-			CGOptions::use_comma_exprs(false);
-			continue;
-		}  
-
-		if (strcmp (argv[i], "--take-no-union-field-addr") == 0) {
-			CGOptions::take_union_field_addr(false);
-			continue;
-		}
-
-		if (strcmp (argv[i], "--take-union-field-addr") == 0) {
-			CGOptions::take_union_field_addr(true);
-			continue;
-		}  
-
-		if (strcmp (argv[i], "--vol-struct-union-fields") == 0) {
-			CGOptions::vol_struct_union_fields(true);
-			continue;
-		}  
-
-		if (strcmp (argv[i], "--no-vol-struct-union-fields") == 0) {
-			CGOptions::vol_struct_union_fields(false);
-			continue;
-		}  
-
-		if (strcmp (argv[i], "--no-hash-value-printf") == 0) {
-			CGOptions::hash_value_printf(false);
-			continue;
+			return 0;
 		}
 
-		if (strcmp (argv[i], "--no-signed-char-index") == 0) {
-			CGOptions::signed_char_index(false);
-			continue;
+		for (unsigned long seed = cl.batch_first; ; seed++) {
+			batch_generate(argc, argv, templ, seed, to_archive);
+			if (seed == cl.batch_last)
+				break;
 		}
-
-		if (strcmp (argv[i], "--lang-cpp") == 0) {
-			CGOptions::lang_cpp(true);
-			continue;
-		} 
-
-		// OMIT help
-
-		// OMIT compute-hash
-		
-		// OMIT depth-protect
-		
-		// OMIT wrap-volatiles
-		
-		// OMIT allow-const-volatile
-		
-		// OMIT allow-int64
-		
-		// OMIT avoid-signed-overflow
-
-		// FIXME-- we should parse all options and then this should be
-		// an error
-		
-		cout << "invalid option " << argv[i] << " at: "
-			 << i 
-			 << endl;
-		exit(-1);
+		return 0;
 	}
-
-	if (CGOptions::has_conflict()) {
-		cout << "error: options conflict - " << CGOptions::conflict_msg() << std::endl;
+	if (cl.jobs > 1) {
+		cout << "error: --jobs needs --count or --seed-range" << std::endl;
 		exit(-1);
 	}
 
-	ProgramGenerator *generator = ProgramGenerator::CreateInstance(argc, argv, g_Seed);
+	ProgramGenerator *generator = ProgramGenerator::CreateInstance(argc, argv, cl.seed);
 	if (!generator) {
 		cout << "error: can't create generator!" << std::endl;
 		exit(-1);
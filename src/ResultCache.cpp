@@ -0,0 +1,377 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+#include "ResultCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <utime.h>
+
+#include "platform.h"
+
+using namespace std;
+
+static const char entry_magic[] = "csmith-cache 1";
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Two lanes of 64-bit FNV-1a, with different bases and the bytes of the
+// second lane scrambled, give a 128-bit key; each field is preceded by its
+// length, so that fields cannot run into each other
+class KeyHash
+{
+public:
+	KeyHash(void) {
+		h_[0] = 14695981039346656037ULL;
+		h_[1] = 0x6c62272e07bb0142ULL;
+	}
+
+	void add(const string &s) {
+		uint64_t n = s.size();
+		for (int i = 0; i < 8; i++)
+			add_byte(static_cast<unsigned char>(n >> (8 * i)));
+		for (size_t i = 0; i < s.size(); i++)
+			add_byte(static_cast<unsigned char>(s[i]));
+	}
+
+	string hex(void) const {
+		char buf[33];
+		sprintf(buf, "%016llx%016llx", static_cast<unsigned long long>(h_[0]),
+				static_cast<unsigned long long>(h_[1]));
+		return buf;
+	}
+
+private:
+	void add_byte(unsigned char c) {
+		h_[0] = (h_[0] ^ c) * 1099511628211ULL;
+		h_[1] = (h_[1] ^ (c ^ 0x5c)) * 1099511628211ULL;
+	}
+
+	uint64_t h_[2];
+};
+
+static bool
+read_whole_file(const string &file, string &data)
+{
+	ifstream in(file.c_str(), ios::binary);
+	if (!in)
+		return false;
+	ostringstream s;
+	s << in.rdbuf();
+	data = s.str();
+	return true;
+}
+
+// the file names in a directory, without "." and ".."
+static vector<string>
+list_dir(const string &dir)
+{
+	vector<string> names;
+	DIR *d = opendir(dir.c_str());
+	if (!d)
+		return names;
+	struct dirent *e;
+	while ((e = readdir(d)) != NULL) {
+		if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0)
+			names.push_back(e->d_name);
+	}
+	closedir(d);
+	return names;
+}
+
+// The headers (*.h) in dir, by name, size and contents, in name order
+static void
+add_headers(KeyHash &h, const string &dir)
+{
+	vector<string> names = list_dir(dir);
+	sort(names.begin(), names.end());
+	h.add(dir);
+	for (size_t i = 0; i < names.size(); i++) {
+		const string &name = names[i];
+		if (name.size() < 2 || name.compare(name.size() - 2, 2, ".h") != 0)
+			continue;
+		string data;
+		if (!read_whole_file(dir + "/" + name, data))
+			continue;
+		h.add(name);
+		h.add(data);
+	}
+}
+
+// The include directories of a command line: -I, -iquote and -isystem,
+// with the directory attached or in the next word
+static void
+add_include_dirs(KeyHash &h, const string &command)
+{
+	static const char *const options[] = { "-I", "-iquote", "-isystem" };
+	istringstream words(command);
+	string w;
+	while (words >> w) {
+		for (size_t i = 0; i < sizeof(options) / sizeof(options[0]); i++) {
+			size_t len = strlen(options[i]);
+			if (w.compare(0, len, options[i]) != 0)
+				continue;
+			string dir = w.substr(len);
+			if (dir.empty())
+				words >> dir;
+			if (!dir.empty())
+				add_headers(h, dir);
+			break;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResultCache::ResultCache(const string &dir, unsigned long max_entries)
+	: dir_(dir),
+	  max_entries_(max_entries)
+{
+}
+
+string
+ResultCache::default_dir(void)
+{
+	const char *dir = getenv("CSMITH_CACHE_DIR");
+	if (dir && *dir)
+		return dir;
+	const char *home = getenv("HOME");
+	return string(home ? home : ".") + "/.cache/csmith";
+}
+
+string
+ResultCache::compiler_identity(const string &compiler)
+{
+	istringstream words(compiler);
+	string prog;
+	words >> prog;
+	if (prog.empty())
+		return "";
+
+	string file = prog;
+	if (prog.find('/') == string::npos) {
+		const char *path = getenv("PATH");
+		istringstream dirs(path ? path : "");
+		string d;
+		file.clear();
+		while (getline(dirs, d, ':')) {
+			string f = (d.empty() ? "." : d) + "/" + prog;
+			if (access(f.c_str(), X_OK) == 0) {
+				file = f;
+				break;
+			}
+		}
+		if (file.empty())
+			return prog;
+	}
+	char real[PATH_MAX];
+	if (realpath(file.c_str(), real))
+		file = real;
+	struct stat st;
+	if (stat(file.c_str(), &st) != 0)
+		return file;
+	ostringstream id;
+	id << file << " " << st.st_size << " " << st.st_mtime << " " << st.st_ino;
+	return id.str();
+}
+
+string
+ResultCache::key(const string &program, const string &compiler, const string &flags,
+				 const string &source_dir)
+{
+	KeyHash h;
+	h.add(program);
+	h.add(compiler);
+	h.add(compiler_identity(compiler));
+	h.add(flags);
+	add_include_dirs(h, compiler + " " + flags);
+	if (!source_dir.empty())
+		add_headers(h, source_dir);
+	return h.hex();
+}
+
+string
+ResultCache::find_checksum(const string &output)
+{
+	size_t pos = output.find("checksum = ");
+	if (pos == string::npos)
+		return "";
+	pos += strlen("checksum = ");
+	size_t end = output.find_first_of("\r\n", pos);
+	return output.substr(pos, end == string::npos ? string::npos : end - pos);
+}
+
+string
+ResultCache::path(const string &key) const
+{
+	return dir_ + "/" + key.substr(0, 2) + "/" + key.substr(2);
+}
+
+bool
+ResultCache::lookup(const string &key, Entry &entry)
+{
+	string file = path(key);
+	string data;
+	if (!read_whole_file(file, data))
+		return false;
+
+	istringstream in(data);
+	string line, word;
+	if (!getline(in, line) || line != entry_magic)
+		return false;
+	int ran = 0;
+	size_t compiler_len = 0, program_len = 0;
+	in >> word >> entry.compile_status;
+	if (word != "compile")
+		return false;
+	in >> word >> ran >> entry.run_status;
+	if (word != "run")
+		return false;
+	in >> word;
+	if (word != "checksum")
+		return false;
+	in.get();
+	getline(in, entry.checksum);
+	in >> word >> compiler_len;
+	if (word != "compiler-output" || in.get() != '\n')
+		return false;
+	entry.compiler_output.resize(compiler_len);
+	if (compiler_len)
+		in.read(&entry.compiler_output[0], compiler_len);
+	in >> word >> program_len;
+	if (word != "program-output" || in.get() != '\n')
+		return false;
+	entry.program_output.resize(program_len);
+	if (program_len)
+		in.read(&entry.program_output[0], program_len);
+	if (!in)
+		return false;
+	entry.ran = (ran != 0);
+
+	// the entry was used, which keeps it from being trimmed soon
+	utime(file.c_str(), NULL);
+	return true;
+}
+
+bool
+ResultCache::store(const string &key, const Entry &entry)
+{
+	string file = path(key);
+	create_dir(dir_.c_str());
+	create_dir((dir_ + "/" + key.substr(0, 2)).c_str());
+
+	ostringstream tmp;
+	tmp << file << ".tmp" << getpid() << "-" << platform_get_usecs();
+	{
+		ofstream out(tmp.str().c_str(), ios::binary);
+		out << entry_magic << "\n"
+			<< "compile " << entry.compile_status << "\n"
+			<< "run " << (entry.ran ? 1 : 0) << " " << entry.run_status << "\n"
+			<< "checksum " << entry.checksum << "\n"
+			<< "compiler-output " << entry.compiler_output.size() << "\n" << entry.compiler_output
+			<< "program-output " << entry.program_output.size() << "\n" << entry.program_output;
+		if (!out) {
+			unlink(tmp.str().c_str());
+			return false;
+		}
+	}
+	if (rename(tmp.str().c_str(), file.c_str()) != 0) {
+		unlink(tmp.str().c_str());
+		return false;
+	}
+
+	// the keys are uniformly spread, so this trims after about every 256th
+	// store without keeping count
+	if (key.compare(key.size() - 2, 2, "00") == 0)
+		trim();
+	return true;
+}
+
+unsigned long
+ResultCache::trim(void)
+{
+	vector<pair<time_t, string> > files;
+	vector<string> subdirs = list_dir(dir_);
+	for (size_t i = 0; i < subdirs.size(); i++) {
+		string sub = dir_ + "/" + subdirs[i];
+		vector<string> names = list_dir(sub);
+		for (size_t j = 0; j < names.size(); j++) {
+			string file = sub + "/" + names[j];
+			struct stat st;
+			if (stat(file.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+				files.push_back(make_pair(st.st_mtime, file));
+		}
+	}
+	if (files.size() <= max_entries_)
+		return files.size();
+
+	// down to 90% of the limit, so that the next trim is not due at once
+	sort(files.begin(), files.end());
+	size_t drop = files.size() - max_entries_ + max_entries_ / 10;
+	drop = min(drop, files.size());
+	for (size_t i = 0; i < drop; i++)
+		unlink(files[i].second.c_str());
+	return files.size() - drop;
+}
+
+unsigned long
+ResultCache::clear(void)
+{
+	unsigned long n = 0;
+	vector<string> subdirs = list_dir(dir_);
+	for (size_t i = 0; i < subdirs.size(); i++) {
+		string sub = dir_ + "/" + subdirs[i];
+		vector<string> names = list_dir(sub);
+		for (size_t j = 0; j < names.size(); j++) {
+			if (unlink((sub + "/" + names[j]).c_str()) == 0)
+				n++;
+		}
+		rmdir(sub.c_str());
+	}
+	return n;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,114 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+/// Class Description
+///
+/// An on-disk cache of compile and run results for the drivers, so that
+/// reductions and re-runs over old seeds do not compile and run the same
+/// program with the same compiler again.  An entry is keyed by a hash of
+/// the program text, the compiler command, the identity of the compiler
+/// binary (its resolved path, size, modification time and inode), the
+/// flags, and the headers in the include directories the command and the
+/// flags name, so that a change to csmith.h or safe_math.h is a miss.  It
+/// holds the exit status of the compiler and its output, and, if the
+/// program was run, its exit status, its output and the checksum.
+///
+/// Entries live in <dir>/<xx>/<rest of the hash>, one small file each,
+/// written to a temporary file and renamed into place, so several
+/// processes can share a cache.  A hit touches the entry; now and then a
+/// store trims the cache to its size limit, oldest entries first.
+///
+/// Results that depend on the load of the machine are not cached: a
+/// compiler or a program that timed out is tried again next time.
+///
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <string>
+#include "CommonMacros.h"
+
+class ResultCache
+{
+public:
+	struct Entry {
+		// exit statuses as a shell reports them, 128 + the signal if killed
+		int compile_status;
+		std::string compiler_output;
+		bool ran;
+		int run_status;
+		std::string program_output;
+		std::string checksum;
+
+		Entry(void) : compile_status(0), ran(false), run_status(0) {}
+	};
+
+	// the cache in dir, keeping at most max_entries results
+	ResultCache(const std::string &dir, unsigned long max_entries);
+
+	~ResultCache(void) {}
+
+	// $CSMITH_CACHE_DIR, or ~/.cache/csmith
+	static std::string default_dir(void);
+
+	static const unsigned long default_max_entries = 100000;
+
+	// source_dir, if given, is where the program is compiled from, whose
+	// headers quoted includes find first
+	static std::string key(const std::string &program, const std::string &compiler,
+						   const std::string &flags, const std::string &source_dir = "");
+
+	// the resolved path, size, modification time and inode of the first
+	// word of a compiler command
+	static std::string compiler_identity(const std::string &compiler);
+
+	// the first line of the output of a run with "checksum = ", without it
+	static std::string find_checksum(const std::string &output);
+
+	bool lookup(const std::string &key, Entry &entry);
+
+	bool store(const std::string &key, const Entry &entry);
+
+	// drop the oldest entries beyond the size limit; returns how many are left
+	unsigned long trim(void);
+
+	// drop every entry; returns how many there were
+	unsigned long clear(void);
+
+	const std::string &dir(void) const { return dir_; }
+
+private:
+	std::string path(const std::string &key) const;
+
+	const std::string dir_;
+
+	const unsigned long max_entries_;
+
+	DISALLOW_COPY_AND_ASSIGN(ResultCache);
+};
+
+#endif // RESULT_CACHE_H
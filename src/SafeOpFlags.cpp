@@ -36,10 +36,15 @@
 #include "random.h"
 
 #include "Probabilities.h" 
+#include "GenerationContext.h"
 
 using namespace std;
 
-vector<string> SafeOpFlags::wrapper_names;
+vector<string> &
+SafeOpFlags::wrapper_names(void)
+{
+	return GenerationContext::current().wrapper_names;
+}
 
 SafeOpFlags::SafeOpFlags()
 {
@@ -245,11 +250,11 @@ SafeOpFlags::to_string(enum eUnaryOps op) const
 int 
 SafeOpFlags::to_id(std::string fname)
 { 
-	for (size_t i=0; i<wrapper_names.size(); i++) {
-		if (wrapper_names[i] == fname) {
+	for (size_t i=0; i<wrapper_names().size(); i++) {
+		if (wrapper_names()[i] == fname) {
 			return i+1;
 		}
 	}
-	wrapper_names.push_back(fname);
-	return wrapper_names.size();
+	wrapper_names().push_back(fname);
+	return wrapper_names().size();
 }
@@ -87,7 +87,9 @@ public:
 
 	~SafeOpFlags();
 
-	static std::vector<std::string> wrapper_names;;
+	static std::vector<std::string> &wrapper_names(void);
+
+	static void doFinalization(void) { wrapper_names().clear(); }
 private:
 	bool op1_;
 	bool op2_;
@@ -33,10 +33,19 @@
 #include <iostream>
 #include <string>
 #include "LinearSequence.h" 
+#include "GenerationContext.h"
 
-std::set<Sequence*> SequenceFactory::seqs_;
+std::set<Sequence*> &
+SequenceFactory::seqs_(void)
+{
+	return GenerationContext::current().sequences;
+}
 
-char SequenceFactory::current_sep_char_ = '_';
+char &
+SequenceFactory::current_sep_char_(void)
+{
+	return GenerationContext::current().sequence_sep_char;
+}
 
 Sequence*
 SequenceFactory::make_sequence()
@@ -44,10 +53,10 @@ SequenceFactory::make_sequence()
 	Sequence *seq = NULL;
 
 	seq = new LinearSequence(LinearSequence::default_sep_char);
-	current_sep_char_ = LinearSequence::default_sep_char; 
+	current_sep_char_() = LinearSequence::default_sep_char; 
 
 	assert(seq);
-	seqs_.insert(seq);
+	seqs_().insert(seq);
 	return seq;
 }
 
@@ -55,9 +64,9 @@ void
 SequenceFactory::destroy_sequences()
 {
 	std::set<Sequence*>::iterator i;
-	for(i = seqs_.begin(); i != seqs_.end(); ++i) {
+	for(i = seqs_().begin(); i != seqs_().end(); ++i) {
 		delete *i;
 	}
-	seqs_.clear();
+	seqs_().clear();
 }
 
@@ -40,12 +40,12 @@ public:
 
 	static void destroy_sequences();
 
-	static char current_sep_char() { return current_sep_char_; }
+	static char current_sep_char() { return current_sep_char_(); }
 
 private:
-	static std::set<Sequence*> seqs_;
+	static std::set<Sequence*> &seqs_(void);
 
-	static char current_sep_char_;
+	static char &current_sep_char_(void);
 };
 
 #endif // SEQUENCE_FACTORY_H
@@ -78,9 +78,19 @@
 #include "util.h"
 #include "StringUtils.h"
 #include "VariableSelector.h"
+#include "Profiler.h"
+#include "MemoryAccounting.h"
+#include "ProgramSize.h"
+#include "GenerationBudget.h"
+#include "ExecCost.h"
+#include "GenerationContext.h"
 
 using namespace std;
-const Statement* Statement::failed_stm;
+const Statement *&
+Statement::failed_stm(void)
+{
+	return GenerationContext::current().failed_stm;
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 class StatementFilter : public Filter
@@ -108,24 +118,37 @@ StatementFilter::~StatementFilter(void)
 
 // use a table to define probabilities of different kinds of statements
 // Must initialize it before use
-ProbabilityTable<unsigned int, ProbName> *Statement::stmtTable_ = NULL;
+ProbabilityTable<unsigned int, ProbName> *&
+Statement::stmtTable_(void)
+{
+	return GenerationContext::current().stmt_table;
+}
 
 void
 Statement::InitProbabilityTable()
 {
-	if (Statement::stmtTable_)
+	if (Statement::stmtTable_())
 		return;
 
-	Statement::stmtTable_ = new ProbabilityTable<unsigned int, ProbName>();
-	Statement::stmtTable_->initialize(pStatementProb);
+	Statement::stmtTable_() = new ProbabilityTable<unsigned int, ProbName>();
+	Statement::stmtTable_()->initialize(pStatementProb);
+}
+
+void
+Statement::doFinalization(void)
+{
+	delete Statement::stmtTable_();
+	Statement::stmtTable_() = NULL;
+	Statement::failed_stm() = NULL;
+	Statement::sid() = 0;
 }
 
 eStatementType
 Statement::number_to_type(unsigned int value)
 {
-	assert(Statement::stmtTable_);
+	assert(Statement::stmtTable_());
 	assert(value < 100);
-	ProbName pname = Statement::stmtTable_->get_value(value);
+	ProbName pname = Statement::stmtTable_()->get_value(value);
 	eStatementType type = static_cast<eStatementType>(Probabilities::pname_to_type(pname));
 	return type;
 }
@@ -152,11 +175,23 @@ bool StatementFilter::filter(int value) const
 	if ((type == eReturn) && no_return) {	
 		return true;
 	}
+	// don't end the entry function while the program is below its minimum size
+	if ((type == eReturn) && cg_context_.get_current_func() == GetFirstFunction() && ProgramSize::below_min()) {
+		return true;
+	}
 
 	if ( (type == eBreak || type == eContinue) && !(cg_context_.flags & IN_LOOP) ) {
 		return true;
 	}
 
+	// no more loops, or calls to new functions, where they would run too often
+	if ((type == eFor || type == eArrayOp) && ExecCost::too_hot_for_loop()) {
+		return true;
+	}
+	if (type == eInvoke && ExecCost::too_hot_for_new_function()) {
+		return true;
+	}
+
 	// Limit Function complexity (depth of nested control structures)
 	if (cg_context_.blk_depth >= CGOptions::max_blk_depth()) {
 		return Statement::is_compound(type);			
@@ -221,7 +256,12 @@ StatementProbability(const StatementFilter *filter)
 	return Statement::number_to_type(value);
 }
 
-int Statement::sid = 0;
+int &
+Statement::sid(void)
+{
+	return GenerationContext::current().stmt_sid;
+}
+
 /*
  *
  */
@@ -232,7 +272,19 @@ Statement::make_random(CGContext &cg_context,
 	// Should initialize table first
 	Statement::InitProbabilityTable();
 
-	if ((CGOptions::stop_by_stmt() >= 0) && (sid >= CGOptions::stop_by_stmt())) {
+	if ((CGOptions::stop_by_stmt() >= 0) && (sid() >= CGOptions::stop_by_stmt())) {
+		t = eReturn;
+	}
+	// out of memory budget: wind down the current function
+	if (MemoryAccounting::limit_reached()) {
+		t = eReturn;
+	}
+	// likewise once the program has reached its size target
+	if (ProgramSize::target_reached()) {
+		t = eReturn;
+	}
+	// or once the time or statement budget is used up
+	if (GenerationBudget::exhausted()) {
 		t = eReturn;
 	}
 
@@ -304,6 +356,7 @@ Statement::make_random(CGContext &cg_context,
 	} 
 	s->func = cg_context.get_current_func(); 
 	s->parent = cg_context.get_current_block();
+	ExecCost::charge(1);
 	s->post_creation_analysis(pre_facts, pre_effect, cg_context);
 	return s;
 } 
@@ -361,8 +414,8 @@ Statement::Statement(eStatementType st, Block* b)
 	func(b ? b->func : 0),
 	parent(b)
 {
-	stm_id = Statement::sid;
-	Statement::sid++;
+	stm_id = Statement::sid();
+	Statement::sid()++;
 }
 
 /*
@@ -620,6 +673,8 @@ Statement::validate_and_update_facts(vector<const Fact*>& inputs, CGContext& cg_
 bool 
 Statement::stm_visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) const
 { 
+	ProfileScope scope("visit_facts");
+	MemoryScope mem(eMemFacts);
 	cg_context.get_effect_stm().clear();
 	cg_context.curr_blk = parent;
 	FactMgr* fm = get_fact_mgr(&cg_context);
@@ -629,7 +684,7 @@ Statement::stm_visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) c
 	
 	
 	if (!ok && !is_compound(eType)) {
-		failed_stm = this;
+		failed_stm() = this;
 	}
 	//if (!FactPointTo::is_valid_ptr("g_75", inputs))
 	//	Output(cout, fm);
@@ -877,6 +932,7 @@ Statement::analyze_with_edges_in(vector<const Fact*>& inputs, CGContext& cg_cont
 void 
 Statement::post_creation_analysis(vector<const Fact*>& pre_facts, const Effect& pre_effect, CGContext& cg_context) const
 {
+	MemoryScope mem(eMemFacts);
 	FactMgr* fm = get_fact_mgr_for_func(func); 
 	if (eType == eIfElse) {
 		((const StatementIf*)this)->combine_branch_facts(pre_facts);
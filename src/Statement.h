@@ -166,7 +166,7 @@ public:
 
 	const eStatementType eType;
 
-	static int get_current_sid(void) { return sid; }
+	static int get_current_sid(void) { return sid(); }
 
 	int get_blk_depth(void) const;
 
@@ -174,14 +174,16 @@ public:
 	int stm_id;
 	Function* func;
 	Block* parent;
-	static const Statement* failed_stm;
+	static const Statement *&failed_stm(void);
 
-	static ProbabilityTable<unsigned int, ProbName> *stmtTable_;
+	static ProbabilityTable<unsigned int, ProbName> *&stmtTable_(void);
+
+	static void doFinalization(void);
 protected:
 	Statement(eStatementType st, Block* parent);
 
 private:
-	static int sid;
+	static int &sid(void);
 
 	Statement &operator=(const Statement &s); // unimplementable
 
@@ -54,6 +54,7 @@
 
 #include "random.h"
 #include "AbsOutputMgr.h"
+#include "GenerationContext.h"
 
 using namespace std;
 
@@ -61,23 +62,28 @@ using namespace std;
 //
 // use a table to define probabilities of different kinds of statements
 // Must initialize it before use
-DistributionTable StatementAssign::assignOpsTable_;
+DistributionTable &
+StatementAssign::assignOpsTable_(void)
+{
+	return GenerationContext::current().assign_ops_table;
+}
 
 void
 StatementAssign::InitProbabilityTable()
 { 
-	assignOpsTable_.add_entry((int)eSimpleAssign, 70);
-	assignOpsTable_.add_entry((int)eBitAndAssign, 10);
-	assignOpsTable_.add_entry((int)eBitXorAssign, 10);
-	assignOpsTable_.add_entry((int)eBitOrAssign,  10);
+	assignOpsTable_().clear();
+	assignOpsTable_().add_entry((int)eSimpleAssign, 70);
+	assignOpsTable_().add_entry((int)eBitAndAssign, 10);
+	assignOpsTable_().add_entry((int)eBitXorAssign, 10);
+	assignOpsTable_().add_entry((int)eBitOrAssign,  10);
 	if (CGOptions::pre_incr_operator())
-		assignOpsTable_.add_entry((int)ePreIncr, 5);
+		assignOpsTable_().add_entry((int)ePreIncr, 5);
 	if (CGOptions::pre_decr_operator())
-		assignOpsTable_.add_entry((int)ePreDecr, 5);
+		assignOpsTable_().add_entry((int)ePreDecr, 5);
 	if (CGOptions::post_incr_operator())
-		assignOpsTable_.add_entry((int)ePostIncr, 5);
+		assignOpsTable_().add_entry((int)ePostIncr, 5);
 	if (CGOptions::post_decr_operator()) { 
-		assignOpsTable_.add_entry((int)ePostDecr, 5);
+		assignOpsTable_().add_entry((int)ePostDecr, 5);
 	}
 }
 
@@ -91,7 +97,7 @@ StatementAssign::AssignOpsProbability(const Type* type)
 		return eSimpleAssign;
 	}
 
-	VectorFilter filter(&assignOpsTable_);
+	VectorFilter filter(&assignOpsTable_());
 	if (type && type->is_signed()) {
 		filter.add(ePreIncr).add(ePreDecr).add(ePostIncr).add(ePostDecr);
 	}
@@ -180,10 +186,11 @@ StatementAssign::make_random(CGContext &cg_context, const Type* type, const Type
 	lhs_cg_context.get_effect_stm() = rhs_cg_context.get_effect_stm();
 	lhs_cg_context.curr_rhs = e;
 
-	bool prev_flag = CGOptions::match_exact_qualifiers(); // keep a copy of previous flag
-	if (qf) CGOptions::match_exact_qualifiers(true);      // force exact qualifier match when selecting vars
+	bool &exact = GenerationContext::current().match_exact_qualifiers;
+	bool prev_flag = exact;   // keep a copy of previous flag
+	if (qf) exact = true;     // force exact qualifier match when selecting vars
 	lhs = Lhs::make_random(lhs_cg_context, type, &qfer, op != eSimpleAssign, need_no_rhs(op));
-	if (qf) CGOptions::match_exact_qualifiers(prev_flag); // restore flag
+	if (qf) exact = prev_flag; // restore flag
 	
 
 	// typecast, if needed.
@@ -131,7 +131,7 @@ private:
 	// the real rhs canonized from compound operators, for example rhs for "i += 1" is "i + 1"
 	const Expression* rhs;	
 
-	static DistributionTable assignOpsTable_;
+	static DistributionTable &assignOpsTable_(void);
 
 	StatementAssign(const StatementAssign &sa);  // unimplemented
 
@@ -52,6 +52,7 @@
 #include "StatementBreak.h"
 #include "CFGEdge.h"
 #include "AbsOutputMgr.h"
+#include "ExecCost.h"
 
 #include "random.h"
 
@@ -136,7 +137,7 @@ make_random_array_control(unsigned int bound, int &init, int &limit, int &incr,
 }
 
 const Variable*
-StatementFor::make_iteration(CGContext& cg_context, StatementAssign*& init, Expression*& test, StatementAssign*& incr, unsigned int& bound)
+StatementFor::make_iteration(CGContext& cg_context, StatementAssign*& init, Expression*& test, StatementAssign*& incr, unsigned int& bound, double& trips)
 {
 	FactMgr* fm = get_fact_mgr(&cg_context); 
 	assert(fm);
@@ -191,6 +192,16 @@ StatementFor::make_iteration(CGContext& cg_context, StatementAssign*& init, Expr
 		assert(var->type);
 		make_random_loop_control(init_n, limit_n, incr_n, test_op, incr_op, var->type->is_signed());
 	}
+	trips = ExecCost::trip_count(init_n, limit_n, incr_n, test_op, incr_op, *var->type);
+
+	// don't let the loop run longer than the rest of "--max-exec-cost" allows
+	if (ExecCost::enabled() && trips > ExecCost::allowed_trips()) {
+		if (bound != INVALID_BOUND) {
+			trips = ExecCost::shrink_array_loop(init_n, limit_n, incr_n, test_op, incr_op, *var->type, bound);
+		} else {
+			trips = ExecCost::shrink_loop(init_n, limit_n, incr_n, test_op, incr_op, *var->type);
+		}
+	}
 	
 
 	// Build the IR for the subparts of the loop.
@@ -254,17 +265,20 @@ StatementFor::make_random(CGContext &cg_context)
 	StatementAssign* incr = NULL;
 	Expression* test = NULL;
 	unsigned int bound = 0;
-	const Variable* iv = make_iteration(cg_context, init, test, incr, bound);
+	double trips = 0;
+	const Variable* iv = make_iteration(cg_context, init, test, incr, bound, trips);
 	// record the effect and facts before loop body
 	Effect pre_effects = cg_context.get_effect_stm();
 	vector<const Fact*> pre_facts = fm->global_facts;
 
 	// create CGContext for body
 	CGContext body_cg_context(cg_context, cg_context.rw_directive, iv, bound);  
+	double weight = ExecCost::enter_loop(trips);
 	Block *body = Block::make_random(body_cg_context, true);
+	ExecCost::leave_loop(weight);
 	
 
-	StatementFor* sf = new StatementFor(cg_context.get_current_block(), *init, *test, *incr, *body);
+	StatementFor* sf = new StatementFor(cg_context.get_current_block(), *init, *test, *incr, *body, trips);
 	sf->post_loop_analysis(cg_context, pre_facts, pre_effects);
 	return sf;
 }
@@ -333,12 +347,14 @@ StatementFor::post_loop_analysis(CGContext& cg_context, vector<const Fact*>& pre
 StatementFor::StatementFor(Block* b, const StatementAssign &init,
 						   const Expression &test,
 						   const StatementAssign &incr,
-						   const Block &body)
+						   const Block &body,
+						   double trips)
 	: Statement(eFor, b),
 	  init(init),
 	  test(test),
 	  incr(incr),
-	  body(body)
+	  body(body),
+	  trips(trips)
 {
 	// Nothing else to do.
 } 
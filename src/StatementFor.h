@@ -53,13 +53,14 @@ public:
 	
 	static StatementFor *make_random_array_loop(const CGContext &cg_context);
 
-	static const Variable* make_iteration(CGContext& cg_context, StatementAssign*& begin, Expression*& exit_cond, StatementAssign*& step, unsigned int& bound);
+	static const Variable* make_iteration(CGContext& cg_context, StatementAssign*& begin, Expression*& exit_cond, StatementAssign*& step, unsigned int& bound, double& trips);
 
 	StatementFor(Block* b, 
 				 const StatementAssign &init,
 				 const Expression &test,
 				 const StatementAssign &incr,
-				 const Block &body);
+				 const Block &body,
+				 double trips);
 	virtual ~StatementFor(void);
 
 	void post_loop_analysis(CGContext& cg_context, vector<const Fact*>& pre_facts, Effect& pre_effect);
@@ -67,6 +68,7 @@ public:
 	const Expression* get_test(void) const { return &test; };
 	const StatementAssign* get_incr(void) const { return &incr; };
 	const Block* get_body(void) const { return &body; }; 
+	double get_trips(void) const { return trips; };
 	//
 	virtual void get_blocks(std::vector<const Block*>& blks) const { blks.push_back(&body);}
 
@@ -82,6 +84,9 @@ private:
 
 	const Block &body;
 
+	// how many times the body runs, see ExecCost::trip_count
+	const double trips;
+
 	//
 
 	StatementFor(const StatementFor &sf);
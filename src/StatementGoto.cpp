@@ -48,10 +48,15 @@
 #include "random.h"
 #include "AbsOutputMgr.h" 
 #include "Bookkeeper.h"
+#include "GenerationContext.h"
 
 using namespace std;
 
-std::map<const Statement*, string> StatementGoto::stm_labels;
+std::map<const Statement*, string> &
+StatementGoto::stm_labels(void)
+{
+	return GenerationContext::current().stm_labels;
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 /*
@@ -141,7 +146,7 @@ StatementGoto::make_random(CGContext &cg_context)
 			}
 			assert(b);
 			b->need_revisit = true;
-			Bookkeeper::backward_jump_cnt++;
+			Bookkeeper::backward_jump_cnt()++;
 			return sg;
 		}
 		else {
@@ -200,7 +205,7 @@ StatementGoto::make_random(CGContext &cg_context)
 			if (stm->is_ctrl_stmt() || stm->eType == eReturn) {
 				fm->global_facts = fm->map_facts_in[stm];
 			}
-			Bookkeeper::forward_jump_cnt++;
+			Bookkeeper::forward_jump_cnt()++;
 		}
 	}
 	return NULL;
@@ -215,12 +220,12 @@ StatementGoto::StatementGoto(Block* b, const Expression &test, const Statement*
 	  dest(dest),
 	  init_skipped_vars(vars)
 {
-	if (stm_labels.find(dest) != stm_labels.end()){
-		label = stm_labels[dest];
+	if (stm_labels().find(dest) != stm_labels().end()){
+		label = stm_labels()[dest];
 	}
 	else {
 		label = gensym("lbl_");
-		stm_labels[dest] = label;
+		stm_labels()[dest] = label;
 	}
 }
 
@@ -376,7 +381,7 @@ StatementGoto::visit_facts(vector<const Fact*>& inputs, CGContext& cg_context) c
 void
 StatementGoto::doFinalization(void) 
 {
-	stm_labels.clear();
+	stm_labels().clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -69,7 +69,7 @@ public:
 	const Statement* dest;
 	std::string label;  
 	std::vector<const Variable*> init_skipped_vars;
-	static std::map<const Statement*, std::string> stm_labels;
+	static std::map<const Statement*, std::string> &stm_labels(void);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -50,6 +50,8 @@
 #include "Probabilities.h" 
 #include "Enumerator.h"
 #include "AbsOutputMgr.h"
+#include "MemoryAccounting.h"
+#include "GenerationContext.h"
 
 using namespace std;
 
@@ -58,14 +60,25 @@ using namespace std;
 /*
  *
  */
-const Type *Type::simple_types[MAX_SIMPLE_TYPES];
+const Type **
+Type::simple_types(void)
+{
+	return GenerationContext::current().simple_types;
+}
 
-Type *Type::void_type = NULL;
+Type *&
+Type::void_type(void)
+{
+	return GenerationContext::current().void_type;
+}
 
 // ---------------------------------------------------------------------
 // List of all types used in the program
-static vector<Type *> AllTypes;
-static vector<Type *> derived_types;
+static inline vector<Type *> &AllTypes(void) { return GenerationContext::current().all_types; }
+static inline vector<Type *> &derived_types(void) { return GenerationContext::current().derived_types; }
+
+// sequence number of the next struct/union type
+static inline unsigned int &struct_sequence(void) { return GenerationContext::current().struct_sequence; }
 
 //////////////////////////////////////////////////////////////////////
 class NonVoidTypeFilter : public Filter
@@ -98,8 +111,8 @@ NonVoidTypeFilter::~NonVoidTypeFilter()
 bool
 NonVoidTypeFilter::filter(int v) const
 {
-	assert(static_cast<unsigned int>(v) < AllTypes.size());
-	Type *type = AllTypes[v];
+	assert(static_cast<unsigned int>(v) < AllTypes().size());
+	Type *type = AllTypes()[v];
 	if (type->eType == eSimple && type->simple_type == eVoid)
 		return true;
 
@@ -154,8 +167,8 @@ NonVoidNonVolatileTypeFilter::~NonVoidNonVolatileTypeFilter()
 bool
 NonVoidNonVolatileTypeFilter::filter(int v) const
 {
-	assert(static_cast<unsigned int>(v) < AllTypes.size());
-	Type *type = AllTypes[v];
+	assert(static_cast<unsigned int>(v) < AllTypes().size());
+	Type *type = AllTypes()[v];
 	if (type->eType == eSimple && type->simple_type == eVoid)
 		return true;
 
@@ -221,8 +234,8 @@ ChooseRandomTypeFilter::~ChooseRandomTypeFilter()
 bool
 ChooseRandomTypeFilter::filter(int v) const
 {
-	assert((v >= 0) && (static_cast<unsigned int>(v) < AllTypes.size()));
-	typ_ = AllTypes[v];
+	assert((v >= 0) && (static_cast<unsigned int>(v) < AllTypes().size()));
+	typ_ = AllTypes()[v];
 	assert(typ_);
 	if (typ_->eType == eSimple) {
 		Filter *filter = SIMPLE_TYPES_PROB_FILTER;
@@ -291,12 +304,11 @@ Type::Type(vector<const Type*>& struct_fields, bool isStruct, bool packed,
     qfers_(qfers),
     bitfields_length_(fields_length)
 {
-    static unsigned int sequence = 0;
 	if (isStruct) 
         eType = eStruct;
     else
         eType = eUnion;
-    sid =  sequence++;
+    sid =  struct_sequence()++;
 }
 
 // --------------------------------------------------------------
@@ -340,37 +352,28 @@ Type::operator=(const Type& t)
 const Type &
 Type::get_simple_type(eSimpleType st)
 {
-	static bool inited = false;
-
-	if (!inited) {
-		for (int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
-			Type::simple_types[i] = 0;
-		}
-		inited = true;
-	}
-	
-	if (Type::simple_types[st] == 0) {
+	if (Type::simple_types()[st] == 0) {
 		// find if type is in the allTypes already (most likely only "eVoid" is not there)
-		for (size_t i=0; i<AllTypes.size(); i++) {
-			Type* tt = AllTypes[i];
+		for (size_t i=0; i<AllTypes().size(); i++) {
+			Type* tt = AllTypes()[i];
 			if (tt->eType == eSimple && tt->simple_type == st) {
-				Type::simple_types[st] = tt;
+				Type::simple_types()[st] = tt;
 			}
 		}
-		if (Type::simple_types[st] == 0) {
+		if (Type::simple_types()[st] == 0) {
 			Type *t = new Type(st);
-			Type::simple_types[st] = t;
-	    		AllTypes.push_back(t);
+			Type::simple_types()[st] = t;
+	    		AllTypes().push_back(t);
 		}
 	}
-	return *Type::simple_types[st];
+	return *Type::simple_types()[st];
 }
 
 const Type *
 Type::get_type_from_string(const string &type_string)
 {
 	if (type_string == "Void") {
-		return Type::void_type;
+		return Type::void_type();
 	}
 	else if (type_string == "Char") {
 		return &Type::get_simple_type(eChar);
@@ -419,9 +422,9 @@ get_int_type()
 Type*
 Type::find_type(const Type* t)
 { 
-    for (size_t i=0; i<AllTypes.size(); i++) {
-        if (AllTypes[i] == t) {
-            return AllTypes[i];
+    for (size_t i=0; i<AllTypes().size(); i++) {
+        if (AllTypes()[i] == t) {
+            return AllTypes()[i];
         }
     }
     return 0;
@@ -434,14 +437,15 @@ Type::find_type(const Type* t)
 Type*
 Type::find_pointer_type(const Type* t, bool add)
 { 
-    for (size_t i=0; i<derived_types.size(); i++) {
-        if (derived_types[i]->ptr_type == t) {
-            return derived_types[i];
+    for (size_t i=0; i<derived_types().size(); i++) {
+        if (derived_types()[i]->ptr_type == t) {
+            return derived_types()[i];
         }
     }
 	if (add) {
+		MemoryScope mem(eMemTypes);
 		Type* ptr_type = new Type(t);
-		derived_types.push_back(ptr_type);
+		derived_types().push_back(ptr_type);
 		return ptr_type;
 	}
     return 0;
@@ -503,7 +507,7 @@ void
 Type::get_all_ok_struct_union_types(vector<Type *> &ok_types, bool no_const, bool no_volatile, bool need_int_field, bool bStruct)
 {
 	vector<Type *>::iterator i; 
-	for(i = AllTypes.begin(); i != AllTypes.end(); ++i) {
+	for(i = AllTypes().begin(); i != AllTypes().end(); ++i) {
 		Type* t = (*i);
 		if (bStruct && t->eType != eStruct) continue;
 		if (!bStruct && t->eType != eUnion) continue;
@@ -535,15 +539,15 @@ Type::choose_random_struct_union_type(vector<Type *> &ok_types)
 const Type* 
 Type::choose_random_pointer_type(void) 
 {
-	unsigned int index = rnd_upto(derived_types.size());
+	unsigned int index = rnd_upto(derived_types().size());
 	
-	return derived_types[index];
+	return derived_types()[index];
 }
 
 bool 
 Type::has_pointer_type(void) 
 {
-	return derived_types.size() > 0;
+	return derived_types().size() > 0;
 }
 
 /* for exhaustive mode only */
@@ -586,7 +590,7 @@ static bool
 MoreTypesProbability(void)
 {
 	// Always have at least 10 types in the program.
-	if (AllTypes.size() < 10)
+	if (AllTypes().size() < 10)
 		return true;
 	// by default 50% probability for each additional struct or union type.
 	return rnd_flipcoin(MoreStructUnionTypeProb);
@@ -663,9 +667,9 @@ Type::make_one_struct_field(vector<const Type*> &random_fields,
 					vector<int> &fields_length)
 {
 	ChooseRandomTypeFilter f(/*for_field_var*/true);
-	unsigned int i = rnd_upto(AllTypes.size(), &f);
+	unsigned int i = rnd_upto(AllTypes().size(), &f);
 	
-	const Type* type = AllTypes[i];
+	const Type* type = AllTypes()[i];
 	random_fields.push_back(type);
 	TypeQualifiers qual = TypeQualifiers::random_qualifiers(type, FieldConstProb, FieldVolatileProb);
 	
@@ -685,9 +689,9 @@ Type::make_one_union_field(vector<const Type*> &fields, vector<TypeQualifiers> &
 		vector<Type*> ok_types;
 		// filter out struct types containing bit-fields. Their layout is implementation 
 		// defined, we don't want to mess with them in unions for now
-		for (i=0; i<AllTypes.size(); i++) {
-			if (!AllTypes[i]->has_bitfields()) {
-				ok_types.push_back(AllTypes[i]);
+		for (i=0; i<AllTypes().size(); i++) {
+			if (!AllTypes()[i]->has_bitfields()) {
+				ok_types.push_back(AllTypes()[i]);
 			}
 		}
 
@@ -966,7 +970,7 @@ Type::reset_accum_types(vector<const Type*> &accum_types)
 {
 	accum_types.clear();
 	vector<Type*>::const_iterator i;
-	for (i = AllTypes.begin(); i != AllTypes.end(); ++i)
+	for (i = AllTypes().begin(); i != AllTypes().end(); ++i)
 		accum_types.push_back(*i);
 }
 
@@ -1099,10 +1103,10 @@ Type::make_random_pointer_type(void)
     // occasionally choose pointer to pointers
     if (rnd_flipcoin(20)) {
 		
-        if (derived_types.size() > 0) {
-			unsigned int rnd_num = rnd_upto(derived_types.size());
+        if (derived_types().size() > 0) {
+			unsigned int rnd_num = rnd_upto(derived_types().size());
 			
-			const Type* t = derived_types[rnd_num];
+			const Type* t = derived_types()[rnd_num];
 			if (t->get_indirect_level() < CGOptions::max_indirect_level()) {
 				return find_pointer_type(t, true);
 			}
@@ -1128,9 +1132,9 @@ Type::GenerateSimpleTypes(void)
     unsigned int st;
     for (st=eChar; st<MAX_SIMPLE_TYPES; st++)
     { 
-		AllTypes.push_back(new Type((enum eSimpleType)st));
+		AllTypes().push_back(new Type((enum eSimpleType)st));
     }
-    Type::void_type = new Type((enum eSimpleType)eVoid);
+    Type::void_type() = new Type((enum eSimpleType)eVoid);
 }
 
 // ---------------------------------------------------------------------
@@ -1141,13 +1145,13 @@ GenerateAllTypes(void)
     if (CGOptions::use_struct()) {
         while (MoreTypesProbability()) { 
 		    Type *ty = Type::make_random_struct_type(); 
-		    AllTypes.push_back(ty);
+		    AllTypes().push_back(ty);
 	    }
     }
 	if (CGOptions::use_union()) {
         while (MoreTypesProbability()) { 
 		    Type *ty = Type::make_random_union_type(); 
-		    AllTypes.push_back(ty);
+		    AllTypes().push_back(ty);
 	    }
     }
 }
@@ -1157,7 +1161,7 @@ const Type *
 Type::choose_random()
 {
 	ChooseRandomTypeFilter f(/*for_field_var*/false);
-	rnd_upto(AllTypes.size(), &f);
+	rnd_upto(AllTypes().size(), &f);
 	
 	Type *rv_type = f.get_type();
 	if (!rv_type->used) {
@@ -1171,7 +1175,7 @@ const Type *
 Type::choose_random_nonvoid(void)
 { 
 	NonVoidTypeFilter f;
-	rnd_upto(AllTypes.size(), &f); 
+	rnd_upto(AllTypes().size(), &f); 
 	
 	Type *typ = f.get_type();
 	assert(typ);
@@ -1182,7 +1186,7 @@ const Type *
 Type::choose_random_nonvoid_nonvolatile(void)
 {
 	NonVoidNonVolatileTypeFilter f;
-	rnd_upto(AllTypes.size(), &f);
+	rnd_upto(AllTypes().size(), &f);
 
 	
 	Type *typ = f.get_type();
@@ -1350,7 +1354,7 @@ Type::get_base_type(void) const
 const vector<Type *>& 
 Type::GetAllTypes()
 {
-	return AllTypes;
+	return AllTypes();
 }
 
 bool
@@ -1639,13 +1643,20 @@ void
 Type::doFinalization(void)
 {
 	vector<Type *>::iterator j;
-	for(j = AllTypes.begin(); j != AllTypes.end(); ++j)
+	for(j = AllTypes().begin(); j != AllTypes().end(); ++j)
 		delete (*j);
-	AllTypes.clear();
+	AllTypes().clear();
 
-	for(j = derived_types.begin(); j != derived_types.end(); ++j)
+	for(j = derived_types().begin(); j != derived_types().end(); ++j)
 		delete (*j);
-	derived_types.clear();
+	derived_types().clear();
+
+	for (int i = 0; i < MAX_SIMPLE_TYPES; ++i) {
+		Type::simple_types()[i] = 0;
+	}
+	delete Type::void_type();
+	Type::void_type() = NULL;
+	struct_sequence() = 0;
 }
 
 
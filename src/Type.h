@@ -271,11 +271,11 @@ public:
 					// need of struct's level type qualifiers. 
 	vector<int> bitfields_length_;		// -1 means it's a regular field
 
-	static Type *void_type;
+	static Type *&void_type(void);
 private:	
 	DISALLOW_COPY_AND_ASSIGN(Type);
 
-	static const Type *simple_types[MAX_SIMPLE_TYPES];
+	static const Type **simple_types(void);
 
 	// Package init.
 	friend void GenerateAllTypes(void);
@@ -38,6 +38,15 @@
 
 #include "Probabilities.h" 
 #include "Enumerator.h"
+#include "GenerationContext.h"
+
+// exact matching is either requested on the command line or forced for the
+// duration of a compound assignment's LHS selection (see StatementAssign)
+static inline bool
+match_exact_qualifiers(void)
+{
+	return CGOptions::match_exact_qualifiers() || GenerationContext::current().match_exact_qualifiers;
+}
  
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -153,7 +162,7 @@ TypeQualifiers::match(const TypeQualifiers& qfer) const
 	if (wildcard) {
 		return true;
 	}
-	if (CGOptions::match_exact_qualifiers()) {
+	if (match_exact_qualifiers()) {
 		return is_consts == qfer.get_consts() && is_volatiles == qfer.get_volatiles();
 	}
 	// return true if both variables are non-pointer (has only one level qualifier)
@@ -362,7 +371,7 @@ TypeQualifiers::random_stricter_consts(void) const
 	vector<bool> consts;
 	size_t i;
 	size_t depth = is_consts.size();
-	if (CGOptions::match_exact_qualifiers()) return is_consts;
+	if (match_exact_qualifiers()) return is_consts;
 	for (i=0; i<depth; i++) {
 		// special case
 		// const int** is not stricter than int**
@@ -388,7 +397,7 @@ TypeQualifiers::random_stricter_volatiles(void) const
 	vector<bool> volatiles;
 	size_t i;
 	size_t depth = is_volatiles.size();
-	if (CGOptions::match_exact_qualifiers()) return is_volatiles;
+	if (match_exact_qualifiers()) return is_volatiles;
 	for (i=0; i<depth; i++) {
 		// first one (storage must match, any level followed by at least two more
 		// indirections must match
@@ -413,7 +422,7 @@ TypeQualifiers::random_looser_consts(void) const
 	vector<bool> consts;
 	size_t i;
 	size_t depth = is_consts.size();
-	if (CGOptions::match_exact_qualifiers()) return is_consts;
+	if (match_exact_qualifiers()) return is_consts;
 	for (i=0; i<depth; i++) {
 		// special case
 		if (!is_consts[i] || (depth - i > 2)) {
@@ -433,7 +442,7 @@ TypeQualifiers::random_looser_volatiles(void) const
 	vector<bool> volatiles;
 	size_t i;
 	size_t depth = is_volatiles.size();
-	if (CGOptions::match_exact_qualifiers()) return is_volatiles;
+	if (match_exact_qualifiers()) return is_volatiles;
 	for (i=0; i<depth; i++) {
 		if (!is_volatiles[i] || (i==0 && depth>1) || (depth - i > 2)) {
 			volatiles.push_back(is_volatiles[i]);
@@ -460,7 +469,7 @@ TypeQualifiers
 TypeQualifiers::random_add_qualifiers(bool no_volatile) const
 {
 	TypeQualifiers qfer = *this;
-	if (CGOptions::match_exact_qualifiers()) {
+	if (match_exact_qualifiers()) {
 		qfer.add_qualifiers(false, false);
 		return qfer;
 	}
@@ -67,11 +67,21 @@
 
 #include "ArrayVariable.h"
 #include "StringUtils.h"
+#include "GenerationContext.h"
 
 
 using namespace std;
-std::vector< std::vector<const Variable*>* > Variable::ctrl_vars_vectors;
-unsigned long Variable::ctrl_vars_count;
+std::vector< std::vector<const Variable*>* > &
+Variable::ctrl_vars_vectors(void)
+{
+	return GenerationContext::current().ctrl_vars_vectors;
+}
+
+unsigned long &
+Variable::ctrl_vars_count(void)
+{
+	return GenerationContext::current().ctrl_vars_count;
+}
 
 const string Variable::sink_var_name = "csmith_sink_";
 
@@ -727,7 +737,7 @@ Variable::OutputLowerBound(std::ostream &out) const
 std::vector<const Variable*>&
 Variable::get_new_ctrl_vars(size_t count)
 {
-	unsigned long ctrl_var_suffix = Variable::ctrl_vars_count;
+	unsigned long ctrl_var_suffix = Variable::ctrl_vars_count();
 	TypeQualifiers dummy;
 	dummy.add_qualifiers(false, false);
 	char name = 'i';
@@ -744,23 +754,23 @@ Variable::get_new_ctrl_vars(size_t count)
 		ctrl_vars->push_back(v);
 		name++;
 	}
-	Variable::ctrl_vars_count++;
-	ctrl_vars_vectors.push_back(ctrl_vars);
+	Variable::ctrl_vars_count()++;
+	ctrl_vars_vectors().push_back(ctrl_vars);
 	return *ctrl_vars;
 } 
 
 std::vector<const Variable*>&
 Variable::get_last_ctrl_vars()
 {
-	return *Variable::ctrl_vars_vectors.back();
+	return *Variable::ctrl_vars_vectors().back();
 }
 
 // ------------------------------------------------------------
 void
 Variable::doFinalization(void)
 {
-	for (vector< vector<const Variable *>* >::iterator vi = ctrl_vars_vectors.begin(),
-	     ve = ctrl_vars_vectors.end(); vi != ve; ++vi) {
+	for (vector< vector<const Variable *>* >::iterator vi = ctrl_vars_vectors().begin(),
+	     ve = ctrl_vars_vectors().end(); vi != ve; ++vi) {
 		vector<const Variable *> *v = (*vi);
 		for (vector<const Variable *>::iterator i = v->begin(),
 		     e = v->end(); i != e; ++i) {
@@ -768,7 +778,8 @@ Variable::doFinalization(void)
 		}
 		delete v;
 	}
-	ctrl_vars_vectors.clear();
+	ctrl_vars_vectors().clear();
+	ctrl_vars_count() = 0;
 }
 
 // --------------------------------------------------------------
@@ -155,8 +155,8 @@ private:
 			 const vector<bool>& isConsts, const vector<bool>& isVolatiles,
 			 bool isAuto, bool isStatic, bool isRegister, bool isBitfield, const Variable* isFieldVarOf);
 	 
-	static std::vector< std::vector<const Variable*>* > ctrl_vars_vectors;
-	static unsigned long ctrl_vars_count;
+	static std::vector< std::vector<const Variable*>* > &ctrl_vars_vectors(void);
+	static unsigned long &ctrl_vars_count(void);
 
 	void create_field_vars(const Type* type);
 };
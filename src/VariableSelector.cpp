@@ -60,17 +60,38 @@
 #include "Probabilities.h"
 #include "ProbabilityTable.h"
 #include "StringUtils.h"
+#include "Profiler.h"
+#include "GenerationContext.h"
 
 using namespace std;
 
 ///////////////////////////////////////////////////////////////////////////////
 
 // --------------------------------------------------------------
-// static variables 
-vector<Variable*> VariableSelector::AllVars; 
-vector<Variable*> VariableSelector::GlobalList; 
-vector<Variable*> VariableSelector::GlobalNonvolatilesList; 
-bool VariableSelector::var_created = false;
+// per-generation variables, see GenerationContext
+vector<Variable*> &
+VariableSelector::AllVars(void)
+{
+	return GenerationContext::current().all_vars;
+}
+
+vector<Variable*> &
+VariableSelector::GlobalList(void)
+{
+	return GenerationContext::current().global_vars;
+}
+
+vector<Variable*> &
+VariableSelector::GlobalNonvolatilesList(void)
+{
+	return GenerationContext::current().global_nonvolatile_vars;
+}
+
+bool &
+VariableSelector::var_created(void)
+{
+	return GenerationContext::current().var_created;
+}
 
 class VariableSelectFilter : public Filter
 {
@@ -100,7 +121,7 @@ VariableSelectFilter::~VariableSelectFilter()
 bool
 VariableSelectFilter::filter(int v) const
 {
-	eVariableScope scope = VariableSelector::scopeTable_->get_value(v);
+	eVariableScope scope = VariableSelector::scopeTable_()->get_value(v);
 	if (scope == eParentParam) {
 		Function &parent = *cg_context_.get_current_func();
 		return parent.param.empty();
@@ -108,17 +129,21 @@ VariableSelectFilter::filter(int v) const
 	return false;
 }
 
-ProbabilityTable<unsigned int, eVariableScope> *VariableSelector::scopeTable_ = NULL;
+ProbabilityTable<unsigned int, eVariableScope> *&
+VariableSelector::scopeTable_(void)
+{
+	return GenerationContext::current().scope_table;
+}
 
 void
 VariableSelector::InitScopeTable()
 {
-	if (scopeTable_ == NULL) {  
-		scopeTable_ = new ProbabilityTable<unsigned int, eVariableScope>();
-		scopeTable_->add_elem(35, eGlobal);
-		scopeTable_->add_elem(65, eParentLocal);
-		scopeTable_->add_elem(95, eParentParam);
-		scopeTable_->add_elem(100, eNewValue);
+	if (scopeTable_() == NULL) {  
+		scopeTable_() = new ProbabilityTable<unsigned int, eVariableScope>();
+		scopeTable_()->add_elem(35, eGlobal);
+		scopeTable_()->add_elem(65, eParentLocal);
+		scopeTable_()->add_elem(95, eParentParam);
+		scopeTable_()->add_elem(100, eNewValue);
 	}
 }
 
@@ -153,7 +178,7 @@ VariableSelector::new_variable(const std::string &name, const Type *type, const
 { 
 	Variable *var = Variable::CreateVariable(name, type, init, qfer);
 	
-	AllVars.push_back(var);
+	AllVars().push_back(var);
 	return var;
 }
 
@@ -299,7 +324,7 @@ VariableSelector::has_eligible_volatile_var(const vector<Variable *>& vars, cons
 		}
 		int deref_level = var->type->get_indirect_level() - type->get_indirect_level();
 		if (is_eligible_var(var, deref_level, access, cg_context) && var->is_volatile()) {
-			Bookkeeper::volatile_avail++;
+			Bookkeeper::volatile_avail()++;
 			return true;
 		}
 	}
@@ -398,6 +423,7 @@ VariableSelector::choose_var(vector<Variable *> vars,
 		   bool no_bitfield,
 		   bool no_expand_struct_union)
 {
+	ProfileScope scope("choose_var");
 	vector<Variable *> ok_vars;
 	vector<Variable *>::iterator i;
 
@@ -406,7 +432,7 @@ VariableSelector::choose_var(vector<Variable *> vars,
 
 	bool found = has_dereferenceable_var(vars, type, cg_context);
 	if (found) {
-		Bookkeeper::pointer_avail_for_dereference++;
+		Bookkeeper::pointer_avail_for_dereference()++;
 	}
 	// check availability of volatiles
 	has_eligible_volatile_var(vars, type, qfer, access, cg_context);
@@ -505,7 +531,7 @@ VariableSelector::create_and_initialize(Effect::Access access, const CGContext &
 	return var;
 }
 
-static int tmp_count = 0;
+static inline int &tmp_count(void) { return GenerationContext::current().tmp_count; }
 // --------------------------------------------------------------
  /* Parameter "type"
  * 0 --- To generate any type
@@ -521,10 +547,10 @@ VariableSelector::GenerateNewGlobal(Effect::Access access, const CGContext &cg_c
 								: *qfer;
 	
 	string name = RandomGlobalName();
-	tmp_count++;
+	tmp_count()++;
 	Variable* var = create_and_initialize(access, cg_context, t, &var_qfer, 0, name);
 
-	GlobalList.push_back(var);
+	GlobalList().push_back(var);
 	// for DFA 
 	FactMgr* fm = get_fact_mgr(&cg_context);
 	fm->add_new_var_fact_and_update_inout_maps(NULL, var->get_collective());
@@ -534,9 +560,9 @@ VariableSelector::GenerateNewGlobal(Effect::Access access, const CGContext &cg_c
 		if (CGOptions::access_once() && rnd_flipcoin(AccessOnceVariableProb)) {
 			var->isAccessOnce = true;
 		}
-		GlobalNonvolatilesList.push_back(var);
+		GlobalNonvolatilesList().push_back(var);
 	}
-	var_created = true;
+	var_created() = true;
 	return var;
 }
 
@@ -549,22 +575,22 @@ VariableSelector::GenerateNewNonArrayGlobal(Effect::Access access, const CGConte
 								: *qfer;
 	
 	string name = RandomGlobalName();
-	tmp_count++;
+	tmp_count()++;
 
 	const Expression *init = make_init_value(access, cg_context, t, qfer, NULL);
 	
 	Variable *var = new_variable(name, t, init, qfer);
 
-	GlobalList.push_back(var);
+	GlobalList().push_back(var);
 	// for DFA 
 	FactMgr* fm = get_fact_mgr(&cg_context);
 	fm->add_new_var_fact_and_update_inout_maps(NULL, var->get_collective());
 	cg_context.get_current_func()->new_globals.push_back(var);
 
 	if (!var_qfer.is_volatile()) {
-		GlobalNonvolatilesList.push_back(var);
+		GlobalNonvolatilesList().push_back(var);
 	}
-	var_created = true;
+	var_created() = true;
 	return var;
 }
 
@@ -596,7 +622,7 @@ VariableSelector::eager_create_global_struct(Effect::Access access, const CGCont
 		return NULL;
 
 	
-	return choose_var(GlobalList, access, cg_context, type, qfer, mt, invalid_vars);
+	return choose_var(GlobalList(), access, cg_context, type, qfer, mt, invalid_vars);
 }
 
 Variable*
@@ -639,7 +665,7 @@ VariableSelector::eager_create_local_struct(Block &block, Effect::Access access,
 Variable *
 VariableSelector::SelectGlobal(Effect::Access access, const CGContext &cg_context, const Type* type, const TypeQualifiers* qfer, eMatchType mt, const vector<const Variable*>& invalid_vars)
 {
-	Variable* var = choose_var(GlobalList, access, cg_context, type, qfer, mt, invalid_vars);
+	Variable* var = choose_var(GlobalList(), access, cg_context, type, qfer, mt, invalid_vars);
 	
 	if (var == 0) {
 		if (CGOptions::expand_struct()) {
@@ -664,7 +690,7 @@ void
 VariableSelector::find_all_non_bitfield_visible_vars(const Block *b, vector<Variable*> &vars)
 {
 	vector<Variable *>::iterator i;
-	for (i = GlobalList.begin(); i != GlobalList.end(); ++i) {
+	for (i = GlobalList().begin(); i != GlobalList().end(); ++i) {
 		if (!((*i)->isBitfield_))
 			vars.push_back(*i);
 	}	
@@ -682,9 +708,9 @@ void
 VariableSelector::find_all_non_array_visible_vars(const Block *b, vector<Variable*> &vars)
 {
 	size_t i;
-	for (i = 0; i < GlobalList.size(); i++) {
-		if (!(GlobalList[i]->isArray))
-			vars.push_back(GlobalList[i]);
+	for (i = 0; i < GlobalList().size(); i++) {
+		if (!(GlobalList()[i]->isArray))
+			vars.push_back(GlobalList()[i]);
 	}	
 	if (b) {
 		for (i=0; i<b->func->param.size(); i++) {
@@ -703,7 +729,7 @@ VariableSelector::find_all_non_array_visible_vars(const Block *b, vector<Variabl
 void
 VariableSelector::get_all_array_vars(vector<const Variable*> &array_vars)
 {
-	vector<Variable*> vars = GlobalList;
+	vector<Variable*> vars = GlobalList();
 	for (size_t i=0; i<vars.size(); i++) {
 		if (vars[i]->isArray) {
 			array_vars.push_back(vars[i]);
@@ -724,7 +750,7 @@ VariableSelector::get_all_local_vars(const Block *b, vector<const Variable*> &va
 vector<Variable*>
 VariableSelector::find_all_visible_vars(const Block* b)
 {
-	vector<Variable*> vars = GlobalList;
+	vector<Variable*> vars = GlobalList();
 	while (b) {
 		vars.insert(vars.end(), b->local_vars.begin(), b->local_vars.end());
 		b = b->parent;
@@ -891,7 +917,7 @@ VariableSelector::GenerateNewParentLocal(Block &block,
 	blk->local_vars.push_back(var);
 	FactMgr* fm = get_fact_mgr(&cg_context);
 	fm->add_new_var_fact_and_update_inout_maps(blk, var->get_collective());
-	var_created = true;
+	var_created() = true;
 	return var;
 }
 
@@ -1000,7 +1026,7 @@ VariableSelectionProbability(eVariableScope upper = MAX_VAR_SCOPE, Filter *filte
 	VariableSelector::InitScopeTable();
 	do {
 		int i = rnd_upto(100, filter); 
-		eVariableScope scope = VariableSelector::scopeTable_->get_value(i);
+		eVariableScope scope = VariableSelector::scopeTable_()->get_value(i);
 		if (scope < upper) {
 			return scope;
 		}
@@ -1066,7 +1092,7 @@ VariableSelector::GenerateNewVariable(Effect::Access access,
 		break;
 	}
 	
-	var_created = true;
+	var_created() = true;
 	return var;
 }
 
@@ -1122,7 +1148,7 @@ VariableSelector::select(Effect::Access access,
 	}
 	 
 	Variable *var = 0;
-	var_created = false;
+	var_created() = false;
 
 	// Note that many of the functions that select `var' can return null, if
 	// they cannot find a suitable variable.  So we loop.
@@ -1152,14 +1178,14 @@ VariableSelector::select(Effect::Access access,
 	}
 	// record statistics
 	if (var) {
-		if (var_created) {
+		if (var_created()) {
 			const Type* t = var->type;
-			Bookkeeper::use_new_var_cnt++; 
+			Bookkeeper::use_new_var_cnt()++; 
 			Bookkeeper::record_vars_with_bitfields(t);
-			incr_counter(Bookkeeper::struct_depth_cnts, t->get_struct_depth());
-			if (t->eType == eUnion) Bookkeeper::union_var_cnt++;
+			incr_counter(Bookkeeper::struct_depth_cnts(), t->get_struct_depth());
+			if (t->eType == eUnion) Bookkeeper::union_var_cnt()++;
 		} else {
-			Bookkeeper::use_old_var_cnt++;
+			Bookkeeper::use_old_var_cnt()++;
 		}
 	}
 	return var;
@@ -1173,7 +1199,7 @@ VariableSelector::select_deref_pointer(Effect::Access access, const CGContext &c
 	assert(qfer && qfer->SanityCheck(type));
 	vector<Variable*> vars;
 	// add globals
-	vars.insert(vars.end(), GlobalNonvolatilesList.begin(), GlobalNonvolatilesList.end()); 
+	vars.insert(vars.end(), GlobalNonvolatilesList().begin(), GlobalNonvolatilesList().end()); 
 	// add parent locals
 	const Block* b = cg_context.get_current_block();
 	while (b) {
@@ -1230,7 +1256,7 @@ VariableSelector::create_array_and_itemize(Block* blk, string name, const CGCont
 {
 	ArrayVariable* av = ArrayVariable::CreateArrayVariable(cg_context, blk, name, t, init, qfer, NULL);
 	
-	AllVars.push_back(av);
+	AllVars().push_back(av);
 	return av->itemize();
 }
 
@@ -1266,7 +1292,7 @@ VariableSelector::create_random_array(const CGContext& cg_context)
 
 	Expression* init = Constant::make_random(type);
 	ArrayVariable* av = ArrayVariable::CreateArrayVariable(cg_context, blk, name, type, init, &qfer, NULL);
-	AllVars.push_back(av);
+	AllVars().push_back(av);
 
 	// make the points-to fact known to DFA
 	FactMgr* fm = get_fact_mgr(&cg_context);
@@ -1424,7 +1450,7 @@ VariableSelector::create_mutated_array_var(const ArrayVariable* av, const vector
 		new_av->set_index(i, new_indices[i]);
 	}
 	// add new variable to local list and all-variable list
-	AllVars.push_back(new_av);
+	AllVars().push_back(new_av);
 	av->parent->local_vars.push_back(new_av);
 	return new_av;
 }
@@ -1442,8 +1468,8 @@ const Variable*
 VariableSelector::find_var_by_name(string name)
 {
 	size_t i;
-	for (i=0; i<AllVars.size(); i++) {
-		const Variable* v = AllVars[i]->match_var_name(name);
+	for (i=0; i<AllVars().size(); i++) {
+		const Variable* v = AllVars()[i]->match_var_name(name);
 		if (v) {
 			return v;
 		}
@@ -1458,12 +1484,12 @@ void
 VariableSelector::doFinalization(void)
 {
 	size_t i;  
-	const Variable* v1 = AllVars[9112];
-	for(i=0; i<AllVars.size(); i++) {
-		const Variable* v = AllVars[i];
-		delete AllVars[i];
+	for(i=0; i<AllVars().size(); i++) {
+		delete AllVars()[i];
 	}
-	AllVars.clear();
-	GlobalList.clear();
-	GlobalNonvolatilesList.clear();
+	AllVars().clear();
+	GlobalList().clear();
+	GlobalNonvolatilesList().clear();
+	var_created() = false;
+	tmp_count() = 0;
 }   
\ No newline at end of file
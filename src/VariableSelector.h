@@ -94,11 +94,11 @@ public:
 
 	static void GenerateParameterVariable(Function &curFunc);
 	static Variable* GenerateParameterVariable(const Type *type, const TypeQualifiers *qfer);
-	static std::vector<Variable *>* GetGlobalVariables(void) {return &GlobalList;}
+	static std::vector<Variable *>* GetGlobalVariables(void) {return &GlobalList();}
 	static void doFinalization(void); 
 	static void expand_struct_union_vars(vector<const Variable *>& vars, const Type* type);
 
-	static ProbabilityTable<unsigned int, eVariableScope> * scopeTable_;
+	static ProbabilityTable<unsigned int, eVariableScope> *&scopeTable_(void);
 	static void InitScopeTable();
 
 	static vector<Variable*> find_all_visible_vars(const Block* b); 
@@ -153,16 +153,16 @@ private:
 					const TypeQualifiers* qfer, Block *blk, std::string name);
 
 	// all variables generated
-	static vector<Variable*> AllVars;
+	static vector<Variable*> &AllVars(void);
 
 	// All globals, including volatiles.
-	static vector<Variable*> GlobalList;
+	static vector<Variable*> &GlobalList(void);
 
 	// All the non-volatile globals.
-	static vector<Variable*> GlobalNonvolatilesList;
+	static vector<Variable*> &GlobalNonvolatilesList(void);
 
 	// flag that indicates whether a new variable has been created 
-	static bool var_created;
+	static bool &var_created(void);
 }; 
 
 #endif // VARIABLE_SELECTOR_H 
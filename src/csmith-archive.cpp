@@ -0,0 +1,140 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+//
+// csmith-archive: list and extract the programs of a Csmith archive, as
+// written by "csmith --archive <name> --count <n>" (see ProgramArchive.h).
+//
+// "list" prints one line per program: the seed, the options hash, the
+// offset and length of the program in the archive, and its generation time.
+// "extract" writes the program of a seed to stdout or to a standalone .c
+// file; "extract-all" writes every program to <dir>/random<seed>.c.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "ProgramArchive.h"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void
+print_help(void)
+{
+	cout << "Usage: csmith-archive list <archive>" << endl
+	     << "       csmith-archive extract <archive> <seed> [<file.c>]" << endl
+	     << "       csmith-archive extract-all <archive> <dir>" << endl
+	     << endl
+	     << "A seed that is in the archive more than once (with different options) is" << endl
+	     << "extracted from its last entry." << endl;
+}
+
+static bool
+write_program(const string &archive, const ProgramArchive::Entry &e, const string &file)
+{
+	string program;
+	if (!ProgramArchive::read_program(archive, e, program)) {
+		cerr << "csmith-archive: cannot read the program of seed " << e.seed << endl;
+		return false;
+	}
+	if (file.empty()) {
+		cout.write(program.data(), program.size());
+		return true;
+	}
+	ofstream out(file.c_str(), ios::binary);
+	out.write(program.data(), program.size());
+	if (!out) {
+		cerr << "csmith-archive: cannot write " << file << endl;
+		return false;
+	}
+	return true;
+}
+
+int
+main(int argc, char **argv)
+{
+	if (argc < 3) {
+		print_help();
+		return 2;
+	}
+	string mode = argv[1];
+	string archive = argv[2];
+	vector<ProgramArchive::Entry> entries;
+	string error;
+	if (!ProgramArchive::read_index(archive, entries, error)) {
+		cerr << "csmith-archive: " << error << endl;
+		return 2;
+	}
+
+	if (mode == "list" && argc == 3) {
+		cout << "# seed options-hash offset length usecs" << endl;
+		for (size_t i = 0; i < entries.size(); i++) {
+			const ProgramArchive::Entry &e = entries[i];
+			char hash[17];
+			sprintf(hash, "%016llx", e.options_hash);
+			cout << e.seed << " " << hash << " " << e.offset << " "
+			     << e.length << " " << e.usecs << endl;
+		}
+		return 0;
+	}
+	if (mode == "extract" && (argc == 4 || argc == 5)) {
+		unsigned long long seed = strtoull(argv[3], NULL, 10);
+		for (size_t i = entries.size(); i > 0; i--) {
+			if (entries[i - 1].seed == seed)
+				return write_program(archive, entries[i - 1], (argc == 5) ? argv[4] : "") ? 0 : 1;
+		}
+		cerr << "csmith-archive: seed " << seed << " is not in " << archive << endl;
+		return 1;
+	}
+	if (mode == "extract-all" && argc == 4) {
+		for (size_t i = 0; i < entries.size(); i++) {
+			ostringstream file;
+			file << argv[3] << "/random" << entries[i].seed << ".c";
+			if (!write_program(archive, entries[i], file.str()))
+				return 1;
+		}
+		return 0;
+	}
+	print_help();
+	return 2;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,267 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+//
+// csmith-cache: compile and run a test program through the result cache
+// (see ResultCache.h), for the driver scripts.  "run" answers from the
+// cache when the same program was compiled with the same compiler and
+// flags before, and compiles, runs and records it otherwise:
+//
+//   csmith-cache run [options] "<compiler>" <file.c> ["<flags>"]
+//
+// It prints the outcome and exits with the codes of compile_and_run in
+// compiler_test.pl: 0 normal, 1 compiler crash, 2 compiler hang,
+// 3 program crash, 4 program hang.
+//
+//   compile <status>   the exit status of the compiler, as a shell reports it
+//   run <status>       the same for the program, if it was run
+//   checksum <value>   the checksum the program printed, if any
+//   cached <0 or 1>
+//
+// "stats", "trim" and "clear" look after the cache itself.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <unistd.h>
+
+#include "Executor.h"
+#include "ResultCache.h"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void
+print_help(void)
+{
+	cout << "Usage: csmith-cache [--dir <dir>] [--max-entries <n>] <command>" << endl
+	     << endl
+	     << "  run [options] <compiler> <file.c> [<flags>]: compile and run a program, or answer" << endl
+	     << "    from the cache; the compiler and the flags are one argument each" << endl
+	     << "      --no-run: only compile the program" << endl
+	     << "      --compiler-timeout <seconds>: default 120" << endl
+	     << "      --prog-timeout <seconds>: default 8" << endl
+	     << "      --compiler-output <file>: write the output of the compiler there" << endl
+	     << "      --program-output <file>: write the output of the program there" << endl
+	     << "      --exe <file>: the executable to build (default: a temporary one);" << endl
+	     << "        it is not there when the answer comes from the cache" << endl
+	     << "  stats: print the number of entries" << endl
+	     << "  trim: drop the oldest entries beyond the limit" << endl
+	     << "  clear: drop every entry" << endl
+	     << endl
+	     << "The cache is in $CSMITH_CACHE_DIR, or ~/.cache/csmith, unless --dir says otherwise;" << endl
+	     << "it keeps " << ResultCache::default_max_entries << " entries unless --max-entries says otherwise." << endl;
+}
+
+static bool
+read_file(const string &file, string &data)
+{
+	ifstream in(file.c_str(), ios::binary);
+	if (!in)
+		return false;
+	ostringstream s;
+	s << in.rdbuf();
+	data = s.str();
+	return true;
+}
+
+static void
+write_file(const string &file, const string &data)
+{
+	if (file.empty())
+		return;
+	ofstream out(file.c_str(), ios::binary);
+	out.write(data.data(), data.size());
+}
+
+// the exit codes of compile_and_run in compiler_test.pl
+static int
+outcome(const ResultCache::Entry &e, bool timed_out)
+{
+	if (e.compile_status != 0)
+		return (timed_out && !e.ran) ? 2 : 1;
+	if (e.ran && e.run_status != 0)
+		return timed_out ? 4 : 3;
+	return 0;
+}
+
+static int
+run(ResultCache &cache, int argc, char **argv)
+{
+	bool do_run = true;
+	Executor::Limits compile_limits, run_limits;
+	compile_limits.timeout = 120;
+	run_limits.timeout = 8;
+	string compiler_output, program_output, exe;
+	int i;
+	for (i = 0; i < argc && strncmp(argv[i], "--", 2) == 0; i++) {
+		string arg = argv[i];
+		if (arg == "--no-run") {
+			do_run = false;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			cerr << "csmith-cache: " << arg << " needs an argument" << endl;
+			return 125;
+		}
+		string value = argv[++i];
+		if (arg == "--compiler-timeout") {
+			compile_limits.timeout = static_cast<unsigned int>(strtoul(value.c_str(), NULL, 10));
+		} else if (arg == "--prog-timeout") {
+			run_limits.timeout = static_cast<unsigned int>(strtoul(value.c_str(), NULL, 10));
+		} else if (arg == "--compiler-output") {
+			compiler_output = value;
+		} else if (arg == "--program-output") {
+			program_output = value;
+		} else if (arg == "--exe") {
+			exe = value;
+		} else {
+			cerr << "csmith-cache: bad option " << arg << endl;
+			return 125;
+		}
+	}
+	if (argc - i != 2 && argc - i != 3) {
+		print_help();
+		return 125;
+	}
+	string compiler = argv[i];
+	string src = argv[i + 1];
+	string flags = (argc - i == 3) ? argv[i + 2] : "";
+	string program;
+	if (!read_file(src, program)) {
+		cerr << "csmith-cache: cannot read " << src << endl;
+		return 125;
+	}
+
+	size_t slash = src.rfind('/');
+	string source_dir = (slash == string::npos) ? "." : src.substr(0, slash ? slash : 1);
+	string key = ResultCache::key(program, compiler, flags, source_dir);
+	ResultCache::Entry e;
+	bool cached = cache.lookup(key, e) && (e.ran || !do_run || e.compile_status != 0);
+	bool timed_out = false;
+	if (!cached) {
+		e = ResultCache::Entry();
+		bool own_exe = exe.empty();
+		if (own_exe) {
+			char tmp[] = "/tmp/csmith-cache.XXXXXX";
+			int fd = mkstemp(tmp);
+			if (fd == -1) {
+				cerr << "csmith-cache: cannot create a temporary file" << endl;
+				return 125;
+			}
+			close(fd);
+			exe = tmp;
+		}
+		Executor exec;
+		Executor::Result r;
+		exec.run_shell(compiler + " " + src + " " + flags + " -o " + exe, compile_limits, r);
+		e.compile_status = r.shell_status();
+		e.compiler_output = exec.captured();
+		timed_out = r.timed_out;
+		if (e.compile_status == 0 && access(exe.c_str(), F_OK) != 0)
+			e.compile_status = 1;
+		if (e.compile_status == 0 && do_run) {
+			vector<string> args(1, exe.find('/') == string::npos ? "./" + exe : exe);
+			exec.run(args, vector<string>(), run_limits, r);
+			e.ran = true;
+			e.run_status = r.shell_status();
+			e.program_output = exec.captured();
+			e.checksum = ResultCache::find_checksum(e.program_output);
+			timed_out = r.timed_out;
+		}
+		if (own_exe)
+			unlink(exe.c_str());
+		if (!timed_out)
+			cache.store(key, e);
+	}
+
+	write_file(compiler_output, e.compiler_output);
+	if (e.ran)
+		write_file(program_output, e.program_output);
+	cout << "compile " << e.compile_status << endl;
+	if (e.ran)
+		cout << "run " << e.run_status << endl;
+	if (!e.checksum.empty())
+		cout << "checksum " << e.checksum << endl;
+	cout << "cached " << (cached ? 1 : 0) << endl;
+	return outcome(e, timed_out);
+}
+
+int
+main(int argc, char **argv)
+{
+	string dir = ResultCache::default_dir();
+	unsigned long max_entries = ResultCache::default_max_entries;
+	int i;
+	for (i = 1; i + 1 < argc; i += 2) {
+		if (strcmp(argv[i], "--dir") == 0) {
+			dir = argv[i + 1];
+		} else if (strcmp(argv[i], "--max-entries") == 0) {
+			max_entries = strtoul(argv[i + 1], NULL, 10);
+		} else {
+			break;
+		}
+	}
+	if (i >= argc) {
+		print_help();
+		return 125;
+	}
+	ResultCache cache(dir, max_entries);
+	string command = argv[i];
+	if (command == "run")
+		return run(cache, argc - i - 1, argv + i + 1);
+	if (command == "stats" && i + 1 == argc) {
+		cout << "entries " << ResultCache(dir, ~0UL).trim() << endl;
+		return 0;
+	}
+	if (command == "trim" && i + 1 == argc) {
+		cout << "entries " << cache.trim() << endl;
+		return 0;
+	}
+	if (command == "clear" && i + 1 == argc) {
+		cout << "dropped " << cache.clear() << endl;
+		return 0;
+	}
+	print_help();
+	return 125;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
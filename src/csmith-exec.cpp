@@ -0,0 +1,179 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+//
+// csmith-exec: run a compiler or a test program under limits and report
+// how it went, for the driver scripts (see driver/RunSafely).  It is a
+// thin command line around the Executor of csmith-test.
+//
+// The report goes to stderr, or to the file given with --report:
+//
+//   exit <status>       as a shell reports it, 128 + the signal if killed
+//   signal <n>          0 if the program exited
+//   timeout <0 or 1>    whether the wall-clock timeout killed it
+//   user <seconds>
+//   sys <seconds>
+//   wall <seconds>
+//   maxrss <kilobytes>  the peak resident set size
+//   cpu time= <seconds> user + sys, the last line of RunSafely's .time files
+//
+// The exit status of csmith-exec is the first line of the report.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+#include "Executor.h"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void
+print_help(void)
+{
+	cout << "Usage: csmith-exec [options] [--] <program> <args...>" << endl
+	     << endl
+	     << "  --timeout <seconds>: kill the program, and all it started, after this long" << endl
+	     << "  --cpu <seconds>: limit the CPU time of the program" << endl
+	     << "  --memory <MB>: limit the address space of the program" << endl
+	     << "  --fsize <MB>: limit the size of the files the program writes" << endl
+	     << "  --stdin <file>: the standard input of the program (default: /dev/null)" << endl
+	     << "  --output <file>: where standard output and error go (default: this standard output," << endl
+	     << "    once the program is done)" << endl
+	     << "  --env <name>=<value>: add a variable to the environment of the program" << endl
+	     << "  --in-memory: run a copy of the program loaded in memory" << endl
+	     << "  --report <file>: where the report goes (default: stderr)" << endl;
+}
+
+static bool
+parse_number(const char *s, unsigned long &n)
+{
+	char *end;
+	n = strtoul(s, &end, 10);
+	return *s >= '0' && *s <= '9' && *end == '\0';
+}
+
+int
+main(int argc, char **argv)
+{
+	Executor::Limits limits;
+	string input, output, report;
+	vector<string> env;
+	bool in_memory = false;
+	int i;
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		string arg = argv[i];
+		if (arg == "--") {
+			i++;
+			break;
+		}
+		if (arg == "--help" || arg == "-h") {
+			print_help();
+			return 0;
+		}
+		if (arg == "--in-memory") {
+			in_memory = true;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			cerr << "csmith-exec: " << arg << " needs an argument" << endl;
+			return 125;
+		}
+		string value = argv[++i];
+		unsigned long n = 0;
+		bool number = parse_number(value.c_str(), n);
+		if (arg == "--stdin") {
+			input = value;
+		} else if (arg == "--output") {
+			output = value;
+		} else if (arg == "--report") {
+			report = value;
+		} else if (arg == "--env" && value.find('=') != string::npos) {
+			env.push_back(value);
+		} else if (arg == "--timeout" && number) {
+			limits.timeout = static_cast<unsigned int>(n);
+		} else if (arg == "--cpu" && number) {
+			limits.cpu = n;
+		} else if (arg == "--memory" && number) {
+			limits.memory = n << 20;
+		} else if (arg == "--fsize" && number) {
+			limits.file_size = n << 20;
+		} else {
+			cerr << "csmith-exec: bad option " << arg << " " << value << endl;
+			return 125;
+		}
+	}
+	if (i >= argc) {
+		print_help();
+		return 125;
+	}
+
+	Executor exec;
+	vector<string> args(argv + i, argv + argc);
+	if (in_memory)
+		args[0] = exec.load_in_memory(args[0]);
+	Executor::Result r;
+	if (!exec.run(args, env, limits, r, input, output)) {
+		cerr << "csmith-exec: cannot run " << argv[i] << endl;
+		return 127;
+	}
+	if (output.empty())
+		fwrite(exec.captured().data(), 1, exec.captured().size(), stdout);
+
+	ofstream file;
+	if (!report.empty())
+		file.open(report.c_str());
+	ostream &out = report.empty() ? cerr : file;
+	char secs[64];
+	out << "exit " << r.shell_status() << endl;
+	out << "signal " << r.signal << endl;
+	out << "timeout " << (r.timed_out ? 1 : 0) << endl;
+	sprintf(secs, "%f", r.user_secs);
+	out << "user " << secs << endl;
+	sprintf(secs, "%f", r.sys_secs);
+	out << "sys " << secs << endl;
+	sprintf(secs, "%f", r.wall_usecs / 1e6);
+	out << "wall " << secs << endl;
+	out << "maxrss " << r.max_rss_kb << endl;
+	sprintf(secs, "%f", r.user_secs + r.sys_secs);
+	out << "cpu time= " << secs << endl;
+	return r.shell_status();
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
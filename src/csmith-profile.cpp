@@ -0,0 +1,187 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+//
+// csmith-profile: report the counters of a program generated with
+// "csmith --emit-profile-counters".  When the program ends it writes its
+// counters to the file named by $CSMITH_PROFILE (csmith.prof by default);
+// the program itself has the table that maps each counter to a function
+// body or a loop body, by the block id its comments carry.
+//
+// The report has one line per counter, the most frequent first: the count,
+// its share of all the counts, the kind of body, the function and the
+// block id.  Several profiles of the same program are added up.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+#include <stdint.h>
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static const uint32_t profile_magic = 0x46505343UL;	// "CSPF"
+static const uint32_t profile_version = 1;
+
+struct Counter {
+	size_t index;
+	string kind;
+	string function;
+	int block;
+	unsigned long long count;
+};
+
+static bool
+more_frequent(const Counter &a, const Counter &b)
+{
+	if (a.count != b.count)
+		return a.count > b.count;
+	return a.index < b.index;
+}
+
+static void
+print_help(void)
+{
+	cout << "Usage: csmith-profile <program.c> <profile> [<profile>...]" << endl
+	     << endl
+	     << "<program.c> must be generated with --emit-profile-counters, and each" << endl
+	     << "<profile> written by a run of it." << endl;
+}
+
+// read the table of counters from the comment the generator puts before main
+static bool
+read_table(const string &program, vector<Counter> &counters)
+{
+	ifstream in(program.c_str());
+	if (!in) {
+		cerr << "csmith-profile: cannot read " << program << endl;
+		return false;
+	}
+	string line;
+	bool in_table = false;
+	while (getline(in, line)) {
+		if (!in_table) {
+			in_table = (line.find("--- PROFILE COUNTERS ---") != string::npos);
+			continue;
+		}
+		if (line.compare(0, 3, " */") == 0)
+			return true;
+		istringstream fields(line.substr(line.find('*') + 1));
+		Counter c;
+		if (!(fields >> c.index >> c.kind >> c.function >> c.block))
+			continue;	// the header line
+		if (c.index != counters.size()) {
+			cerr << "csmith-profile: bad counter table in " << program << endl;
+			return false;
+		}
+		c.count = 0;
+		counters.push_back(c);
+	}
+	cerr << "csmith-profile: " << program << " has no profile counters" << endl;
+	return false;
+}
+
+static bool
+add_profile(const string &profile, vector<Counter> &counters)
+{
+	FILE *f = fopen(profile.c_str(), "rb");
+	if (!f) {
+		cerr << "csmith-profile: cannot read " << profile << endl;
+		return false;
+	}
+	uint32_t header[4];
+	bool ok = (fread(header, sizeof(uint32_t), 4, f) == 4);
+	if (ok && (header[0] != profile_magic || header[1] != profile_version)) {
+		cerr << "csmith-profile: " << profile << " is not a profile" << endl;
+		ok = false;
+	}
+	else if (ok && header[2] != counters.size()) {
+		cerr << "csmith-profile: " << profile << " has " << header[2]
+		     << " counters, the program " << counters.size() << endl;
+		ok = false;
+	}
+	vector<uint32_t> counts(counters.size());
+	if (ok && !counts.empty() &&
+		fread(&counts[0], sizeof(uint32_t), counts.size(), f) != counts.size()) {
+		cerr << "csmith-profile: " << profile << " is truncated" << endl;
+		ok = false;
+	}
+	fclose(f);
+	if (!ok)
+		return false;
+	for (size_t i = 0; i < counters.size(); i++) {
+		counters[i].count += counts[i];
+	}
+	return true;
+}
+
+int
+main(int argc, char **argv)
+{
+	if (argc < 3 || strcmp(argv[1], "--help") == 0) {
+		print_help();
+		return 2;
+	}
+	vector<Counter> counters;
+	if (!read_table(argv[1], counters))
+		return 1;
+	for (int i = 2; i < argc; i++) {
+		if (!add_profile(argv[i], counters))
+			return 1;
+	}
+
+	unsigned long long total = 0;
+	for (size_t i = 0; i < counters.size(); i++) {
+		total += counters[i].count;
+	}
+	sort(counters.begin(), counters.end(), more_frequent);
+	cout << "# count percent kind function block" << endl;
+	for (size_t i = 0; i < counters.size(); i++) {
+		const Counter &c = counters[i];
+		char percent[16];
+		sprintf(percent, "%.2f", total ? 100.0 * c.count / total : 0.0);
+		cout << c.count << " " << percent << " " << c.kind << " "
+		     << c.function << " " << c.block << endl;
+	}
+	return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
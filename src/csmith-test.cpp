@@ -0,0 +1,938 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+
+//
+// csmith-test: differential testing of C compilers with Csmith, as
+// scripts/compiler_test.pl does, but in one process that keeps every core
+// busy.  The configuration file is the one compiler_test.pl reads: one
+// compiler command line per line, "#" starting a comment.
+//
+// Each test goes through four stages: the program is generated (in this
+// process, with libcsmith), compiled with every configured compiler, each
+// executable is run, and the checksums are compared.  A pool of worker
+// threads takes the next task of any test, preferring the later stages so
+// that tests drain, and otherwise generates the next program; generation
+// of the next seeds thus overlaps the compilation of the current ones.
+// Each stage has its own limit of tasks running at once.
+//
+// Compilers and test programs run through the Executor, with their output
+// captured in memory.  The programs, executables and traces of the tests
+// under way live in a directory in /dev/shm where there is one, and in
+// the current directory otherwise (--work-dir chooses another).
+//
+// With --cache, results come from the result cache (see ResultCache.h)
+// when the same program was compiled and run with the same compiler and
+// flags before, e.g. when a range of seeds is tested again after a
+// compiler changed, and are recorded there otherwise.  A program whose
+// result comes from the cache leaves no trace.
+//
+// Interesting programs are kept in the current directory under the names
+// compiler_test.pl uses (crash<n>.c, wrong<n>.c, csmith_bug_<n>.c), with
+// the findings appended as comments.  For programs generated with
+// --checksum-trace, a checksum difference also names the first function
+// whose results differ.
+//
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "libcsmith.h"
+#include "Executor.h"
+#include "ResultCache.h"
+#include "platform.h"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+
+// the trace of a program generated with --checksum-trace, see csmith_trace.h
+static const uint32_t trace_magic = 0x52545343UL;	// "CSTR"
+
+static void
+print_help(void)
+{
+	cout << "Usage: csmith-test [options] <test_case_count>(0 for unlimited) <config-file>" << endl
+	     << "                   [--with-wrong-code-bugs]" << endl
+	     << endl
+	     << "  --jobs <n>: run at most <n> tasks at once (default: the number of CPUs)" << endl
+	     << "  --gen-jobs <n>: generate at most <n> programs at once (default: a quarter of the jobs)" << endl
+	     << "  --compile-jobs <n>: run at most <n> compilers at once (default: the jobs)" << endl
+	     << "  --run-jobs <n>: run at most <n> test programs at once (default: the jobs)" << endl
+	     << "  --csmith-options <options>: Csmith options (default: \"--bitfields --packed-struct\")" << endl
+	     << "  --compile-options <options>: options for every compiler, e.g. -I for safe_math.h" << endl
+	     << "  --runtime <dir>: the Csmith runtime headers (default: $CSMITH_HOME/runtime)" << endl
+	     << "  --min-size <bytes>: programs shorter than this are not tested (default: 8000)" << endl
+	     << "  --seed <n>: the seed of the first program (default: a random one)" << endl
+	     << "  --compiler-timeout <seconds>: kill a compiler after this long (default: 120)" << endl
+	     << "  --prog-timeout <seconds>: kill a test program after this long (default: 8)" << endl
+	     << "  --work-dir <dir>: where the tests under way live (default: a new directory in /dev/shm)" << endl
+	     << "  --cache <dir>: reuse and record the results of compilers and test programs there" << endl
+	     << "  --cache-max <n>: keep at most <n> results in the cache (default: "
+	     << ResultCache::default_max_entries << ")" << endl
+	     << endl
+	     << "As with compiler_test.pl, test programs are only run with --with-wrong-code-bugs." << endl;
+}
+
+static vector<string>
+split_words(const string &s)
+{
+	vector<string> words;
+	istringstream in(s);
+	string w;
+	while (in >> w)
+		words.push_back(w);
+	return words;
+}
+
+static bool
+read_file(const string &file, string &data)
+{
+	ifstream in(file.c_str(), ios::binary);
+	if (!in)
+		return false;
+	ostringstream s;
+	s << in.rdbuf();
+	data = s.str();
+	return true;
+}
+
+static void
+append_bug_desc(const string &file, const string &desc)
+{
+	ofstream out(file.c_str(), ios::app);
+	out << "/* " << desc << " */" << endl;
+}
+
+static bool
+copy_file(const string &from, const string &to)
+{
+	string data;
+	if (!read_file(from, data))
+		return false;
+	ofstream out(to.c_str(), ios::binary);
+	out.write(data.data(), data.size());
+	return !!out;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool
+read_trace(const string &file, vector<uint32_t> &trace)
+{
+	string data;
+	if (!read_file(file, data) || data.size() < 2 * sizeof(uint32_t))
+		return false;
+	trace.resize(data.size() / sizeof(uint32_t));
+	memcpy(&trace[0], data.data(), trace.size() * sizeof(uint32_t));
+	return trace[0] == trace_magic;
+}
+
+// The first function exit whose state differs between two traces, in the
+// words of compiler_test.pl; empty if there are no traces or no difference
+static string
+first_trace_divergence(const string &file1, const string &file2)
+{
+	vector<uint32_t> a, b;
+	if (!read_trace(file1, a) || !read_trace(file2, b))
+		return "";
+	ostringstream s;
+	size_t i;
+	for (i = 2; i + 1 < a.size() && i + 1 < b.size(); i += 2) {
+		if (a[i] != b[i] || a[i + 1] != b[i + 1]) {
+			s << "first divergence at function exit #" << (i - 2) / 2 << ": func_" << a[i];
+			if (a[i] != b[i])
+				s << " vs. func_" << b[i];
+			return s.str();
+		}
+	}
+	if (a.size() != b.size()) {
+		s << "first divergence at function exit #" << (i - 2) / 2 << ": one trace ends there";
+	}
+	return s.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// The outcome of compiling and running a test program with one compiler,
+// coded as in compiler_test.pl
+enum TestResult {
+	tNormal = 0,
+	tCompilerCrash = 1,
+	tCompilerHang = 2,
+	tProgramCrash = 3,
+	tProgramHang = 4
+};
+
+struct Test {
+	unsigned long n;
+	unsigned long seed;
+	string cfile;
+	size_t size;
+	bool generated;
+	bool too_small;
+	// whether the test counts towards the test case count
+	bool counts;
+	// compilers and runs not done yet
+	size_t pending;
+	vector<TestResult> results;
+	vector<string> checksums;
+	// with a cache: the program, and per compiler the cache key, the
+	// result to record, and whether it came from the cache
+	string program;
+	vector<string> keys;
+	vector<ResultCache::Entry> entries;
+	vector<bool> cached;
+};
+
+enum Stage {
+	sGenerate,
+	sCompile,
+	sRun,
+	sCompare,
+	NUM_STAGES
+};
+
+struct Task {
+	Stage stage;
+	Test *test;
+	size_t compiler;
+};
+
+class Harness {
+public:
+	Harness();
+	~Harness();
+
+	bool run_program;
+	unsigned long count;
+	unsigned long first_seed;
+	size_t min_size;
+	int compiler_timeout;
+	int prog_timeout;
+	string work_dir;
+	string header;
+	string compile_options;
+	vector<string> compilers;
+	const csmith_options *opts;
+	ResultCache *cache;
+	int limits[NUM_STAGES];
+	unsigned long max_in_flight;
+
+	static void worker(void *p) { static_cast<Harness *>(p)->work(); }
+	void print_totals(void);
+
+private:
+	void work(void);
+	bool next_task(Task &t);
+	bool want_more(void) const;
+	void finish_task(const Task &t);
+
+	void generate(Test &test);
+	void compile(Test &test, size_t i);
+	void execute(Test &test, size_t i);
+	bool use_cached(Test &test, size_t i);
+	int evaluate(Test &test);
+	void report(Test &test, int ret);
+	void clean_up(const Test &test);
+
+	string exe_name(const Test &test, size_t i) const;
+	string trace_name(const Test &test, size_t i) const;
+	void account(const Executor::Result &r, double &secs);
+
+	PlatformMutex *mutex_;
+	PlatformCond *cond_;
+	deque<Task> queues_[NUM_STAGES];
+	int running_[NUM_STAGES];
+	unsigned long next_n_;
+	unsigned long in_flight_;
+	unsigned long completed_;
+
+	int good_;
+	int crash_bug_;
+	int wrongcode_bug_;
+	int csmith_bug_;
+
+	// the resources the compilers and the test programs used
+	double compile_secs_;
+	double run_secs_;
+	long max_rss_kb_;
+};
+
+Harness::Harness()
+	: run_program(false),
+	  count(0),
+	  first_seed(0),
+	  min_size(8000),
+	  compiler_timeout(120),
+	  prog_timeout(8),
+	  opts(NULL),
+	  cache(NULL),
+	  max_in_flight(0),
+	  mutex_(platform_mutex_create()),
+	  cond_(platform_cond_create()),
+	  next_n_(0),
+	  in_flight_(0),
+	  completed_(0),
+	  good_(0),
+	  crash_bug_(0),
+	  wrongcode_bug_(0),
+	  csmith_bug_(0),
+	  compile_secs_(0),
+	  run_secs_(0),
+	  max_rss_kb_(0)
+{
+	for (int i = 0; i < NUM_STAGES; i++) {
+		limits[i] = 1;
+		running_[i] = 0;
+	}
+}
+
+Harness::~Harness()
+{
+	platform_cond_destroy(cond_);
+	platform_mutex_destroy(mutex_);
+}
+
+string
+Harness::exe_name(const Test &test, size_t i) const
+{
+	ostringstream s;
+	s << work_dir << "/test" << test.n << ".exe" << i;
+	return s.str();
+}
+
+string
+Harness::trace_name(const Test &test, size_t i) const
+{
+	ostringstream s;
+	s << work_dir << "/test" << test.n << ".trace" << i;
+	return s.str();
+}
+
+void
+Harness::account(const Executor::Result &r, double &secs)
+{
+	platform_mutex_lock(mutex_);
+	secs += r.user_secs + r.sys_secs;
+	if (r.max_rss_kb > max_rss_kb_)
+		max_rss_kb_ = r.max_rss_kb;
+	platform_mutex_unlock(mutex_);
+}
+
+// with a test case count, no more programs than needed are generated
+bool
+Harness::want_more(void) const
+{
+	return count == 0 || completed_ + in_flight_ < count;
+}
+
+// Take the next task, the latest stage first; a new program is generated
+// only if no other task may start.  Called with the mutex held
+bool
+Harness::next_task(Task &t)
+{
+	for (int s = NUM_STAGES - 1; s > sGenerate; s--) {
+		if (!queues_[s].empty() && running_[s] < limits[s]) {
+			t = queues_[s].front();
+			queues_[s].pop_front();
+			return true;
+		}
+	}
+	if (running_[sGenerate] < limits[sGenerate] && in_flight_ < max_in_flight && want_more()) {
+		Test *test = new Test;
+		test->n = next_n_++;
+		test->seed = first_seed + test->n;
+		ostringstream s;
+		s << work_dir << "/test" << test->n << ".c";
+		test->cfile = s.str();
+		test->size = 0;
+		test->generated = false;
+		test->too_small = false;
+		test->counts = true;
+		test->pending = compilers.size();
+		test->results.resize(compilers.size(), tNormal);
+		test->checksums.resize(compilers.size());
+		if (cache) {
+			test->keys.resize(compilers.size());
+			test->entries.resize(compilers.size());
+			test->cached.resize(compilers.size(), false);
+		}
+		t.stage = sGenerate;
+		t.test = test;
+		t.compiler = 0;
+		in_flight_++;
+		return true;
+	}
+	return false;
+}
+
+void
+Harness::work(void)
+{
+	platform_mutex_lock(mutex_);
+	for (;;) {
+		Task t;
+		if (!next_task(t)) {
+			if (in_flight_ == 0 && !want_more())
+				break;
+			platform_cond_wait(cond_, mutex_);
+			continue;
+		}
+		running_[t.stage]++;
+		platform_mutex_unlock(mutex_);
+
+		switch (t.stage) {
+		case sGenerate:
+			generate(*t.test);
+			break;
+		case sCompile:
+			compile(*t.test, t.compiler);
+			break;
+		case sRun:
+			execute(*t.test, t.compiler);
+			break;
+		default:
+			report(*t.test, evaluate(*t.test));
+			clean_up(*t.test);
+			break;
+		}
+
+		platform_mutex_lock(mutex_);
+		running_[t.stage]--;
+		finish_task(t);
+		platform_cond_broadcast(cond_);
+	}
+	platform_cond_broadcast(cond_);
+	platform_mutex_unlock(mutex_);
+}
+
+// Queue the tasks that follow a finished one.  Called with the mutex held
+void
+Harness::finish_task(const Task &t)
+{
+	Test *test = t.test;
+	Task next;
+	next.test = test;
+	next.compiler = t.compiler;
+	switch (t.stage) {
+	case sGenerate:
+		if (!test->generated || test->too_small) {
+			// does not count, as in compiler_test.pl
+			in_flight_--;
+			delete test;
+			return;
+		}
+		next.stage = sCompile;
+		for (size_t i = 0; i < compilers.size(); i++) {
+			next.compiler = i;
+			queues_[sCompile].push_back(next);
+		}
+		return;
+	case sCompile:
+		if (run_program && test->results[t.compiler] == tNormal && !(cache && test->cached[t.compiler])) {
+			next.stage = sRun;
+			queues_[sRun].push_back(next);
+			return;
+		}
+		break;
+	case sRun:
+		break;
+	default:
+		in_flight_--;
+		if (test->counts)
+			completed_++;
+		delete test;
+		return;
+	}
+	if (--test->pending == 0) {
+		next.stage = sCompare;
+		queues_[sCompare].push_back(next);
+	}
+}
+
+static void
+append_to_string(void *arg, const char *data, size_t len)
+{
+	static_cast<string *>(arg)->append(data, len);
+}
+
+void
+Harness::generate(Test &test)
+{
+	string program;
+	csmith_sink sink;
+	memset(&sink, 0, sizeof(sink));
+	sink.write = append_to_string;
+	sink.arg = &program;
+	int res = csmith_generate(opts, test.seed, &sink);
+
+	ofstream out(test.cfile.c_str(), ios::binary);
+	out.write(program.data(), program.size());
+	out.close();
+	test.size = program.size();
+	if (cache)
+		test.program.swap(program);
+	if (res != CSMITH_OK) {
+		platform_mutex_lock(mutex_);
+		cout << "CSMITH BUG FOUND: number " << csmith_bug_ << endl;
+		csmith_bug_++;
+		ostringstream s;
+		s << "csmith_bug_" << csmith_bug_ << ".c";
+		copy_file(test.cfile, s.str());
+		platform_mutex_unlock(mutex_);
+		unlink(test.cfile.c_str());
+		return;
+	}
+	test.generated = true;
+	if (test.size < min_size) {
+		test.too_small = true;
+		unlink(test.cfile.c_str());
+	}
+}
+
+void
+Harness::compile(Test &test, size_t i)
+{
+	if (cache && use_cached(test, i))
+		return;
+	string exe = exe_name(test, i);
+	string command = compilers[i] + " " + test.cfile + " " + compile_options + " " + header + " -o " + exe;
+	Executor exec;
+	Executor::Limits limits;
+	limits.timeout = compiler_timeout;
+	Executor::Result r;
+	bool started = exec.run_shell(command, limits, r);
+	account(r, compile_secs_);
+	if (r.timed_out) {
+		test.results[i] = tCompilerHang;
+		return;
+	}
+	if (!started || r.shell_status() != 0 || access(exe.c_str(), F_OK) != 0)
+		test.results[i] = tCompilerCrash;
+	if (cache) {
+		ResultCache::Entry &e = test.entries[i];
+		e.compile_status = (test.results[i] == tCompilerCrash && r.shell_status() == 0) ? 1 : r.shell_status();
+		e.compiler_output = exec.captured();
+		// a program that is run is recorded with its result
+		if (!run_program || test.results[i] != tNormal)
+			cache->store(test.keys[i], e);
+	}
+}
+
+// Take the result of compiler i, and of running its executable, from the
+// cache, if it has them
+bool
+Harness::use_cached(Test &test, size_t i)
+{
+	test.keys[i] = ResultCache::key(test.program, compilers[i], compile_options + " " + header);
+	ResultCache::Entry e;
+	if (!cache->lookup(test.keys[i], e) || (run_program && e.compile_status == 0 && !e.ran))
+		return false;
+	test.cached[i] = true;
+	if (e.compile_status != 0) {
+		test.results[i] = tCompilerCrash;
+	} else if (e.ran && (e.run_status > 128 || e.run_status == 127)) {
+		test.results[i] = tProgramCrash;
+	} else {
+		test.checksums[i] = e.checksum;
+	}
+	return true;
+}
+
+void
+Harness::execute(Test &test, size_t i)
+{
+	vector<string> args;
+	args.push_back(exe_name(test, i));
+	vector<string> env;
+	env.push_back("CSMITH_TRACE=" + trace_name(test, i));
+	Executor exec;
+	Executor::Limits limits;
+	limits.timeout = prog_timeout;
+	Executor::Result r;
+	bool started = exec.run(args, env, limits, r);
+	account(r, run_secs_);
+	if (r.timed_out) {
+		test.results[i] = tProgramHang;
+		return;
+	}
+	if (!started || r.signal) {
+		test.results[i] = tProgramCrash;
+	} else {
+		test.checksums[i] = ResultCache::find_checksum(exec.captured());
+	}
+	if (cache) {
+		ResultCache::Entry &e = test.entries[i];
+		e.ran = true;
+		e.run_status = started ? r.shell_status() : 127;
+		e.program_output = exec.captured();
+		e.checksum = test.checksums[i];
+		cache->store(test.keys[i], e);
+	}
+}
+
+// Compare the results of the compilers, as evaluate_program in
+// compiler_test.pl does:
+//   -2: the program crashes (a likely wrong-code bug)
+//   -1: the program hangs (not interesting)
+//    0: no compiler error found (not interesting)
+//    1: a compiler crashed or hung
+//    2: the checksums differ
+int
+Harness::evaluate(Test &test)
+{
+	int interesting = 0;
+	vector<size_t> tested;
+	for (size_t i = 0; i < compilers.size(); i++) {
+		TestResult res = test.results[i];
+		if (res == tCompilerCrash || res == tCompilerHang) {
+			append_bug_desc(test.cfile, "Compiler error! Can't compile with " + compilers[i] + " " +
+							compile_options + " " + header);
+			interesting = 1;
+		} else if (res == tProgramCrash) {
+			append_bug_desc(test.cfile, "random program crashed!");
+			interesting = -2;
+			break;
+		} else if (res == tProgramHang) {
+			interesting = -1;
+			break;
+		} else if (run_program) {
+			if (!tested.empty() && test.checksums[i] != test.checksums[tested[0]])
+				interesting = 2;
+			tested.push_back(i);
+		}
+	}
+	if (interesting >= 1) {
+		if (interesting == 2) {
+			append_bug_desc(test.cfile, "Found checksum difference between compiler implementations");
+			for (size_t j = 0; j < tested.size(); j++) {
+				append_bug_desc(test.cfile, compilers[tested[j]] + " " + compile_options + ": " +
+								test.checksums[tested[j]]);
+			}
+			for (size_t j = 1; j < tested.size(); j++) {
+				if (test.checksums[tested[j]] == test.checksums[tested[0]])
+					continue;
+				string where = first_trace_divergence(trace_name(test, tested[0]), trace_name(test, tested[j]));
+				if (!where.empty()) {
+					append_bug_desc(test.cfile, compilers[tested[j]] + " vs. " + compilers[tested[0]] +
+									": " + where);
+				}
+			}
+		}
+		append_bug_desc(test.cfile,
+						"please refer to http://embed.cs.utah.edu/csmith/using.html on how to report a bug");
+	}
+	return interesting;
+}
+
+// Print what compiler_test.pl prints for a test, keep the program if it
+// is interesting, and tell finish_task whether the test counts
+void
+Harness::report(Test &test, int ret)
+{
+	platform_mutex_lock(mutex_);
+	cout << "seed= " << test.seed << ", size= " << test.size << endl;
+	if (ret == -1)
+		cout << "random program hangs!" << endl;
+	if (ret >= 0) {
+		good_++;
+		cout << "GOOD PROGRAM: number " << good_ << endl;
+		if (ret == 1) {
+			cout << "COMPILER CRASH ERROR FOUND: number " << crash_bug_ << endl;
+			crash_bug_++;
+			ostringstream s;
+			s << "crash" << crash_bug_ << ".c";
+			copy_file(test.cfile, s.str());
+		}
+		if (ret == 2) {
+			cout << "LIKELY WRONG CODE ERROR FOUND: number " << wrongcode_bug_ << endl;
+			wrongcode_bug_++;
+			ostringstream s;
+			s << "wrong" << wrongcode_bug_ << ".c";
+			copy_file(test.cfile, s.str());
+		}
+	} else {
+		cout << "BAD PROGRAM: doesn't count towards goal." << endl;
+	}
+	cout << endl;
+	platform_mutex_unlock(mutex_);
+	test.counts = (ret != -1);
+}
+
+void
+Harness::clean_up(const Test &test)
+{
+	unlink(test.cfile.c_str());
+	for (size_t i = 0; i < compilers.size(); i++) {
+		string exe = exe_name(test, i);
+		unlink(exe.c_str());
+		unlink(trace_name(test, i).c_str());
+	}
+}
+
+void
+Harness::print_totals(void)
+{
+	cout << "Total csmith errors found: " << csmith_bug_ << endl;
+	cout << "Total crash errors found: " << crash_bug_ << endl;
+	if (run_program)
+		cout << "Total wrong-code errors found: " << wrongcode_bug_ << endl;
+	cout << "CPU seconds in compilers: " << compile_secs_ << ", in test programs: " << run_secs_
+	     << "; peak RSS: " << max_rss_kb_ << " kB" << endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool
+parse_count(const char *s, unsigned long &n)
+{
+	char *end;
+	errno = 0;
+	n = strtoul(s, &end, 10);
+	return *s >= '0' && *s <= '9' && *end == '\0' && errno == 0;
+}
+
+// compiler_test.pl makes sure that each configured compiler works
+static bool
+read_config(const string &file, const string &work_dir, vector<string> &compilers)
+{
+	ifstream in(file.c_str());
+	if (!in) {
+		cerr << "Cannot read configuration file " << file << "." << endl;
+		return false;
+	}
+	string foo = work_dir + "/csmith-test-foo";
+	{
+		ofstream out((foo + ".c").c_str());
+		out << "int main() { return 0;}" << endl;
+	}
+	Executor exec;
+	Executor::Limits limits;
+	limits.timeout = 120;
+	string line;
+	bool ok = true;
+	while (ok && getline(in, line)) {
+		if (!line.empty() && line[line.size() - 1] == '\r')
+			line.erase(line.size() - 1);
+		size_t first = line.find_first_not_of(" \t");
+		if (first == string::npos || line[first] == '#')
+			continue;
+		Executor::Result r;
+		if (!exec.run_shell(line + " " + foo + ".c -o " + foo + ".exe", limits, r) || r.shell_status() != 0) {
+			cerr << "cannot execute compiler " << line << endl;
+			ok = false;
+		}
+		compilers.push_back(line);
+	}
+	unlink((foo + ".c").c_str());
+	unlink((foo + ".exe").c_str());
+	if (ok && compilers.empty()) {
+		cerr << "No compiler in configuration file " << file << "." << endl;
+		ok = false;
+	}
+	return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+	Harness h;
+	int jobs = platform_cpu_count();
+	int gen_jobs = 0;
+	int compile_jobs = 0;
+	int run_jobs = 0;
+	bool have_seed = false;
+	string csmith_args = "--bitfields --packed-struct";
+	string runtime;
+	string cache_dir;
+	unsigned long cache_max = ResultCache::default_max_entries;
+	vector<string> args;
+
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		unsigned long n;
+		if (arg == "--help" || arg == "-h") {
+			print_help();
+			return 0;
+		}
+		if (arg.size() > 2 && arg.compare(0, 2, "--") == 0 && arg != "--with-wrong-code-bugs") {
+			if (i + 1 >= argc) {
+				cerr << "csmith-test: " << arg << " needs an argument" << endl;
+				return 2;
+			}
+			string value = argv[++i];
+			if (arg == "--csmith-options") {
+				csmith_args = value;
+			} else if (arg == "--compile-options") {
+				h.compile_options = value;
+			} else if (arg == "--runtime") {
+				runtime = value;
+			} else if (arg == "--work-dir") {
+				h.work_dir = value;
+			} else if (arg == "--cache") {
+				cache_dir = value;
+			} else if (!parse_count(value.c_str(), n)) {
+				cerr << "csmith-test: " << arg << " needs a number" << endl;
+				return 2;
+			} else if (arg == "--jobs" && n > 0) {
+				jobs = static_cast<int>(n);
+			} else if (arg == "--gen-jobs" && n > 0) {
+				gen_jobs = static_cast<int>(n);
+			} else if (arg == "--compile-jobs" && n > 0) {
+				compile_jobs = static_cast<int>(n);
+			} else if (arg == "--run-jobs" && n > 0) {
+				run_jobs = static_cast<int>(n);
+			} else if (arg == "--cache-max" && n > 0) {
+				cache_max = n;
+			} else if (arg == "--min-size") {
+				h.min_size = n;
+			} else if (arg == "--seed") {
+				h.first_seed = n;
+				have_seed = true;
+			} else if (arg == "--compiler-timeout" && n > 0) {
+				h.compiler_timeout = static_cast<int>(n);
+			} else if (arg == "--prog-timeout" && n > 0) {
+				h.prog_timeout = static_cast<int>(n);
+			} else {
+				cerr << "csmith-test: bad option " << arg << " " << value << endl;
+				return 2;
+			}
+			continue;
+		}
+		args.push_back(arg);
+	}
+	if (args.size() == 3 && args[2] == "--with-wrong-code-bugs") {
+		cout << "Finding both crash bugs and wrong-code bugs" << endl;
+		h.run_program = true;
+	} else if (args.size() != 2) {
+		print_help();
+		return 2;
+	}
+	if (!parse_count(args[0].c_str(), h.count)) {
+		print_help();
+		return 2;
+	}
+
+	if (runtime.empty()) {
+		const char *home = getenv("CSMITH_HOME");
+		if (!home) {
+			cerr << "Please point the environment variable CSMITH_HOME to the top-level" << endl
+			     << "directory of your Csmith tree, or use --runtime." << endl;
+			return 2;
+		}
+		runtime = string(home) + "/runtime";
+	}
+	if (access((runtime + "/csmith.h").c_str(), R_OK) != 0) {
+		cerr << "csmith-test: cannot find " << runtime << "/csmith.h" << endl;
+		return 2;
+	}
+	h.header = "-I" + runtime;
+
+	// the tests under way live in memory where possible
+	bool own_work_dir = false;
+	if (h.work_dir.empty()) {
+		char shm[] = "/dev/shm/csmith-test.XXXXXX";
+		if (access("/dev/shm", W_OK) == 0 && mkdtemp(shm)) {
+			h.work_dir = shm;
+			own_work_dir = true;
+		} else {
+			h.work_dir = ".";
+		}
+	}
+
+	if (!read_config(args[1], h.work_dir, h.compilers)) {
+		if (own_work_dir)
+			rmdir(h.work_dir.c_str());
+		return 1;
+	}
+
+	// ask Csmith to grow the programs to the minimum size, which makes
+	// programs that are too small rare
+	vector<string> words = split_words(csmith_args);
+	ostringstream min_size;
+	min_size << h.min_size;
+	words.push_back("--min-size");
+	words.push_back(min_size.str());
+	vector<const char *> cargs;
+	for (size_t i = 0; i < words.size(); i++)
+		cargs.push_back(words[i].c_str());
+	char err[512];
+	csmith_options *opts = csmith_options_create(static_cast<int>(cargs.size()), &cargs[0], err, sizeof(err));
+	if (!opts) {
+		cerr << "csmith-test: " << err << endl;
+		if (own_work_dir)
+			rmdir(h.work_dir.c_str());
+		return 2;
+	}
+	h.opts = opts;
+	ResultCache *cache = cache_dir.empty() ? NULL : new ResultCache(cache_dir, cache_max);
+	h.cache = cache;
+	if (!have_seed)
+		h.first_seed = platform_gen_seed();
+
+	h.limits[sGenerate] = gen_jobs ? gen_jobs : (jobs + 3) / 4;
+	h.limits[sCompile] = compile_jobs ? compile_jobs : jobs;
+	h.limits[sRun] = run_jobs ? run_jobs : jobs;
+	h.limits[sCompare] = jobs;
+	// enough tests under way to keep the compilers busy, but not so many
+	// that the disk fills with programs waiting for them
+	h.max_in_flight = 2 * jobs;
+
+	cout << "testing " << h.compilers.size() << " compilers with " << jobs << " jobs, from seed "
+	     << h.first_seed << endl << endl;
+	bool ok = platform_run_threads(jobs, Harness::worker, &h);
+	if (!ok)
+		cerr << "csmith-test: can't create the worker threads" << endl;
+	h.print_totals();
+	delete cache;
+	csmith_options_destroy(opts);
+	if (own_work_dir)
+		rmdir(h.work_dir.c_str());
+	return ok ? 0 : 1;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,247 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "libcsmith.h"
+
+#include <cstring>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "CGOptions.h"
+#include "CommandLine.h"
+#include "GenerationContext.h"
+#include "ProgramGenerator.h"
+#include "platform.h"
+
+using namespace std;
+
+struct csmith_options {
+	// the command line, without --seed and --output
+	vector<string> args;
+
+	// tells the options objects apart, see apply_options
+	long id;
+};
+
+// the options object whose settings are in CGOptions
+static volatile long applied_options = 0;
+
+static volatile long options_count = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * A stream buffer that writes to a csmith_sink.
+ */
+class SinkBuf : public std::streambuf
+{
+public:
+	explicit SinkBuf(csmith_sink *sink) : sink_(sink) {
+		sink_->len = 0;
+		setp(buf_, buf_ + sizeof(buf_));
+	}
+
+protected:
+	virtual int overflow(int c) {
+		flush();
+		if (c != traits_type::eof()) {
+			*pptr() = static_cast<char>(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	virtual int sync(void) {
+		flush();
+		return 0;
+	}
+
+private:
+	void flush(void) {
+		size_t n = pptr() - pbase();
+		if (sink_->write) {
+			if (n)
+				sink_->write(sink_->arg, pbase(), n);
+		}
+		else if (sink_->len < sink_->size) {
+			size_t room = sink_->size - sink_->len;
+			memcpy(sink_->buf + sink_->len, pbase(), (n < room) ? n : room);
+		}
+		sink_->len += n;
+		setp(buf_, buf_ + sizeof(buf_));
+	}
+
+	csmith_sink *sink_;
+
+	char buf_[4096];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void
+set_error(char *err, size_t err_size, const string &msg)
+{
+	if (!err || !err_size)
+		return;
+	size_t n = (msg.size() < err_size - 1) ? msg.size() : err_size - 1;
+	memcpy(err, msg.data(), n);
+	err[n] = '\0';
+}
+
+/*
+ * Parse args (preceded by a program name) into CGOptions.
+ */
+static bool
+parse_options(const vector<string> &args, string &msg)
+{
+	vector<char *> argv;
+	argv.push_back(const_cast<char *>("csmith"));
+	for (size_t i = 0; i < args.size(); i++)
+		argv.push_back(const_cast<char *>(args[i].c_str()));
+	argv.push_back(NULL);
+
+	ostringstream out;
+	CommandLine cl;
+	cl.library = true;
+	eCommandLineResult res = cl.parse(static_cast<int>(argv.size()) - 1, &argv[0], out);
+	msg = out.str();
+	if (res == eCmdDone) {
+		msg = "nothing to generate with --help or --version";
+		return false;
+	}
+	if (res == eCmdError)
+		return false;
+	if (cl.batch || cl.jobs > 1 || !cl.archive.empty() || cl.serve || cl.fork_server) {
+		msg = "batch and server options are not supported by the library";
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Make the settings of opts the ones in CGOptions, unless they already are.
+ */
+static bool
+apply_options(const csmith_options *opts)
+{
+	if (applied_options == opts->id)
+		return true;
+	// CGOptions is about to change, and holds no options object's settings
+	// if the parse fails halfway
+	applied_options = 0;
+	string msg;
+	if (!parse_options(opts->args, msg))
+		return false;
+	applied_options = opts->id;
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+csmith_options *
+csmith_options_create(int argc, const char *const argv[], char *err, size_t err_size)
+{
+	csmith_options *opts = new csmith_options;
+	for (int i = 0; i < argc; i++) {
+		string arg = argv[i];
+		if ((arg == "--seed" || arg == "-s" || arg == "--output" || arg == "-o") &&
+			i + 1 < argc) {
+			i++;
+			continue;
+		}
+		opts->args.push_back(arg);
+	}
+	opts->id = platform_fetch_and_inc(&options_count) + 1;
+
+	applied_options = 0;
+	string msg;
+	if (!parse_options(opts->args, msg)) {
+		set_error(err, err_size, msg);
+		delete opts;
+		return NULL;
+	}
+	applied_options = opts->id;
+	return opts;
+}
+
+void
+csmith_options_destroy(csmith_options *opts)
+{
+	delete opts;
+}
+
+int
+csmith_generate(const csmith_options *opts, uint64_t seed, csmith_sink *sink)
+{
+	if (!opts || !sink || !apply_options(opts))
+		return CSMITH_ERROR;
+
+	// the command line shown in the program header
+	ostringstream ss;
+	ss << static_cast<unsigned long>(seed);
+	vector<string> args;
+	args.push_back("csmith");
+	args.insert(args.end(), opts->args.begin(), opts->args.end());
+	args.push_back("--seed");
+	args.push_back(ss.str());
+	vector<char *> argv;
+	for (size_t i = 0; i < args.size(); i++)
+		argv.push_back(const_cast<char *>(args[i].c_str()));
+	argv.push_back(NULL);
+
+	SinkBuf buf(sink);
+	ostream out(&buf);
+	GenerationContext ctx;
+	GenerationContext::set_current(&ctx);
+	ctx.output_stream = &out;
+	ProgramGenerator *generator = ProgramGenerator::CreateInstance(static_cast<int>(args.size()), &argv[0],
+																   static_cast<unsigned long>(seed));
+	generator->Init();
+	generator->GoGenerator();
+	delete generator;
+	GenerationContext::set_current(NULL);
+	out.flush();
+
+	if (sink->write)
+		return CSMITH_OK;
+	if (sink->len < sink->size) {
+		sink->buf[sink->len] = '\0';
+		return CSMITH_OK;
+	}
+	return CSMITH_TRUNCATED;
+}
+
+// Local Variables:
+// c-basic-offset: 4
+// tab-width: 4
+// End:
+
+// End of file.
@@ -0,0 +1,105 @@
+// -*- mode: C++ -*-
+//
+// Copyright (c) 2012 The University of Utah
+// All rights reserved.
+//
+// This file is part of `csmith', a random generator of C programs.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//   * Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * libcsmith: the Csmith generator as a library, libcsmith_gen.a (the
+ * runtime library of the generated programs is libcsmith.a).
+ *
+ * The options are parsed once from a Csmith command line and can then be
+ * used to generate any number of programs, each written to a caller-owned
+ * buffer or handed to a callback instead of a file or stdout.  Generation
+ * never writes to the file system unless the options ask for it (--profile).
+ * The options read platform.info from the working directory, as csmith
+ * does, but do not create it; a bad one makes csmith_options_create() fail.
+ *
+ * csmith_generate() may be called from several threads at once.  The parsed
+ * options are process-wide in Csmith, however, so concurrent calls must use
+ * the same options object, and csmith_options_create() must not run while
+ * any thread is generating.
+ *
+ * The library leaves the global operator new and delete to the caller; the
+ * heap accounting behind --memory-stats and --max-memory is in the csmith
+ * program only, so these options have no effect here.
+ */
+#ifndef LIBCSMITH_H
+#define LIBCSMITH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CSMITH_OK			0
+#define CSMITH_TRUNCATED	1	/* the buffer was too small; see csmith_sink.len */
+#define CSMITH_ERROR		(-1)
+
+typedef struct csmith_options csmith_options;
+
+/*
+ * Parse the arguments of a csmith command line, without the program name.
+ * On error, returns NULL and puts the message into err (if not NULL).
+ * --seed, if given, is ignored in favor of the seed of each call to
+ * csmith_generate(); --output is ignored; batch and server options are
+ * errors.
+ */
+csmith_options *csmith_options_create(int argc, const char *const argv[],
+									  char *err, size_t err_size);
+
+void csmith_options_destroy(csmith_options *opts);
+
+/*
+ * Where a generated program goes.  If write is set, the program is passed
+ * to it piece by piece; otherwise it is copied to buf and NUL-terminated,
+ * as much as fits into size bytes.  In both cases, len is set to the length
+ * of the whole program, so that a call with a NULL buf and a zero size
+ * tells how large a buffer is needed.
+ */
+typedef struct csmith_sink {
+	char *buf;
+	size_t size;
+	void (*write)(void *arg, const char *data, size_t len);
+	void *arg;
+	size_t len;
+} csmith_sink;
+
+/*
+ * Generate the program for the given seed.  Returns CSMITH_OK,
+ * CSMITH_TRUNCATED if the program did not fit into sink->buf, or
+ * CSMITH_ERROR.  The program is the same as the one the csmith program
+ * generates with the same options and seed.
+ */
+int csmith_generate(const csmith_options *opts, uint64_t seed, csmith_sink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBCSMITH_H */
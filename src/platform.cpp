@@ -86,6 +86,47 @@ unsigned long platform_gen_seed()
 	return (long) read_time();
 }
 
+//////////// platform specific wall clock /////////////////
+#ifndef WIN32
+#include <time.h>
+#else
+#include <windows.h>
+#endif
+
+unsigned long long platform_get_usecs()
+{
+#ifndef WIN32
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+#else
+	LARGE_INTEGER freq, cnt;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&cnt);
+	return (unsigned long long)(cnt.QuadPart * 1000000.0 / freq.QuadPart);
+#endif
+}
+
+//////////// platform specific malloc block size /////////////////
+#if defined(WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+unsigned long platform_alloc_size(void *p)
+{
+#if defined(WIN32)
+	return _msize(p);
+#elif defined(__APPLE__)
+	return malloc_size(p);
+#else
+	return malloc_usable_size(p);
+#endif
+}
+
 //////////// platform specific mkdir /////////////////
 #ifndef WIN32
 #include <sys/stat.h>
@@ -108,6 +149,185 @@ bool create_dir(const char *dir)
 	return true;
 }
 
+//////////// platform specific threads /////////////////
+#ifndef WIN32
+#include <pthread.h>
+#endif
+#include <vector>
+
+namespace {
+struct ThreadStart {
+	void (*fn)(void *);
+	void *arg;
+};
+}
+
+#ifndef WIN32
+extern "C" void *platform_thread_main(void *p)
+{
+	ThreadStart *start = static_cast<ThreadStart *>(p);
+	start->fn(start->arg);
+	return NULL;
+}
+#else
+static DWORD WINAPI platform_thread_main(LPVOID p)
+{
+	ThreadStart *start = static_cast<ThreadStart *>(p);
+	start->fn(start->arg);
+	return 0;
+}
+#endif
+
+bool platform_run_threads(int n, void (*fn)(void *), void *arg)
+{
+	ThreadStart start;
+	start.fn = fn;
+	start.arg = arg;
+	bool ok = true;
+#ifndef WIN32
+	std::vector<pthread_t> threads;
+	for (int i = 0; i < n; i++) {
+		pthread_t t;
+		if (pthread_create(&t, NULL, platform_thread_main, &start) != 0) {
+			ok = false;
+			break;
+		}
+		threads.push_back(t);
+	}
+	for (size_t i = 0; i < threads.size(); i++) {
+		pthread_join(threads[i], NULL);
+	}
+#else
+	std::vector<HANDLE> threads;
+	for (int i = 0; i < n; i++) {
+		HANDLE t = CreateThread(NULL, 0, platform_thread_main, &start, 0, NULL);
+		if (t == NULL) {
+			ok = false;
+			break;
+		}
+		threads.push_back(t);
+	}
+	for (size_t i = 0; i < threads.size(); i++) {
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+	}
+#endif
+	return ok;
+}
+
+long platform_fetch_and_inc(volatile long *counter)
+{
+#ifndef WIN32
+	return __sync_fetch_and_add(counter, 1);
+#else
+	return InterlockedExchangeAdd(counter, 1);
+#endif
+}
+
+struct PlatformMutex {
+#ifndef WIN32
+	pthread_mutex_t mutex;
+#else
+	CRITICAL_SECTION mutex;
+#endif
+};
+
+PlatformMutex *platform_mutex_create()
+{
+	PlatformMutex *m = new PlatformMutex;
+#ifndef WIN32
+	pthread_mutex_init(&m->mutex, NULL);
+#else
+	InitializeCriticalSection(&m->mutex);
+#endif
+	return m;
+}
+
+void platform_mutex_destroy(PlatformMutex *m)
+{
+#ifndef WIN32
+	pthread_mutex_destroy(&m->mutex);
+#else
+	DeleteCriticalSection(&m->mutex);
+#endif
+	delete m;
+}
+
+void platform_mutex_lock(PlatformMutex *m)
+{
+#ifndef WIN32
+	pthread_mutex_lock(&m->mutex);
+#else
+	EnterCriticalSection(&m->mutex);
+#endif
+}
+
+void platform_mutex_unlock(PlatformMutex *m)
+{
+#ifndef WIN32
+	pthread_mutex_unlock(&m->mutex);
+#else
+	LeaveCriticalSection(&m->mutex);
+#endif
+}
+
+struct PlatformCond {
+#ifndef WIN32
+	pthread_cond_t cond;
+#else
+	CONDITION_VARIABLE cond;
+#endif
+};
+
+PlatformCond *platform_cond_create()
+{
+	PlatformCond *c = new PlatformCond;
+#ifndef WIN32
+	pthread_cond_init(&c->cond, NULL);
+#else
+	InitializeConditionVariable(&c->cond);
+#endif
+	return c;
+}
+
+void platform_cond_destroy(PlatformCond *c)
+{
+#ifndef WIN32
+	pthread_cond_destroy(&c->cond);
+#endif
+	delete c;
+}
+
+void platform_cond_wait(PlatformCond *c, PlatformMutex *m)
+{
+#ifndef WIN32
+	pthread_cond_wait(&c->cond, &m->mutex);
+#else
+	SleepConditionVariableCS(&c->cond, &m->mutex, INFINITE);
+#endif
+}
+
+void platform_cond_broadcast(PlatformCond *c)
+{
+#ifndef WIN32
+	pthread_cond_broadcast(&c->cond);
+#else
+	WakeAllConditionVariable(&c->cond);
+#endif
+}
+
+int platform_cpu_count()
+{
+#ifndef WIN32
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? static_cast<int>(n) : 1;
+#else
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return static_cast<int>(info.dwNumberOfProcessors);
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 // Local Variables:
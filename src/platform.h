@@ -34,8 +34,38 @@
 
 unsigned long platform_gen_seed();
 
+// monotonic wall clock in microseconds, used for profiling and budgets
+unsigned long long platform_get_usecs();
+
+// usable size of a block returned by malloc, used for memory accounting
+unsigned long platform_alloc_size(void *p);
+
 bool create_dir(const char* dir);
 
+// run fn(arg) on n threads and wait for all of them to finish; false if the
+// threads could not be created
+bool platform_run_threads(int n, void (*fn)(void *), void *arg);
+
+// atomically increment *counter, returning its previous value
+long platform_fetch_and_inc(volatile long *counter);
+
+// a mutex shared by the --jobs threads
+struct PlatformMutex;
+PlatformMutex *platform_mutex_create();
+void platform_mutex_destroy(PlatformMutex *m);
+void platform_mutex_lock(PlatformMutex *m);
+void platform_mutex_unlock(PlatformMutex *m);
+
+// a condition variable, waited on with a locked PlatformMutex
+struct PlatformCond;
+PlatformCond *platform_cond_create();
+void platform_cond_destroy(PlatformCond *c);
+void platform_cond_wait(PlatformCond *c, PlatformMutex *m);
+void platform_cond_broadcast(PlatformCond *c);
+
+// the number of online processors, at least 1
+int platform_cpu_count();
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #endif // PLATFORM_H
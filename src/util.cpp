@@ -35,16 +35,17 @@
 #include <sstream>
 #include <cassert>
 #include <vector>  
+#include "GenerationContext.h"
 
 using namespace std; 
 ///////////////////////////////////////////////////////////////////////////////
 
-static int gensym_count = 0;
+static inline int &gensym_count(void) { return GenerationContext::current().gensym_count; }
 
 void
 reset_gensym()
 {
-	gensym_count = 0;
+	gensym_count() = 0;
 }
 
 /*
@@ -55,7 +56,7 @@ gensym(const char* basename)
 {
 	ostringstream ss; //(basename, ios_base::ate); somehow this yields weird result on windows
 	ss << basename;
-	ss << ++gensym_count;
+	ss << ++gensym_count();
 	return ss.str(); 
 }
 
@@ -67,7 +68,7 @@ gensym(const string& basename)
 {
 	ostringstream ss; //(basename, ios_base::ate);
 	ss << basename;
-	ss << ++gensym_count;
+	ss << ++gensym_count();
 	return ss.str();
 }
 
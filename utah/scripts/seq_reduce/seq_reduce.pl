@@ -64,6 +64,17 @@ my $COMPILER_OUT2 = "compiler_out$SUFFIX2";
 my $PROG_OUT1 = "prog_out$SUFFIX1";
 my $PROG_OUT2 = "prog_out$SUFFIX2";
 
+# A reduction compiles and runs the same variants over and over, and so do
+# reductions started again from the same seed: with csmith-cache, compile
+# and run results come from the result cache where it has them.
+my $CSMITH_CACHE;
+foreach my $dir ("$CSMITH_HOME/src", split(/:/, $ENV{"PATH"})) {
+    if (-x "$dir/csmith-cache") {
+        $CSMITH_CACHE = "$dir/csmith-cache";
+        last;
+    }
+}
+
 ##############################################################
 
 sub runit ($) {
@@ -152,6 +163,43 @@ sub run_exe ($$$) {
     return 0;
 }
 
+# compile, and unless $run is 0 run, through csmith-cache; the returns are
+# those of compile (-1 on failure) and, after a compilation that went
+# well, those of run_exe
+sub cached_compile_and_run ($$$$$) {
+    my ($compiler, $src_file, $compiler_out, $prog_out, $run) = @_;
+    my $opts = "--compiler-timeout $COMPILER_TIMEOUT --prog-timeout $PROG_TIMEOUT " .
+        "--compiler-output $compiler_out --program-output $prog_out";
+    $opts .= " --no-run" if (!$run);
+    my $report = `$CSMITH_CACHE run $opts "$compiler" $src_file "$HEADER"`;
+    my $res = $? >> 8;
+    if ($res == 1 || $res == 2) {
+        if ($res == 2) {
+            print "$indent COMPILER($compiler) FAILURE: TIMEOUT\n";
+        }
+        else {
+            my ($status) = ($report =~ /^compile (\d+)/m);
+            $status = $res if (!defined($status));
+            print "$indent COMPILER($compiler) FAILURE: return code $status \n";
+            print "$indent check the output file $compiler_out for details\n";
+        }
+        return -1;
+    }
+    if ($res == 4) {
+        print "$indent Running $src_file with $compiler FAILURE: TIMEOUT\n";
+        return 1;
+    }
+    if ($res == 3) {
+        my ($status) = ($report =~ /^run (\d+)/m);
+        if (defined($status) && $status == 139) {
+            print "$indent Running $src_file with $compiler FAILURE: core dump\n";
+            return 2;
+        }
+        return 3;
+    }
+    return $res ? -1 : 0;
+}
+
 # rv: 1 - not equal, 0 - equal
 sub compare($\@$\@$$) {
     my ($file1, $out1, $file2, $out2, $flag1, $match) = @_;
@@ -196,28 +244,42 @@ sub run_wrong_code_test ($$$) {
     
     $test_count++;
     my $res;
-    $res = compile($COMPILER1, $test_file, "$EXE1$test_count", "$COMPILER_OUT1$test_count");
-    if ($res) {
-	print "$indent compiler error! Can't compile $test_file with $COMPILER1\n";
-	return 0;
+    if (defined($CSMITH_CACHE)) {
+        $res = cached_compile_and_run($COMPILER1, $test_file, "$COMPILER_OUT1$test_count", "$PROG_OUT1$test_count", 1);
+        if ($res == -1) {
+	    print "$indent compiler error! Can't compile $test_file with $COMPILER1\n";
+        }
+        return 0 if ($res);
+        $res = cached_compile_and_run($COMPILER2, $test_file, "$COMPILER_OUT2$test_count", "$PROG_OUT2$test_count", 1);
+        if ($res == -1) {
+	    print "$indent compiler error! Can't compile $test_file with $COMPILER2\n";
+        }
+        return 0 if ($res);
     }
+    else {
+        $res = compile($COMPILER1, $test_file, "$EXE1$test_count", "$COMPILER_OUT1$test_count");
+        if ($res) {
+	    print "$indent compiler error! Can't compile $test_file with $COMPILER1\n";
+	    return 0;
+        }
 
-    $res = compile($COMPILER2, $test_file, "$EXE2$test_count", "$COMPILER_OUT2$test_count");
-    if ($res) {
-	print "$indent compiler error! Can't compile $test_file with $COMPILER2\n";
-	return 0;
-    }
+        $res = compile($COMPILER2, $test_file, "$EXE2$test_count", "$COMPILER_OUT2$test_count");
+        if ($res) {
+	    print "$indent compiler error! Can't compile $test_file with $COMPILER2\n";
+	    return 0;
+        }
 
-    $res = run_exe("$EXE1$test_count", "$PROG_OUT1$test_count", "");
-    if ($res) {
-	#print "$indent can't run the program: $EXE1$test_count\n";
-	return 0;
-    }
+        $res = run_exe("$EXE1$test_count", "$PROG_OUT1$test_count", "");
+        if ($res) {
+	    #print "$indent can't run the program: $EXE1$test_count\n";
+	    return 0;
+        }
     
-    $res = run_exe("$EXE2$test_count", "$PROG_OUT2$test_count", "");
-    if ($res) {
-	#print "$indent can't run the program: $EXE2$test_count\n";
-	return 0;
+        $res = run_exe("$EXE2$test_count", "$PROG_OUT2$test_count", "");
+        if ($res) {
+	    #print "$indent can't run the program: $EXE2$test_count\n";
+	    return 0;
+        }
     }
     
     my @OUTPUT1 = ();
@@ -246,7 +308,12 @@ sub run_crash_test($$) {
     
     $test_count++;
     my $res;
-    $res = compile($COMPILER1, $test_file, "$EXE1$test_count", "$COMPILER_OUT1$test_count");
+    if (defined($CSMITH_CACHE)) {
+        $res = cached_compile_and_run($COMPILER1, $test_file, "$COMPILER_OUT1$test_count", "/dev/null", 0);
+    }
+    else {
+        $res = compile($COMPILER1, $test_file, "$EXE1$test_count", "$COMPILER_OUT1$test_count");
+    }
     if ($res) {
         if (read_file_with_substring("$COMPILER_OUT1$test_count", @tmp, $match)) {
 	    print "$indent crash string $match found for $test_file with $COMPILER1\n";